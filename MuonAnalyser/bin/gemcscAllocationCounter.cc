@@ -0,0 +1,81 @@
+// Counting global operator new/delete, to be preloaded into cmsRun (see interface/AllocationCounter.h).
+// Memory still comes from malloc, only the number of calls and the requested bytes are added up.
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+namespace {
+
+  std::atomic<unsigned long long> nAllocations(0);
+  std::atomic<unsigned long long> allocatedBytes(0);
+
+  inline void* countedAlloc(std::size_t size) {
+    nAllocations.fetch_add(1, std::memory_order_relaxed);
+    allocatedBytes.fetch_add(size, std::memory_order_relaxed);
+    return std::malloc(size == 0 ? 1 : size);
+  }
+
+  inline void* countedAlignedAlloc(std::size_t size, std::align_val_t align) {
+    nAllocations.fetch_add(1, std::memory_order_relaxed);
+    allocatedBytes.fetch_add(size, std::memory_order_relaxed);
+    void* p = nullptr;
+    const std::size_t alignment = static_cast<std::size_t>(align) < sizeof(void*) ? sizeof(void*) : static_cast<std::size_t>(align);
+    if (posix_memalign(&p, alignment, size == 0 ? 1 : size) != 0) return nullptr;
+    return p;
+  }
+
+}
+
+extern "C" void gemcscAllocationCounts(unsigned long long* n, unsigned long long* bytes)
+{
+  *n = nAllocations.load(std::memory_order_relaxed);
+  *bytes = allocatedBytes.load(std::memory_order_relaxed);
+}
+
+void* operator new(std::size_t size)
+{
+  void* p = countedAlloc(size);
+  if (!p) throw std::bad_alloc();
+  return p;
+}
+
+void* operator new[](std::size_t size)
+{
+  void* p = countedAlloc(size);
+  if (!p) throw std::bad_alloc();
+  return p;
+}
+
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept { return countedAlloc(size); }
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept { return countedAlloc(size); }
+
+void* operator new(std::size_t size, std::align_val_t align)
+{
+  void* p = countedAlignedAlloc(size, align);
+  if (!p) throw std::bad_alloc();
+  return p;
+}
+
+void* operator new[](std::size_t size, std::align_val_t align)
+{
+  void* p = countedAlignedAlloc(size, align);
+  if (!p) throw std::bad_alloc();
+  return p;
+}
+
+void* operator new(std::size_t size, std::align_val_t align, const std::nothrow_t&) noexcept { return countedAlignedAlloc(size, align); }
+void* operator new[](std::size_t size, std::align_val_t align, const std::nothrow_t&) noexcept { return countedAlignedAlloc(size, align); }
+
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete[](void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+void operator delete[](void* p, std::size_t) noexcept { std::free(p); }
+void operator delete(void* p, const std::nothrow_t&) noexcept { std::free(p); }
+void operator delete[](void* p, const std::nothrow_t&) noexcept { std::free(p); }
+void operator delete(void* p, std::align_val_t) noexcept { std::free(p); }
+void operator delete[](void* p, std::align_val_t) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t, std::align_val_t) noexcept { std::free(p); }
+void operator delete[](void* p, std::size_t, std::align_val_t) noexcept { std::free(p); }
+void operator delete(void* p, std::align_val_t, const std::nothrow_t&) noexcept { std::free(p); }
+void operator delete[](void* p, std::align_val_t, const std::nothrow_t&) noexcept { std::free(p); }
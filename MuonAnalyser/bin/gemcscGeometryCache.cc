@@ -0,0 +1,87 @@
+// Contents of a GE1/1 - ME1/1 geometry cache (GEMCSCGeometryCacheWriter), without cmsRun:
+//   g++ -O2 -std=c++17 -I$CMSSW_BASE/src gemcscGeometryCache.cc -o gemcscGeometryCache
+//
+// gemcscGeometryCache [-i rawId] [-s strip] [-w wireGroup] cache.bin
+//   without -i   number of eta partitions and layers, strips and wire groups
+//   -i rawId     surface, bounds and strip apex of one detector
+//   -s strip     with -i, local and global centre of the strip (1..nStrips) and its angle
+//   -w wg        with -i and -s, crossing of the strip with the middle wire of wire group wg (ME1/1)
+
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <unistd.h>
+
+#include "GEMCSCBendingAnalyzer/MuonAnalyser/interface/GeometryCache.h"
+
+namespace {
+
+  void usage() {
+    std::cout << "usage: gemcscGeometryCache [-i rawId] [-s strip] [-w wireGroup] cache.bin" << std::endl;
+  }
+
+}
+
+int main(int argc, char** argv) {
+  uint32_t rawId = 0;
+  int strip = 0, wireGroup = 0;
+  int c;
+  while ((c = getopt(argc, argv, "i:s:w:h")) != -1){
+    switch (c){
+    case 'i': rawId = std::strtoul(optarg, nullptr, 0); break;
+    case 's': strip = std::atoi(optarg); break;
+    case 'w': wireGroup = std::atoi(optarg); break;
+    default: usage(); return 1;
+    }
+  }
+  if (argc - optind != 1){
+    usage();
+    return 1;
+  }
+
+  geomcache::GeometryCache cache;
+  if (not cache.open(argv[optind])){
+    std::cout << "Error! " << cache.error() << std::endl;
+    return 1;
+  }
+
+  if (rawId == 0){
+    int nDets[2] = {0, 0};
+    long nStrips[2] = {0, 0}, nWireGroups = 0;
+    for (size_t i = 0; i < cache.size(); ++i){
+      const geomcache::Det det = cache.det(i);
+      const int type = det.record().type == geomcache::kGE11Roll ? 0 : 1;
+      nDets[type]++;
+      nStrips[type] += det.nStrips();
+      nWireGroups += det.nWireGroups();
+    }
+    std::cout << argv[optind] << ": " << nDets[0] << " GE11 eta partitions, " << nStrips[0] << " strips; "
+	      << nDets[1] << " ME11 layers, " << nStrips[1] << " strips, " << nWireGroups << " wire groups" << std::endl;
+    return 0;
+  }
+
+  const geomcache::Det det = cache.find(rawId);
+  if (not det){
+    std::cout << "Error! " << rawId << " is not in " << argv[optind] << std::endl;
+    return 1;
+  }
+  const geomcache::DetRecord& r = det.record();
+  std::cout << rawId << (r.type == geomcache::kGE11Roll ? " GE11 eta partition" : " ME11 layer")
+	    << ", position (" << r.position[0] << ", " << r.position[1] << ", " << r.position[2] << ")"
+	    << ", half widths " << r.halfWidthBottom << " / " << r.halfWidthTop << ", half length " << r.halfLength
+	    << ", " << det.nStrips() << " strips, apex (" << r.apexX << ", " << r.apexY << ")"
+	    << ", " << det.nWireGroups() << " wire groups" << std::endl;
+  if (strip < 1 or strip > det.nStrips()) return 0;
+
+  const geomcache::LocalPoint centre = det.centreOfStrip(strip - 0.5f);
+  const geomcache::GlobalPoint global = det.toGlobal(centre.x, centre.y);
+  std::cout << "strip " << strip << ": local x " << centre.x << ", global (" << global.x << ", " << global.y << ", " << global.z << ")"
+	    << ", angle " << det.stripAngle(strip - 0.5f) << std::endl;
+  if (wireGroup < 1 or wireGroup > det.nWireGroups()) return 0;
+
+  const geomcache::LocalPoint cross = det.stripWireGroupIntersection(strip, wireGroup);
+  const geomcache::GlobalPoint crossGlobal = det.toGlobal(cross.x, cross.y);
+  std::cout << "wire group " << wireGroup << ": local (" << cross.x << ", " << cross.y << ")"
+	    << ", global (" << crossGlobal.x << ", " << crossGlobal.y << ", " << crossGlobal.z << ")" << std::endl;
+  return 0;
+}
@@ -0,0 +1,134 @@
+// Microbenchmark of the matching core on synthetic GE11 hit collections, no CMSSW or conditions needed:
+//   g++ -O2 -std=c++17 -I$CMSSW_BASE/src gemcscMatchingBenchmark.cc -o gemcscMatchingBenchmark
+//
+// gemcscMatchingBenchmark [hitsPerRoll] [muonsPerEvent] [events]
+//
+// Per event: hits are spread uniformly over all GE11 eta partitions, each muon is extrapolated to one
+// eta partition per layer. Times, per event and per muon layer:
+//   index     refilling and sorting the per roll hit index, with flipped strips
+//   nearest   nearest hit in the propagated and neighbouring rolls from the index
+//   linear    the same from a scan over all hits of the event, as before the index
+//   residuals dX/dR/RdPhi of the raw, flipped and aligned hit against the three extrapolations
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <vector>
+
+#include "GEMCSCBendingAnalyzer/MuonAnalyser/interface/MatchingCore.h"
+
+namespace {
+
+  //GE11 eta partition, roughly: 384 strips over about 25 cm at the middle
+  const float kPitch = 25.0/matching::kNGEMStrips;//cm
+
+  struct FakeHit {
+    int roll;//index as matching::rollIndex
+    float strip;
+    float x, y;
+  };
+
+  float stripX(float strip) { return (strip - 0.5*matching::kNGEMStrips)*kPitch; }
+
+  //keeps results alive so the timed loops are not optimized away
+  volatile float sink;
+
+  using Clock = std::chrono::steady_clock;
+  double elapsed(Clock::time_point start) { return std::chrono::duration<double, std::nano>(Clock::now() - start).count(); }
+
+}
+
+int main(int argc, char** argv) {
+  const int hitsPerRoll = argc > 1 ? std::atoi(argv[1]) : 4;
+  const int muonsPerEvent = argc > 2 ? std::atoi(argv[2]) : 2;
+  const int nEvents = argc > 3 ? std::atoi(argv[3]) : 2000;
+
+  std::mt19937 rng(12345);
+  std::uniform_real_distribution<float> uStrip(0.0, matching::kNGEMStrips);
+  std::uniform_int_distribution<int> uChamber(1, matching::kNChambers);
+  std::uniform_int_distribution<int> uRoll(1, matching::kNRolls);
+  std::uniform_int_distribution<int> uRegion(0, 1);
+  std::normal_distribution<float> smear(0.0, 0.3);//cm
+
+  double tIndex = 0, tNearest = 0, tLinear = 0, tResiduals = 0;
+  long nLayers = 0, nMismatch = 0;
+  float checksum = 0;
+  //reused across events as in GEMCSCBendingAlgo
+  hitindex::Index<FakeHit> index;
+  for (int ev = 0; ev < nEvents; ++ev){
+    std::vector<FakeHit> hits;
+    hits.reserve(hitsPerRoll*matching::kNGE11Rolls);
+    for (int r = 0; r < matching::kNGE11Rolls; ++r)
+      for (int h = 0; h < hitsPerRoll; ++h){
+	const float strip = matching::centerStripNumber(uStrip(rng));
+	hits.push_back({r, strip, stripX(strip), 0.0});
+      }
+
+    auto start = Clock::now();
+    hitindex::clearAll(index);
+    for (const auto& hit : hits)
+      index[hit.roll].add(stripX(matching::flippedStripNumber(hit.strip)), hit.y, &hit);
+    hitindex::sortAll(index);
+    tIndex += elapsed(start);
+
+    for (int m = 0; m < muonsPerEvent; ++m){
+      const int region = uRegion(rng) ? 1 : -1;
+      const int chamber = uChamber(rng);
+      const int roll = uRoll(rng);
+      for (int layer = 1; layer <= matching::kNLayers; ++layer){
+	const float x0 = stripX(uStrip(rng));
+	const residuals::Extrapolations prop = {{x0, x0 + smear(rng), x0 + smear(rng)}, {0.0, smear(rng), smear(rng)}};
+	auto rollKey = [&](int r){ return uint32_t(matching::rollIndex(region, chamber, layer, r)); };
+
+	start = Clock::now();
+	float mindX = 9999.0;
+	const auto* nearest = matching::nearestInRolls(index, roll, rollKey, x0, mindX);
+	tNearest += elapsed(start);
+
+	start = Clock::now();
+	float mindXLinear = 9999.0;
+	const FakeHit* nearestLinear = nullptr;
+	const int first = matching::rollIndex(region, chamber, layer, 1);
+	const int propagated = matching::rollIndex(region, chamber, layer, roll);
+	for (const auto& hit : hits){
+	  if (hit.roll < first or hit.roll >= first + matching::kNRolls or std::abs(hit.roll - propagated) > 1) continue;
+	  const float dx = std::fabs(stripX(matching::flippedStripNumber(hit.strip)) - x0);
+	  if (dx < mindXLinear){
+	    mindXLinear = dx;
+	    nearestLinear = &hit;
+	  }
+	}
+	tLinear += elapsed(start);
+	if (nearestLinear) checksum += mindXLinear;
+	if ((nearest == nullptr) != (nearestLinear == nullptr) or (nearest and mindX != mindXLinear)) nMismatch++;
+
+	if (nearest == nullptr) continue;
+	start = Clock::now();
+	const FakeHit& hit = *nearest->hit;
+	residuals::Hits<residuals::kNGEMVariants> variants;
+	residuals::setHit(variants, residuals::kRaw, hit.x, hit.y, 0.0, 0.0);
+	residuals::setHit(variants, residuals::kFlipped, nearest->x, nearest->y, 0.0, 0.0);
+	residuals::setHit(variants, residuals::kAligned, matching::alignedX(nearest->x, nearest->y, 0.1, 0.001), nearest->y, 0.0, 0.0);
+	residuals::Residuals<residuals::kNGEMVariants> res;
+	residuals::compute(prop, variants, res);
+	tResiduals += elapsed(start);
+	checksum += res.RdPhi[residuals::kAligned][residuals::kSta] + mindX;
+	nLayers++;
+      }
+    }
+  }
+  sink = checksum;
+
+  std::cout << "gemcscMatchingBenchmark: " << nEvents << " events, " << hitsPerRoll << " hits per roll ("
+	    << hitsPerRoll*matching::kNGE11Rolls << " per event), " << muonsPerEvent << " muons per event" << std::endl;
+  std::cout << "  index     " << tIndex/nEvents << " ns/event" << std::endl;
+  if (nLayers > 0){
+    std::cout << "  nearest   " << tNearest/nLayers << " ns/layer" << std::endl;
+    std::cout << "  linear    " << tLinear/nLayers << " ns/layer" << std::endl;
+    std::cout << "  residuals " << tResiduals/nLayers << " ns/layer" << std::endl;
+  }
+  if (nMismatch > 0)
+    std::cout << "Error! index and linear scan disagree in " << nMismatch << " layers" << std::endl;
+  return 0;
+}
@@ -0,0 +1,282 @@
+// Re-matching of the MuonCandidates records of SliceTestAnalysis (storeCandidates) without cmsRun.
+// Applies new GE11/ME11 matching windows, GE11 strip ordering, alignment corrections and track type
+// to the stored propagations and candidate hits, and writes the matched quantities per muon with the
+// branch names of the SliceTestAnalysis ntuple.
+//
+// gemcscRematch [options] input.root output.root
+//   -d path    candidate tree in the input file, default SliceTestAnalysis/MuonCandidates
+//   -w dX      GE11 local |dX| window, cm, default all stored hits
+//   -r dR      ME11 local dR window, cm, default all stored hits
+//   -f         flipped GE11 strip ordering
+//   -a table   GE11 alignment table, format of GEMAlignmentTable
+//   -t track   track matched to the hits: sta, gt or inner, default sta
+
+#include <cmath>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <unistd.h>
+
+#include "TFile.h"
+#include "TTree.h"
+
+#include "GEMCSCBendingAnalyzer/MuonAnalyser/interface/MuonCandidates.h"
+#include "GEMCSCBendingAnalyzer/MuonAnalyser/interface/MatchingCore.h"
+#include "GEMCSCBendingAnalyzer/MuonAnalyser/interface/GEMAlignmentTableCore.h"
+
+namespace {
+
+  float deltaPhi(float phi1, float phi2) {
+    float d = phi1 - phi2;
+    while (d > M_PI) d -= 2*M_PI;
+    while (d <= -M_PI) d += 2*M_PI;
+    return d;
+  }
+
+  //matched quantities, names and defaults of the SliceTestAnalysis ntuple
+  struct RematchData {
+    Int_t run, lumi, event;
+    int muonIndex;
+    float muonpt, muoneta, muonphi;
+    bool has_TightID;
+
+    bool has_propGE11[2];
+    bool has_GE11[2];
+    int chamber_GE11[2];
+    int roll_rechitGE11[2];
+    float rechit_localx_GE11[2];
+    float rechit_phi_GE11[2];
+    float rechit_prop_dX_GE11[2];
+    float rechit_prop_RdPhi_GE11[2];
+    float rechit_prop_dphi_GE11[2];
+
+    bool has_propME11[6];
+    bool has_ME11[6];
+    float rechit_phi_ME11[6];
+    float rechit_prop_dR_ME11[6];
+    float rechit_prop_RdPhi_ME11[6];
+
+    float dphi_keyCSCRechit_GE11Rechit[2];
+
+    void init() {
+      for (int i = 0; i < 2; ++i){
+	has_propGE11[i] = has_GE11[i] = false;
+	chamber_GE11[i] = roll_rechitGE11[i] = -1;
+	rechit_localx_GE11[i] = 99999;
+	rechit_phi_GE11[i] = -9;
+	rechit_prop_dX_GE11[i] = rechit_prop_RdPhi_GE11[i] = 99999;
+	rechit_prop_dphi_GE11[i] = -9;
+	dphi_keyCSCRechit_GE11Rechit[i] = -9;
+      }
+      for (int i = 0; i < 6; ++i){
+	has_propME11[i] = has_ME11[i] = false;
+	rechit_phi_ME11[i] = -9;
+	rechit_prop_dR_ME11[i] = rechit_prop_RdPhi_ME11[i] = 99999;
+      }
+    }
+    void book(TTree* t) {
+      t->Branch("run", &run, "run/I");
+      t->Branch("lumi", &lumi, "lumi/I");
+      t->Branch("event", &event, "event/I");
+      t->Branch("muonIndex", &muonIndex, "muonIndex/I");
+      t->Branch("muonpt", &muonpt, "muonpt/F");
+      t->Branch("muoneta", &muoneta, "muoneta/F");
+      t->Branch("muonphi", &muonphi, "muonphi/F");
+      t->Branch("has_TightID", &has_TightID, "has_TightID/O");
+      t->Branch("has_propGE11", has_propGE11, "has_propGE11[2]/O");
+      t->Branch("has_GE11", has_GE11, "has_GE11[2]/O");
+      t->Branch("chamber_GE11", chamber_GE11, "chamber_GE11[2]/I");
+      t->Branch("roll_rechitGE11", roll_rechitGE11, "roll_rechitGE11[2]/I");
+      t->Branch("rechit_localx_GE11", rechit_localx_GE11, "rechit_localx_GE11[2]/F");
+      t->Branch("rechit_phi_GE11", rechit_phi_GE11, "rechit_phi_GE11[2]/F");
+      t->Branch("rechit_prop_dX_GE11", rechit_prop_dX_GE11, "rechit_prop_dX_GE11[2]/F");
+      t->Branch("rechit_prop_RdPhi_GE11", rechit_prop_RdPhi_GE11, "rechit_prop_RdPhi_GE11[2]/F");
+      t->Branch("rechit_prop_dphi_GE11", rechit_prop_dphi_GE11, "rechit_prop_dphi_GE11[2]/F");
+      t->Branch("has_propME11", has_propME11, "has_propME11[6]/O");
+      t->Branch("has_ME11", has_ME11, "has_ME11[6]/O");
+      t->Branch("rechit_phi_ME11", rechit_phi_ME11, "rechit_phi_ME11[6]/F");
+      t->Branch("rechit_prop_dR_ME11", rechit_prop_dR_ME11, "rechit_prop_dR_ME11[6]/F");
+      t->Branch("rechit_prop_RdPhi_ME11", rechit_prop_RdPhi_ME11, "rechit_prop_RdPhi_ME11[6]/F");
+      t->Branch("dphi_keyCSCRechit_GE11Rechit", dphi_keyCSCRechit_GE11Rechit, "dphi_keyCSCRechit_GE11Rechit[2]/F");
+    }
+  };
+
+  struct Options {
+    std::string treePath = "SliceTestAnalysis/MuonCandidates";
+    float gemWindow = -1.0;//cm, < 0: all stored hits
+    float cscWindow = -1.0;//cm
+    bool flipped = false;
+    std::string alignmentTable;
+    int track = residuals::kSta;
+  };
+
+  //nearest GE11 hit in local x, over all propagations of the layer and their neighbouring rolls
+  void matchGE11(const MuonCandidates& c, const Options& opt, const gemalignment::Table& alignment, RematchData& out) {
+    float mindX[2] = {9999.0, 9999.0};
+    for (int p = 0; p < c.nGE11Props; ++p){
+      const int layer = c.propGE11_layer[p]-1;
+      out.has_propGE11[layer] = true;
+      const residuals::Extrapolations prop = {{c.propGE11_x[p][0], c.propGE11_x[p][1], c.propGE11_x[p][2]},
+					      {c.propGE11_y[p][0], c.propGE11_y[p][1], c.propGE11_y[p][2]}};
+      for (int h = 0; h < c.nGE11Hits; ++h){
+	if (c.hitGE11_region[h] != c.propGE11_region[p] or c.hitGE11_chamber[h] != c.propGE11_chamber[p] or c.hitGE11_layer[h] != c.propGE11_layer[p]) continue;
+	if (std::abs(c.hitGE11_roll[h] - c.propGE11_roll[p]) > 1) continue;
+	const gemalignment::Entry& corr = alignment.get(c.hitGE11_region[h], c.hitGE11_chamber[h], c.hitGE11_layer[h], c.hitGE11_roll[h]);
+	const float x0 = (opt.flipped ? c.hitGE11_flippedX[h] : c.hitGE11_x[h]);
+	const float x = matching::alignedX(x0, c.hitGE11_y[h], corr.deltaX, corr.rotation);
+	const float correction = x - x0;
+	const float dX = x - prop.x[opt.track];
+	if (opt.gemWindow >= 0.0 and std::fabs(dX) >= opt.gemWindow) continue;
+	if (std::fabs(dX) >= mindX[layer]) continue;
+	mindX[layer] = std::fabs(dX);
+
+	//RdPhi relative to the middle of the propagated roll, as in GEMCSCBendingAlgo
+	residuals::Hits<1> hit;
+	residuals::setHit(hit, 0, x, c.hitGE11_y[h], -(c.propGE11_middlePerp[p] - c.hitGE11_middlePerp[h]),
+			  opt.flipped ? c.hitGE11_flippedStripAngle[h] : c.hitGE11_stripAngle[h]);
+	residuals::Residuals<1> res;
+	residuals::compute(prop, hit, res);
+	const float phi = (opt.flipped ? c.hitGE11_flippedPhi[h] : c.hitGE11_phi[h]) + c.hitGE11_dphidx[h]*correction;
+	out.has_GE11[layer] = true;
+	out.chamber_GE11[layer] = c.hitGE11_chamber[h];
+	out.roll_rechitGE11[layer] = c.hitGE11_roll[h];
+	out.rechit_localx_GE11[layer] = x;
+	out.rechit_phi_GE11[layer] = phi;
+	out.rechit_prop_dX_GE11[layer] = res.dX[0][opt.track];
+	out.rechit_prop_RdPhi_GE11[layer] = res.RdPhi[0][opt.track];
+	out.rechit_prop_dphi_GE11[layer] = deltaPhi(c.propGE11_phi[p], phi);
+      }
+    }
+  }
+
+  //nearest ME11 hit in local dR, per layer
+  void matchME11(const MuonCandidates& c, const Options& opt, RematchData& out) {
+    float mindR[6] = {9999.0, 9999.0, 9999.0, 9999.0, 9999.0, 9999.0};
+    for (int p = 0; p < c.nME11Props; ++p){
+      const int layer = c.propME11_layer[p]-1;
+      out.has_propME11[layer] = true;
+      const residuals::Extrapolations prop = {{c.propME11_x[p][0], c.propME11_x[p][1], c.propME11_x[p][2]},
+					      {c.propME11_y[p][0], c.propME11_y[p][1], c.propME11_y[p][2]}};
+      for (int h = 0; h < c.nME11Hits; ++h){
+	if (c.hitME11_endcap[h] != c.propME11_endcap[p] or c.hitME11_chamber[h] != c.propME11_chamber[p]
+	    or c.hitME11_ring[h] != c.propME11_ring[p] or c.hitME11_layer[h] != c.propME11_layer[p]) continue;
+	residuals::Hits<1> hit;
+	residuals::setHit(hit, 0, c.hitME11_x[h], c.hitME11_y[h], c.hitME11_y[h], c.hitME11_stripAngle[h]);
+	residuals::Residuals<1> res;
+	residuals::compute(prop, hit, res);
+	const float dR = res.dR[0][opt.track];
+	if (opt.cscWindow >= 0.0 and dR >= opt.cscWindow) continue;
+	if (dR >= mindR[layer]) continue;
+	mindR[layer] = dR;
+	out.has_ME11[layer] = true;
+	out.rechit_phi_ME11[layer] = c.hitME11_phi[h];
+	out.rechit_prop_dR_ME11[layer] = dR;
+	out.rechit_prop_RdPhi_ME11[layer] = res.RdPhi[0][opt.track];
+      }
+    }
+  }
+
+  void usage() {
+    std::cout << "usage: gemcscRematch [-d treePath] [-w gemDeltaX] [-r cscDeltaR] [-f] [-a alignmentTable] [-t sta|gt|inner] input.root output.root" << std::endl;
+  }
+
+}
+
+int main(int argc, char** argv) {
+  Options opt;
+  int c;
+  while ((c = getopt(argc, argv, "d:w:r:fa:t:h")) != -1){
+    switch (c){
+    case 'd': opt.treePath = optarg; break;
+    case 'w': opt.gemWindow = std::stof(optarg); break;
+    case 'r': opt.cscWindow = std::stof(optarg); break;
+    case 'f': opt.flipped = true; break;
+    case 'a': opt.alignmentTable = optarg; break;
+    case 't':
+      if (std::string(optarg) == "sta") opt.track = residuals::kSta;
+      else if (std::string(optarg) == "gt") opt.track = residuals::kGlobal;
+      else if (std::string(optarg) == "inner") opt.track = residuals::kInner;
+      else { usage(); return 1; }
+      break;
+    default: usage(); return 1;
+    }
+  }
+  if (argc - optind != 2){
+    usage();
+    return 1;
+  }
+
+  gemalignment::Table alignment;
+  if (not opt.alignmentTable.empty()){
+    std::ifstream in(opt.alignmentTable);
+    int nEntries = 0;
+    std::string error;
+    if (not in){
+      std::cout << "Error! Can't open GEM alignment table " << opt.alignmentTable << std::endl;
+      return 1;
+    }
+    if (not alignment.read(in, nEntries, error)){
+      std::cout << "Error! " << error << " in GEM alignment table " << opt.alignmentTable << std::endl;
+      return 1;
+    }
+    std::cout << nEntries << " GEM alignment corrections from " << opt.alignmentTable << std::endl;
+  }
+
+  TFile* input = TFile::Open(argv[optind]);
+  if (input == nullptr or input->IsZombie()){
+    std::cout << "Error! Can't open " << argv[optind] << std::endl;
+    return 1;
+  }
+  TTree* tree = nullptr;
+  input->GetObject(opt.treePath.c_str(), tree);
+  if (tree == nullptr){
+    std::cout << "Error! No tree " << opt.treePath << " in " << argv[optind] << std::endl;
+    return 1;
+  }
+  MuonCandidates candidates;
+  candidates.setBranchAddresses(tree);
+
+  TFile output(argv[optind+1], "RECREATE");
+  TTree* out = new TTree("MuonData", "MuonData");
+  RematchData data;
+  data.book(out);
+
+  long nProp[2] = {0, 0}, nMatched[2] = {0, 0};
+  long nDropped = 0;
+  const Long64_t n = tree->GetEntries();
+  for (Long64_t i = 0; i < n; ++i){
+    tree->GetEntry(i);
+    data.init();
+    data.run = candidates.run;
+    data.lumi = candidates.lumi;
+    data.event = candidates.event;
+    data.muonIndex = candidates.muonIndex;
+    data.muonpt = candidates.muonpt;
+    data.muoneta = candidates.muoneta;
+    data.muonphi = candidates.muonphi;
+    data.has_TightID = candidates.has_TightID;
+    nDropped += candidates.nDropped;
+
+    matchGE11(candidates, opt, alignment, data);
+    matchME11(candidates, opt, data);
+    for (int layer = 0; layer < 2; ++layer){
+      if (data.has_GE11[layer] and data.has_ME11[2])
+	data.dphi_keyCSCRechit_GE11Rechit[layer] = deltaPhi(data.rechit_phi_ME11[2], data.rechit_phi_GE11[layer]);
+      if (data.has_propGE11[layer]){
+	nProp[layer]++;
+	if (data.has_GE11[layer]) nMatched[layer]++;
+      }
+    }
+    out->Fill();
+  }
+  out->Write();
+  output.Close();
+  input->Close();
+
+  std::cout << "gemcscRematch: " << n << " muons";
+  if (nDropped > 0) std::cout << ", " << nDropped << " propagations/hits dropped when the candidates were stored";
+  std::cout << std::endl;
+  for (int layer = 0; layer < 2; ++layer)
+    std::cout << "GE11 layer " << layer+1 << " matched " << nMatched[layer] << " / " << nProp[layer] << " propagated" << std::endl;
+  return 0;
+}
@@ -8,6 +8,7 @@ process.load('Configuration.StandardSequences.GeometryRecoDB_cff')
 process.load('Configuration.StandardSequences.MagneticField_AutoFromDBCurrent_cff')
 process.load('Configuration.StandardSequences.FrontierConditions_GlobalTag_cff')
 process.load('RecoMuon.TrackingTools.MuonServiceProxy_cff')
+process.load('GEMCSCBendingAnalyzer.MuonAnalyser.muonSummary_cfi')
 process.load('TrackingTools.TransientTrack.TransientTrackBuilder_cfi')
 from Configuration.AlCa.GlobalTag import GlobalTag
 process.GlobalTag = GlobalTag(process.GlobalTag, '101X_dataRun2_Prompt_v10', '')
@@ -55,10 +56,10 @@ process.SliceTestAnalysis = cms.EDAnalyzer('SliceTestAnalysis',
     csclcts = cms.InputTag("muonCSCDigis", "MuonCSCCorrelatedLCTDigi"),
     cscSegments = cms.InputTag("cscSegments"),
     muons = cms.InputTag("muons"),
-    vertexCollection = cms.InputTag("offlinePrimaryVertices"),
+    muonSummary = cms.InputTag("muonSummary"),
     matchMuonwithLCT = cms.untracked.bool(False),
 )
 
-process.p = cms.Path(process.SliceTestAnalysis)
+process.p = cms.Path(process.muonSummary+process.SliceTestAnalysis)
 
 
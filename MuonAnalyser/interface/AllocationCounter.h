@@ -0,0 +1,29 @@
+#ifndef GEMCSCBendingAnalyzer_MuonAnalyser_AllocationCounter_h
+#define GEMCSCBendingAnalyzer_MuonAnalyser_AllocationCounter_h
+
+// Number of operator new calls and requested bytes since the start of the job, counted by
+// bin/gemcscAllocationCounter.cc when preloaded:
+//   LD_PRELOAD=$CMSSW_BASE/lib/$SCRAM_ARCH/libgemcscAllocationCounter.so cmsRun runSliceTestAnalysis.py
+// Without it available() is false and the counts stay at 0.
+// The counts are process wide, per event differences include other threads of a multi threaded job.
+
+extern "C" void gemcscAllocationCounts(unsigned long long* n, unsigned long long* bytes) __attribute__((weak));
+
+namespace allocationcounter {
+
+  struct Counts {
+    unsigned long long n = 0;
+    unsigned long long bytes = 0;
+  };
+
+  inline bool available() { return gemcscAllocationCounts != nullptr; }
+
+  inline Counts now() {
+    Counts c;
+    if (available()) gemcscAllocationCounts(&c.n, &c.bytes);
+    return c;
+  }
+
+}
+
+#endif
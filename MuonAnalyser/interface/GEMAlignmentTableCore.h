@@ -0,0 +1,76 @@
+#ifndef GEMCSCBendingAnalyzer_MuonAnalyser_GEMAlignmentTableCore_h
+#define GEMCSCBendingAnalyzer_MuonAnalyser_GEMAlignmentTableCore_h
+
+// CMSSW-free GE11 alignment table: one correction per eta partition in a flat array indexed by
+// matching::rollIndex, and the reader of its text format. Used by GEMAlignmentTable (plugins),
+// which adds the GEMDetId lookup and the cms::Exception, and by gemcscRematch.
+// The aligned local x of a rechit is x + deltaX + rotation*y, (x, y) local to its eta partition.
+//
+// Text table, one correction per line, '#' starts a comment:
+//   region chamber layer roll deltaX[cm] rotation[rad]
+// roll 0 sets all eta partitions of the chamber layer; later lines override earlier ones.
+
+#include <istream>
+#include <sstream>
+#include <string>
+
+#include "GEMCSCBendingAnalyzer/MuonAnalyser/interface/MatchingCore.h"
+
+namespace gemalignment {
+
+  struct Entry {
+    float deltaX;  //cm
+    float rotation;//rad
+  };
+
+  class Table {
+  public:
+    //region -1 or 1, chamber 1..36, layer 1..2, roll 1..8, roll 0 sets all rolls; returns false if out of range
+    bool set(int region, int chamber, int layer, int roll, float deltaX, float rotation) {
+      const int first = roll == 0 ? 1 : roll;
+      const int last = roll == 0 ? matching::kNRolls : roll;
+      for (int r = first; r <= last; ++r){
+	const int i = matching::rollIndex(region, chamber, layer, r);
+	if (i < 0) return false;
+	entries_[i] = {deltaX, rotation};
+      }
+      return true;
+    }
+
+    //the correction of a GE11 eta partition, zero if out of range
+    const Entry& get(int region, int chamber, int layer, int roll) const {
+      const int i = matching::rollIndex(region, chamber, layer, roll);
+      return i >= 0 ? entries_[i] : zero_;
+    }
+
+    //text table as above, nEntries is the number of correction lines read
+    //returns false at the first line that can't be parsed or is out of range, with its number and text in error
+    bool read(std::istream& in, int& nEntries, std::string& error) {
+      std::string line;
+      int nline = 0;
+      nEntries = 0;
+      while (std::getline(in, line)){
+	nline++;
+	const size_t comment = line.find('#');
+	if (comment != std::string::npos) line.erase(comment);
+	std::istringstream fields(line);
+	int region, chamber, layer, roll;
+	float deltaX, rotation;
+	if (not (fields >> region)) continue;//empty line
+	if (not (fields >> chamber >> layer >> roll >> deltaX >> rotation) or not set(region, chamber, layer, roll, deltaX, rotation)){
+	  error = "bad line " + std::to_string(nline) + ": " + line;
+	  return false;
+	}
+	nEntries++;
+      }
+      return true;
+    }
+
+  private:
+    Entry entries_[matching::kNGE11Rolls] = {};
+    Entry zero_ = {0.f, 0.f};
+  };
+
+}
+
+#endif
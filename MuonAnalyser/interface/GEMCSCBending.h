@@ -0,0 +1,55 @@
+#ifndef GEMCSCBendingAnalyzer_MuonAnalyser_GEMCSCBending_h
+#define GEMCSCBendingAnalyzer_MuonAnalyser_GEMCSCBending_h
+
+// GE1/1 - ME1/1 matching result of one muon, stored by GEMCSCBendingProducer
+// as a ValueMap over the muon collection.
+// [2] are the two GE11 layers; ME11 quantities are taken at the key layer (layer 3).
+// Default values are the ones of the SliceTestAnalysis ntuple.
+// The class is versioned in src/classes_def.xml, bump ClassVersion when changing the members
+// and regenerate the checksum with script/updateClassVersions.sh.
+
+#include <vector>
+
+struct GEMCSCBending
+{
+  GEMCSCBending();
+
+  bool valid;//muon passed the selection and was propagated
+
+  //GE11 rechit matched to the standalone track propagation
+  bool has_GE11[2];
+  int chamber_GE11[2];
+  int roll_GE11[2];
+  float rechit_phi_GE11[2];
+  float rechit_alignedphi_GE11[2];
+  float rechit_localx_GE11[2];
+  //standalone track propagated to GE11
+  bool has_propGE11[2];
+  float prop_phi_GE11[2];
+  float prop_localx_GE11[2];
+
+  //ME11 segment
+  bool has_cscseg;
+  int cscseg_chamber;
+  int cscseg_ring;
+  float cscseg_phi;
+  //ME11 key layer rechit and propagation
+  bool has_ME11;
+  float rechit_phi_ME11;
+  float rechit_L1phi_ME11;
+  bool has_propME11;
+  float prop_phi_ME11;
+
+  //bending angles, ME11 - GE11
+  float dphi_CSCSeg_GE11Rechit[2];
+  float dphi_CSCSeg_alignedGE11Rechit[2];
+  float dphi_keyCSCRechit_GE11Rechit[2];
+  float dphi_keyCSCRechit_alignedGE11Rechit[2];
+  float dphi_keyCSCRechitL1_GE11Rechit[2];
+  float dphi_keyCSCRechitL1_alignedGE11Rechit[2];
+  float dphi_propCSC_propGE11[2];
+};
+
+typedef std::vector<GEMCSCBending> GEMCSCBendingCollection;
+
+#endif
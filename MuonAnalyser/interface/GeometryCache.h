@@ -0,0 +1,237 @@
+#ifndef GEMCSCBendingAnalyzer_MuonAnalyser_GeometryCache_h
+#define GEMCSCBendingAnalyzer_MuonAnalyser_GeometryCache_h
+
+// CMSSW-free binary cache of the GE1/1 eta partitions and ME1/1 layers used by SliceTestAnalysis:
+// surface position and rotation, trapezoid bounds, strip edges and angles, ME1/1 wire groups.
+// Written by the GEMCSCGeometryCacheWriter plugin, read with mmap and used in place, no copy:
+//   geomcache::GeometryCache cache;
+//   if (not cache.open("GE11ME11Geometry.bin")) std::cout << cache.error() << std::endl;
+//   const geomcache::Det det = cache.find(rawId);
+//   if (det) strip = det.strip(x, y);
+// The file is in the byte order of the machine that wrote it, the loader rejects other versions
+// and records without strips or with arrays outside the float block.
+//
+// Strips of both detector types are straight lines through a common apex in the local frame
+// (GE1/1 trapezoidal, ME1/1 radial topology), so per detector the strip edges at local y = 0
+// and the apex give every strip position. Strip numbers follow StripTopology: 0 is the lower edge
+// of the first strip, strip s has its centre at s - 0.5. Angles are StripTopology::stripAngle at the edges.
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <string>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace geomcache {
+
+  static const char kMagic[8] = {'G', 'E', 'M', 'C', 'S', 'C', 'G', 'C'};
+  static const uint32_t kVersion = 1;
+
+  enum DetType : uint32_t { kGE11Roll = 0, kME11Layer = 1 };
+
+  struct FileHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t nDets;
+    uint64_t nFloats;
+    uint64_t detOffset;  //bytes from the start of the file
+    uint64_t floatOffset;
+  };
+
+  //one eta partition or layer, the arrays are in the float block of the file
+  struct DetRecord {
+    uint32_t rawId;
+    uint32_t type;//DetType
+    float position[3];//global, cm
+    float rotation[9];//xx xy xz yx yy yz zx zy zz, rows are the local axes in the global frame
+    float halfWidthBottom, halfWidthTop, halfLength, halfThickness;//cm, bottom at local y = -halfLength
+    float apexX, apexY;//common point of the strips, local; apexY = 0 if the strips are parallel
+    uint32_t nStrips;
+    uint32_t stripEdgeX;//offset of nStrips+1 local x of the strip edges at y = 0
+    uint32_t stripEdgeAngle;//offset of nStrips+1 strip angles at the edges
+    uint32_t nWireGroups;//0 for GE1/1
+    uint32_t wireGroupY;//offset of nWireGroups local y of the middle wire of the groups at x = 0
+    float wireSlope;//dy/dx of the wires
+  };
+
+  struct LocalPoint { float x, y; };
+  struct GlobalPoint { float x, y, z; };
+
+  //view of one detector in the mapped file
+  class Det {
+  public:
+    Det() {}
+    Det(const DetRecord* record, const float* data) : r_(record), data_(data) {}
+    explicit operator bool() const { return r_ != nullptr; }
+    const DetRecord& record() const { return *r_; }
+    uint32_t rawId() const { return r_->rawId; }
+    int nStrips() const { return r_->nStrips; }
+    int nWireGroups() const { return r_->nWireGroups; }
+
+    //local x of strip edge e (0..nStrips) at local y
+    float edgeX(int e, float y) const {
+      const float x0 = data_[r_->stripEdgeX + e];
+      if (r_->apexY == 0.0f) return x0;
+      return r_->apexX + (x0 - r_->apexX)*(y - r_->apexY)/(-r_->apexY);
+    }
+
+    //float strip number at local (x, y), outside the edges extrapolated with the first or last pitch
+    float strip(float x, float y) const {
+      const int n = r_->nStrips;
+      const bool increasing = data_[r_->stripEdgeX + n] > data_[r_->stripEdgeX];
+      //first edge beyond x
+      int lo = 0, hi = n;
+      while (lo < hi){
+	const int mid = (lo + hi)/2;
+	if ((edgeX(mid, y) < x) == increasing) lo = mid + 1;
+	else hi = mid;
+      }
+      const int e = std::min(std::max(lo, 1), n);
+      const float x1 = edgeX(e - 1, y), x2 = edgeX(e, y);
+      return e - 1 + (x - x1)/(x2 - x1);
+    }
+
+    //local point of a float strip number at y = 0, e.g. centreOfStrip(s - 0.5) for strip s
+    LocalPoint centreOfStrip(float strip) const {
+      const int e = std::min(std::max(int(strip), 0), int(r_->nStrips) - 1);
+      const float x1 = data_[r_->stripEdgeX + e], x2 = data_[r_->stripEdgeX + e + 1];
+      return {x1 + (strip - e)*(x2 - x1), 0.0f};
+    }
+
+    float stripAngle(float strip) const {
+      const int e = std::min(std::max(int(strip), 0), int(r_->nStrips) - 1);
+      const float a1 = data_[r_->stripEdgeAngle + e], a2 = data_[r_->stripEdgeAngle + e + 1];
+      return a1 + (strip - e)*(a2 - a1);
+    }
+
+    //local y of the middle wire of wire group wg (1..nWireGroups) at local x
+    float wireGroupY(int wg, float x) const { return data_[r_->wireGroupY + wg - 1] + r_->wireSlope*x; }
+
+    //centre line of strip (1..nStrips) crossing the middle wire of wire group wg (1..nWireGroups)
+    LocalPoint stripWireGroupIntersection(int strip, int wg) const {
+      const float xc = centreOfStrip(strip - 0.5f).x;
+      const float yw = data_[r_->wireGroupY + wg - 1];
+      if (r_->apexY == 0.0f) return {xc, yw + r_->wireSlope*xc};
+      //strip: x = apexX + k (y - apexY), wire: y = yw + wireSlope x
+      const float k = (xc - r_->apexX)/(-r_->apexY);
+      const float y = (yw + r_->wireSlope*(r_->apexX - k*r_->apexY))/(1.0f - r_->wireSlope*k);
+      return {r_->apexX + k*(y - r_->apexY), y};
+    }
+
+    bool inside(float x, float y) const {
+      if (std::fabs(y) > r_->halfLength) return false;
+      const float halfWidth = r_->halfWidthBottom + (r_->halfWidthTop - r_->halfWidthBottom)*(y + r_->halfLength)/(2*r_->halfLength);
+      return std::fabs(x) <= halfWidth;
+    }
+
+    GlobalPoint toGlobal(float x, float y, float z = 0.0f) const {
+      const float* R = r_->rotation;
+      return {r_->position[0] + R[0]*x + R[3]*y + R[6]*z,
+	      r_->position[1] + R[1]*x + R[4]*y + R[7]*z,
+	      r_->position[2] + R[2]*x + R[5]*y + R[8]*z};
+    }
+
+    //local x, y; z (distance to the surface) in *z if given
+    LocalPoint toLocal(const GlobalPoint& g, float* z = nullptr) const {
+      const float* R = r_->rotation;
+      const float dx = g.x - r_->position[0], dy = g.y - r_->position[1], dz = g.z - r_->position[2];
+      if (z) *z = R[6]*dx + R[7]*dy + R[8]*dz;
+      return {R[0]*dx + R[1]*dy + R[2]*dz, R[3]*dx + R[4]*dy + R[5]*dz};
+    }
+
+  private:
+    const DetRecord* r_ = nullptr;
+    const float* data_ = nullptr;
+  };
+
+  //read only mapping of a cache file, detectors sorted by raw id
+  class GeometryCache {
+  public:
+    GeometryCache() {}
+    GeometryCache(const GeometryCache&) = delete;
+    GeometryCache& operator=(const GeometryCache&) = delete;
+    ~GeometryCache() { close(); }
+
+    bool open(const std::string& fileName) {
+      close();
+      const int fd = ::open(fileName.c_str(), O_RDONLY);
+      if (fd < 0) return fail("can't open " + fileName);
+      struct stat st;
+      if (fstat(fd, &st) != 0 or size_t(st.st_size) < sizeof(FileHeader)){
+	::close(fd);
+	return fail(fileName + " is not a geometry cache");
+      }
+      size_ = st.st_size;
+      map_ = mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+      ::close(fd);
+      if (map_ == MAP_FAILED){
+	map_ = nullptr;
+	return fail("can't map " + fileName);
+      }
+      const char* base = static_cast<const char*>(map_);
+      const FileHeader* header = reinterpret_cast<const FileHeader*>(base);
+      if (std::memcmp(header->magic, kMagic, sizeof(kMagic)) != 0 or header->version != kVersion)
+	return fail(fileName + " is not a geometry cache of version " + std::to_string(kVersion));
+      if (header->detOffset + header->nDets*sizeof(DetRecord) > size_ or header->floatOffset + header->nFloats*sizeof(float) > size_)
+	return fail(fileName + " is truncated");
+      const DetRecord* dets = reinterpret_cast<const DetRecord*>(base + header->detOffset);
+      //the arrays of every record must lie within the float block
+      for (uint32_t i = 0; i < header->nDets; ++i){
+	const DetRecord& r = dets[i];
+	const std::string det = fileName + ": det " + std::to_string(r.rawId);
+	if (r.nStrips == 0)
+	  return fail(det + " has no strips");
+	if (uint64_t(r.stripEdgeX) + r.nStrips + 1 > header->nFloats or uint64_t(r.stripEdgeAngle) + r.nStrips + 1 > header->nFloats)
+	  return fail(det + " has strip edges beyond the float block");
+	if (uint64_t(r.wireGroupY) + r.nWireGroups > header->nFloats)
+	  return fail(det + " has wire groups beyond the float block");
+      }
+      dets_ = dets;
+      data_ = reinterpret_cast<const float*>(base + header->floatOffset);
+      nDets_ = header->nDets;
+      return true;
+    }
+
+    void close() {
+      if (map_) munmap(map_, size_);
+      map_ = nullptr;
+      dets_ = nullptr;
+      data_ = nullptr;
+      nDets_ = 0;
+    }
+
+    //empty Det if the id is not in the cache
+    Det find(uint32_t rawId) const {
+      const DetRecord* end = dets_ + nDets_;
+      const DetRecord* r = std::lower_bound(dets_, end, rawId, [](const DetRecord& d, uint32_t id){ return d.rawId < id; });
+      if (r == end or r->rawId != rawId) return Det();
+      return Det(r, data_);
+    }
+
+    size_t size() const { return nDets_; }
+    Det det(size_t i) const { return Det(dets_ + i, data_); }
+    const std::string& error() const { return error_; }
+
+  private:
+    bool fail(const std::string& message) {
+      close();
+      error_ = message;
+      return false;
+    }
+
+    void* map_ = nullptr;
+    size_t size_ = 0;
+    const DetRecord* dets_ = nullptr;
+    const float* data_ = nullptr;
+    size_t nDets_ = 0;
+    std::string error_;
+  };
+
+}
+
+#endif
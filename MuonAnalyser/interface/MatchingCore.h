@@ -0,0 +1,75 @@
+#ifndef GEMCSCBendingAnalyzer_MuonAnalyser_MatchingCore_h
+#define GEMCSCBendingAnalyzer_MuonAnalyser_MatchingCore_h
+
+// CMSSW-free core of the GE1/1 - ME1/1 matching: strip numbering, alignment corrections and
+// nearest hit selection over neighbouring eta partitions, on plain floats and the sorted hit index.
+// Residuals are in ResidualKernel.h. Used by GEMCSCBendingAlgo, gemcscRematch and
+// gemcscMatchingBenchmark, which builds with a plain compiler and -I$CMSSW_BASE/src.
+
+#include <cmath>
+#include <cstdint>
+
+#include "GEMCSCBendingAnalyzer/MuonAnalyser/interface/ResidualKernel.h"
+#include "GEMCSCBendingAnalyzer/MuonAnalyser/interface/SortedHitIndex.h"
+
+namespace matching {
+
+  //GE11 eta partitions have 384 strips read out by 3 VFAT sectors of 128
+  static const int kNGEMStrips = 384;
+  static const int kNGEMStripsPerSector = 128;
+
+  //float strip number of the strip centre, like 0.5, 1.5; integer strip if within 0.25 of the edge
+  inline float centerStripNumber(float strip) {
+    const int strip_int = int(strip);
+    const float frac = strip - strip_int;
+    if (frac > 0.25 and frac <= 0.75) return strip_int + 0.5;
+    if (frac > 0.75) return strip_int + 1.0;
+    return strip_int*1.0;
+  }
+
+  //strip number with the reversed ordering within each VFAT sector of the slice test chambers
+  //0 for strips outside the eta partition, see validGEMStrip
+  inline float flippedStripNumber(float strip) {
+    if (not (strip >= 0.0 and strip < kNGEMStrips)) return 0.0;
+    const int sector = int(strip)/kNGEMStripsPerSector;
+    return 2*sector*kNGEMStripsPerSector + kNGEMStripsPerSector - strip;
+  }
+  inline bool validGEMStrip(float strip) { return strip >= 0.0 and strip < kNGEMStrips; }
+
+  //index of a GE11 eta partition in flat per roll tables: region -1 or 1, chamber 1..36, layer 1..2, roll 1..8
+  //-1 if out of range
+  static const int kNRegions = 2;
+  static const int kNChambers = 36;
+  static const int kNLayers = 2;
+  static const int kNRolls = 8;
+  static const int kNGE11Rolls = kNRegions*kNChambers*kNLayers*kNRolls;
+  inline int rollIndex(int region, int chamber, int layer, int roll) {
+    if ((region != -1 and region != 1) or chamber < 1 or chamber > kNChambers or layer < 1 or layer > kNLayers or roll < 1 or roll > kNRolls)
+      return -1;
+    return (((region > 0 ? 1 : 0)*kNChambers + chamber-1)*kNLayers + layer-1)*kNRolls + roll-1;
+  }
+
+  //aligned local x of a hit at local (x, y) of its eta partition
+  inline float alignedX(float x, float y, float deltaX, float rotation) { return x + deltaX + rotation*y; }
+
+  //nearest hit in local x to x0 in eta partition roll and its neighbours
+  //rollKey(r) gives the index key of roll r of the same chamber layer; mindX is updated with the distance
+  template <class Hit, class RollKey>
+  inline const hitindex::Entry<Hit>* nearestInRolls(const hitindex::Index<Hit>& index, int roll, RollKey rollKey, float x0, float& mindX) {
+    const hitindex::Entry<Hit>* best = nullptr;
+    for (int r = roll - 1; r <= roll + 1; ++r){
+      if (r < 1) continue;
+      auto sorted = index.find(rollKey(r));
+      if (sorted == index.end()) continue;
+      const auto* nearest = sorted->second.nearestInX(x0);
+      if (nearest and std::fabs(nearest->x - x0) < mindX){
+        mindX = std::fabs(nearest->x - x0);
+        best = nearest;
+      }
+    }
+    return best;
+  }
+
+}
+
+#endif
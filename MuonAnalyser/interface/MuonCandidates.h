@@ -0,0 +1,163 @@
+#ifndef GEMCSCBendingAnalyzer_MuonAnalyser_MuonCandidates_h
+#define GEMCSCBendingAnalyzer_MuonAnalyser_MuonCandidates_h
+
+// Per muon candidate record for re-matching without cmsRun: the standalone, global and inner
+// track propagations to GE1/1 eta partitions and ME1/1 layers, and every GE1/1 / ME1/1 rechit
+// within a generous window of them. Written by SliceTestAnalysis (storeCandidates),
+// read by the gemcscRematch executable. Only ROOT is needed to read it.
+//
+// Tracks are indexed as residuals::Track, [0] standalone, [1] global, [2] inner.
+// GE11 hits keep both the reconstructed and the flipped strip positions, so strip ordering and
+// alignment can be changed offline: aligned x = x + deltaX + rotation*y,
+// phi(x') ~ phi + dphidx*(x' - x).
+
+#include "TTree.h"
+
+struct MuonCandidates
+{
+  static const int kNTracks = 3;
+  static const int kMaxGE11Props = 8;
+  static const int kMaxGE11Hits = 64;
+  static const int kMaxME11Props = 12;
+  static const int kMaxME11Hits = 64;
+
+  void init() {
+    nGE11Props = nGE11Hits = nME11Props = nME11Hits = 0;
+    nDropped = 0;
+  }
+  //output tree, one entry per muon
+  void book(TTree *t) {
+    branches([t](const char* name, void* address, const char* leaflist){ t->Branch(name, address, leaflist); });
+  }
+  //input tree of the re-matcher
+  void setBranchAddresses(TTree *t) {
+    branches([t](const char* name, void* address, const char*){ t->SetBranchAddress(name, address); });
+  }
+
+  Int_t run, lumi, event;
+  int muonIndex;//index in the muon collection
+  float muonpt, muoneta, muonphi;
+  int muoncharge;
+  bool has_TightID;
+  float window;//cm, GE11 local x / ME11 local dR window of the stored hits
+  int nDropped;//hits beyond the array sizes
+
+  //propagations to GE11 eta partitions
+  int nGE11Props;
+  int propGE11_region[kMaxGE11Props];
+  int propGE11_chamber[kMaxGE11Props];
+  int propGE11_layer[kMaxGE11Props];
+  int propGE11_roll[kMaxGE11Props];
+  float propGE11_middlePerp[kMaxGE11Props];//perp of the middle of the roll
+  float propGE11_phi[kMaxGE11Props];//global phi, standalone track
+  float propGE11_x[kMaxGE11Props][kNTracks];//local
+  float propGE11_y[kMaxGE11Props][kNTracks];
+
+  //GE11 rechits within window in local x of a propagation, in its roll and the neighbouring ones,
+  //with the reconstructed or the flipped strip positions
+  int nGE11Hits;
+  int hitGE11_region[kMaxGE11Hits];
+  int hitGE11_chamber[kMaxGE11Hits];
+  int hitGE11_layer[kMaxGE11Hits];
+  int hitGE11_roll[kMaxGE11Hits];
+  int hitGE11_BX[kMaxGE11Hits];
+  int hitGE11_clusterSize[kMaxGE11Hits];
+  int hitGE11_firstClusterStrip[kMaxGE11Hits];
+  float hitGE11_strip[kMaxGE11Hits];
+  float hitGE11_x[kMaxGE11Hits];//local, as reconstructed
+  float hitGE11_flippedX[kMaxGE11Hits];//local, centre of the flipped strip
+  float hitGE11_y[kMaxGE11Hits];
+  float hitGE11_stripAngle[kMaxGE11Hits];
+  float hitGE11_flippedStripAngle[kMaxGE11Hits];
+  float hitGE11_middlePerp[kMaxGE11Hits];
+  float hitGE11_phi[kMaxGE11Hits];
+  float hitGE11_flippedPhi[kMaxGE11Hits];
+  float hitGE11_dphidx[kMaxGE11Hits];//rad/cm, for aligned positions
+
+  //propagations to ME11 layers
+  int nME11Props;
+  int propME11_endcap[kMaxME11Props];
+  int propME11_chamber[kMaxME11Props];
+  int propME11_ring[kMaxME11Props];
+  int propME11_layer[kMaxME11Props];
+  float propME11_phi[kMaxME11Props];//global phi, standalone track
+  float propME11_x[kMaxME11Props][kNTracks];//local
+  float propME11_y[kMaxME11Props][kNTracks];
+
+  //ME11 rechits within window in local dR of the standalone propagation, in the same layer, needs matchMuonwithCSCRechit
+  int nME11Hits;
+  int hitME11_endcap[kMaxME11Hits];
+  int hitME11_chamber[kMaxME11Hits];
+  int hitME11_ring[kMaxME11Hits];
+  int hitME11_layer[kMaxME11Hits];
+  float hitME11_x[kMaxME11Hits];//local
+  float hitME11_y[kMaxME11Hits];
+  float hitME11_stripAngle[kMaxME11Hits];
+  float hitME11_phi[kMaxME11Hits];
+
+private:
+  template <class F>
+  void branches(F f) {
+    f("run", &run, "run/I");
+    f("lumi", &lumi, "lumi/I");
+    f("event", &event, "event/I");
+    f("muonIndex", &muonIndex, "muonIndex/I");
+    f("muonpt", &muonpt, "muonpt/F");
+    f("muoneta", &muoneta, "muoneta/F");
+    f("muonphi", &muonphi, "muonphi/F");
+    f("muoncharge", &muoncharge, "muoncharge/I");
+    f("has_TightID", &has_TightID, "has_TightID/O");
+    f("window", &window, "window/F");
+    f("nDropped", &nDropped, "nDropped/I");
+
+    f("nGE11Props", &nGE11Props, "nGE11Props/I");
+    f("propGE11_region", propGE11_region, "propGE11_region[nGE11Props]/I");
+    f("propGE11_chamber", propGE11_chamber, "propGE11_chamber[nGE11Props]/I");
+    f("propGE11_layer", propGE11_layer, "propGE11_layer[nGE11Props]/I");
+    f("propGE11_roll", propGE11_roll, "propGE11_roll[nGE11Props]/I");
+    f("propGE11_middlePerp", propGE11_middlePerp, "propGE11_middlePerp[nGE11Props]/F");
+    f("propGE11_phi", propGE11_phi, "propGE11_phi[nGE11Props]/F");
+    f("propGE11_x", propGE11_x, "propGE11_x[nGE11Props][3]/F");
+    f("propGE11_y", propGE11_y, "propGE11_y[nGE11Props][3]/F");
+
+    f("nGE11Hits", &nGE11Hits, "nGE11Hits/I");
+    f("hitGE11_region", hitGE11_region, "hitGE11_region[nGE11Hits]/I");
+    f("hitGE11_chamber", hitGE11_chamber, "hitGE11_chamber[nGE11Hits]/I");
+    f("hitGE11_layer", hitGE11_layer, "hitGE11_layer[nGE11Hits]/I");
+    f("hitGE11_roll", hitGE11_roll, "hitGE11_roll[nGE11Hits]/I");
+    f("hitGE11_BX", hitGE11_BX, "hitGE11_BX[nGE11Hits]/I");
+    f("hitGE11_clusterSize", hitGE11_clusterSize, "hitGE11_clusterSize[nGE11Hits]/I");
+    f("hitGE11_firstClusterStrip", hitGE11_firstClusterStrip, "hitGE11_firstClusterStrip[nGE11Hits]/I");
+    f("hitGE11_strip", hitGE11_strip, "hitGE11_strip[nGE11Hits]/F");
+    f("hitGE11_x", hitGE11_x, "hitGE11_x[nGE11Hits]/F");
+    f("hitGE11_flippedX", hitGE11_flippedX, "hitGE11_flippedX[nGE11Hits]/F");
+    f("hitGE11_y", hitGE11_y, "hitGE11_y[nGE11Hits]/F");
+    f("hitGE11_stripAngle", hitGE11_stripAngle, "hitGE11_stripAngle[nGE11Hits]/F");
+    f("hitGE11_flippedStripAngle", hitGE11_flippedStripAngle, "hitGE11_flippedStripAngle[nGE11Hits]/F");
+    f("hitGE11_middlePerp", hitGE11_middlePerp, "hitGE11_middlePerp[nGE11Hits]/F");
+    f("hitGE11_phi", hitGE11_phi, "hitGE11_phi[nGE11Hits]/F");
+    f("hitGE11_flippedPhi", hitGE11_flippedPhi, "hitGE11_flippedPhi[nGE11Hits]/F");
+    f("hitGE11_dphidx", hitGE11_dphidx, "hitGE11_dphidx[nGE11Hits]/F");
+
+    f("nME11Props", &nME11Props, "nME11Props/I");
+    f("propME11_endcap", propME11_endcap, "propME11_endcap[nME11Props]/I");
+    f("propME11_chamber", propME11_chamber, "propME11_chamber[nME11Props]/I");
+    f("propME11_ring", propME11_ring, "propME11_ring[nME11Props]/I");
+    f("propME11_layer", propME11_layer, "propME11_layer[nME11Props]/I");
+    f("propME11_phi", propME11_phi, "propME11_phi[nME11Props]/F");
+    f("propME11_x", propME11_x, "propME11_x[nME11Props][3]/F");
+    f("propME11_y", propME11_y, "propME11_y[nME11Props][3]/F");
+
+    f("nME11Hits", &nME11Hits, "nME11Hits/I");
+    f("hitME11_endcap", hitME11_endcap, "hitME11_endcap[nME11Hits]/I");
+    f("hitME11_chamber", hitME11_chamber, "hitME11_chamber[nME11Hits]/I");
+    f("hitME11_ring", hitME11_ring, "hitME11_ring[nME11Hits]/I");
+    f("hitME11_layer", hitME11_layer, "hitME11_layer[nME11Hits]/I");
+    f("hitME11_x", hitME11_x, "hitME11_x[nME11Hits]/F");
+    f("hitME11_y", hitME11_y, "hitME11_y[nME11Hits]/F");
+    f("hitME11_stripAngle", hitME11_stripAngle, "hitME11_stripAngle[nME11Hits]/F");
+    f("hitME11_phi", hitME11_phi, "hitME11_phi[nME11Hits]/F");
+  }
+};
+
+#endif
@@ -0,0 +1,43 @@
+#ifndef GEMCSCBendingAnalyzer_MuonAnalyser_MuonSummary_h
+#define GEMCSCBendingAnalyzer_MuonAnalyser_MuonSummary_h
+
+// Compact per muon summary computed once per event by the MuonAnalyser producer and stored
+// as a ValueMap over the muon collection: kinematics, IDs, isolation, impact parameters at the
+// best vertex and endcap flags. Consumed by GEMCSCBendingAlgo and SliceTestAnalysis (muonSummary).
+// Default values are the ones of the SliceTestAnalysis ntuple.
+// The class is versioned in src/classes_def.xml, bump ClassVersion when changing the members
+// and regenerate the checksum with script/updateClassVersions.sh.
+
+#include <vector>
+
+struct MuonSummary
+{
+  MuonSummary();
+
+  float pt, eta, phi;
+  float px, py, pz;
+  int charge;
+
+  bool isGlobal, isStandAlone, isTracker;
+  bool hasInnerTrack;
+  //tight ID at the best vertex
+  bool hasTightID, hasMediumID, hasLooseID;
+  int nChamber;//CSC and DT chambers
+  int nTrackerLayers;//with measurement, inner track
+  float globalChi2;//normalized, global track
+
+  //relative isolation, PF with delta beta correction in dR 0.4, tracker in dR 0.3
+  float pfIso, tkIso;
+
+  //best vertex: first valid, non fake one with at least 2 tracks and |z| < 24 cm;
+  //without it dxy and dz are taken at the origin
+  bool hasGoodVertex;
+  float dxy, dz;//cm, absolute, muon best track
+
+  int endcap;//+1/-1 by the eta sign
+  bool inME11, inGE11;//|eta| within the ME1/1 and GE1/1 coverage
+};
+
+typedef std::vector<MuonSummary> MuonSummaryCollection;
+
+#endif
@@ -0,0 +1,72 @@
+#ifndef GEMCSCBendingAnalyzer_MuonAnalyser_ResidualKernel_h
+#define GEMCSCBendingAnalyzer_MuonAnalyser_ResidualKernel_h
+
+// Residuals between one hit and the standalone, global and inner track extrapolations.
+// All hit variants (as reconstructed, flipped strips, aligned) and all three extrapolations
+// are done in one pass over packed arrays, so the compiler can unroll and vectorize it.
+
+#include <cmath>
+
+namespace residuals {
+
+  //track types, order of the packed extrapolation arrays
+  enum Track { kSta = 0, kGlobal, kInner, kNTracks };
+  //GEM hit variants: as reconstructed, with flipped strip numbering, flipped and aligned
+  enum GEMVariant { kRaw = 0, kFlipped, kAligned, kNGEMVariants };
+
+  //local (x, y) of the extrapolations to one surface
+  struct Extrapolations {
+    float x[kNTracks];
+    float y[kNTracks];
+  };
+
+  //local (x, y) of the hit variants
+  //RdPhi is measured along the strip (cosAngle, sinAngle of the strip angle), relative to yRef in local y
+  template <int NV>
+  struct Hits {
+    float x[NV];
+    float y[NV];
+    float yRef[NV];
+    float cosAngle[NV];
+    float sinAngle[NV];
+  };
+
+  template <int NV>
+  struct Residuals {
+    float dX[NV][kNTracks];        //hit - prop, local x
+    float dR[NV][kNTracks];        //hit - prop, local distance
+    float RdPhi[NV][kNTracks];     //cos*(prop.x - hit.x) + sin*(prop.y - yRef)
+    float RdPhiMinus[NV][kNTracks];//cos*(prop.x - hit.x) - sin*(prop.y - yRef)
+  };
+
+  template <int NV>
+  inline void compute(const Extrapolations &prop, const Hits<NV> &hits, Residuals<NV> &res)
+  {
+    for (int v = 0; v < NV; ++v){
+      for (int t = 0; t < kNTracks; ++t){
+        const float dx = hits.x[v] - prop.x[t];
+        const float dy = hits.y[v] - prop.y[t];
+        const float xterm = -hits.cosAngle[v]*dx;
+        const float yterm = hits.sinAngle[v]*(prop.y[t] - hits.yRef[v]);
+        res.dX[v][t] = dx;
+        res.dR[v][t] = std::sqrt(dx*dx + dy*dy);
+        res.RdPhi[v][t] = xterm + yterm;
+        res.RdPhiMinus[v][t] = xterm - yterm;
+      }
+    }
+  }
+
+  //fill one variant
+  template <int NV>
+  inline void setHit(Hits<NV> &hits, int v, float x, float y, float yRef, float angle)
+  {
+    hits.x[v] = x;
+    hits.y[v] = y;
+    hits.yRef[v] = yRef;
+    hits.cosAngle[v] = std::cos(angle);
+    hits.sinAngle[v] = std::sin(angle);
+  }
+
+}
+
+#endif
@@ -0,0 +1,116 @@
+#ifndef GEMCSCBendingAnalyzer_MuonAnalyser_SortedHitIndex_h
+#define GEMCSCBendingAnalyzer_MuonAnalyser_SortedHitIndex_h
+
+// Hits of one GEM eta partition or CSC layer sorted by local x, built once per event.
+// Nearest hit and window queries are a binary search plus a short scan,
+// so matching cost grows with log(occupancy) instead of the number of hits in the event.
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+namespace hitindex {
+
+  template <class Hit>
+  struct Entry {
+    float x;//local x used for matching, e.g. with flipped strips
+    float y;
+    const Hit* hit;
+  };
+
+  template <class Hit>
+  class SortedHits {
+  public:
+    void add(float x, float y, const Hit* hit) { entries_.push_back({x, y, hit}); }
+    void sort() {
+      std::sort(entries_.begin(), entries_.end(), [](const Entry<Hit>& a, const Entry<Hit>& b){ return a.x < b.x; });
+    }
+
+    //number of hits with |x - x0| < window
+    int countInWindow(float x0, float window) const {
+      auto first = std::upper_bound(entries_.begin(), entries_.end(), x0 - window, [](float x, const Entry<Hit>& e){ return x < e.x; });
+      auto last = std::lower_bound(first, entries_.end(), x0 + window, [](const Entry<Hit>& e, float x){ return e.x < x; });
+      return last - first;
+    }
+
+    //calls f(entry) for every hit with |x - x0| < window, in increasing x
+    template <class F>
+    void forEachInWindow(float x0, float window, F f) const {
+      auto first = std::upper_bound(entries_.begin(), entries_.end(), x0 - window, [](float x, const Entry<Hit>& e){ return x < e.x; });
+      for (auto it = first; it != entries_.end() and it->x < x0 + window; ++it) f(*it);
+    }
+
+    //calls f(entry) for every hit, in increasing x
+    template <class F>
+    void forEach(F f) const {
+      for (const auto& e : entries_) f(e);
+    }
+
+    //hit with the smallest |x - x0|, nullptr if there is none
+    const Entry<Hit>* nearestInX(float x0) const {
+      if (entries_.empty()) return nullptr;
+      auto it = lowerBound(x0);
+      if (it == entries_.end()) return &entries_.back();
+      if (it != entries_.begin() and x0 - (it-1)->x <= it->x - x0) --it;
+      return &*it;
+    }
+
+    //hit with the smallest local distance to (x0, y0), nullptr if there is none
+    //scans outwards from x0 and stops once |x - x0| alone exceeds the best distance
+    const Entry<Hit>* nearestInR(float x0, float y0, float &dR) const {
+      const Entry<Hit>* best = nullptr;
+      float best2 = 0.f;
+      auto check = [&](const Entry<Hit>& e){
+        const float dx = e.x - x0;
+        const float dy = e.y - y0;
+        const float d2 = dx*dx + dy*dy;
+        if (best == nullptr or d2 < best2){ best = &e; best2 = d2; }
+      };
+      auto mid = lowerBound(x0);
+      for (auto it = mid; it != entries_.end(); ++it){
+        const float dx = it->x - x0;
+        if (best != nullptr and dx*dx >= best2) break;
+        check(*it);
+      }
+      for (auto it = mid; it != entries_.begin(); ){
+        --it;
+        const float dx = x0 - it->x;
+        if (best != nullptr and dx*dx >= best2) break;
+        check(*it);
+      }
+      if (best != nullptr) dR = std::sqrt(best2);
+      return best;
+    }
+
+    size_t size() const { return entries_.size(); }
+    //removes the hits, keeps the memory for the next event
+    void clear() { entries_.clear(); }
+
+  private:
+    typename std::vector<Entry<Hit>>::const_iterator lowerBound(float x0) const {
+      return std::lower_bound(entries_.begin(), entries_.end(), x0, [](const Entry<Hit>& e, float x){ return e.x < x; });
+    }
+
+    std::vector<Entry<Hit>> entries_;
+  };
+
+  //sorted hits per DetId raw id
+  template <class Hit>
+  using Index = std::unordered_map<uint32_t, SortedHits<Hit>>;
+
+  template <class Hit>
+  inline void sortAll(Index<Hit>& index) {
+    for (auto& detHits : index) detHits.second.sort();
+  }
+
+  //empties every det of an index reused across events, dets without hits then behave as absent ones
+  template <class Hit>
+  inline void clearAll(Index<Hit>& index) {
+    for (auto& detHits : index) detHits.second.clear();
+  }
+
+}
+
+#endif
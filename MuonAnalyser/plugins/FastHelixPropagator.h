@@ -0,0 +1,136 @@
+#ifndef GEMCSCBendingAnalyzer_MuonAnalyser_FastHelixPropagator_h
+#define GEMCSCBendingAnalyzer_MuonAnalyser_FastHelixPropagator_h
+
+// Analytic helix propagation to a plane in a locally constant magnetic field.
+// Used as fast path for the short GE1/1 <-> ME1/1 extrapolations of high pT muons,
+// where the field is nearly uniform and the stepping propagator is overkill.
+// Tracks going to the same plane are propagated as one batch, stored as structure of arrays,
+// so that plane/field setup is done once and the per track arithmetic can vectorize.
+
+#include <cmath>
+
+namespace fasthelix {
+
+  //c in GeV/(T*cm): curvature = c * q/p * |B|
+  constexpr float kSpeedOfLight = 0.0029979246f;
+  constexpr int kMaxIterations = 4;
+  constexpr float kMinCosine = 1.e-6f;
+
+  // plane and field, shared by all tracks of a batch
+  struct PlaneSetup {
+    float planePos[3];
+    float planeNormal[3];
+    float bhat[3];
+    float kfactor;//c*|B|
+  };
+
+  // field: B (T), planePos/planeNormal: a point of the plane and its unit normal
+  inline PlaneSetup makePlaneSetup(const float field[3], const float planePos[3], const float planeNormal[3])
+  {
+    PlaneSetup setup;
+    const float bmag = std::sqrt(field[0]*field[0] + field[1]*field[1] + field[2]*field[2]);
+    for (int i = 0; i < 3; ++i){
+      setup.planePos[i] = planePos[i];
+      setup.planeNormal[i] = planeNormal[i];
+      setup.bhat[i] = bmag > 0.f ? field[i]/bmag : (i == 2 ? 1.f : 0.f);
+    }
+    setup.kfactor = kSpeedOfLight * bmag;
+    return setup;
+  }
+
+  // structure of arrays of up to N tracks: position (cm), unit direction, charge/momentum (1/GeV)
+  // after propagation position and direction are at the crossing point, path holds the signed path length
+  template <int N>
+  struct TrackBatch {
+    float x[N], y[N], z[N];
+    float tx[N], ty[N], tz[N];
+    float qoverp[N];
+    float path[N];
+    bool valid[N];
+    int size = 0;
+  };
+
+  // propagates all tracks of the batch to the plane
+  // the loop body has no early exit (fixed number of Newton steps), so it can vectorize across tracks
+  template <int N>
+  inline void propagateToPlane(TrackBatch<N> &batch, const PlaneSetup &setup)
+  {
+    const float* b = setup.bhat;
+    const float* n = setup.planeNormal;
+    //normal components along the field and along b x n are the same for every track
+    const float nb = n[0]*b[0] + n[1]*b[1] + n[2]*b[2];
+    const float bxn[3] = {b[1]*n[2]-b[2]*n[1], b[2]*n[0]-b[0]*n[2], b[0]*n[1]-b[1]*n[0]};
+    const float nplane = n[0]*setup.planePos[0] + n[1]*setup.planePos[1] + n[2]*setup.planePos[2];
+
+    for (int it = 0; it < batch.size; ++it){
+      const float t[3] = {batch.tx[it], batch.ty[it], batch.tz[it]};
+      const float k = setup.kfactor * batch.qoverp[it];
+
+      //split direction into components parallel and perpendicular to the field
+      const float tb = t[0]*b[0] + t[1]*b[1] + t[2]*b[2];
+      const float nt = n[0]*t[0] + n[1]*t[1] + n[2]*t[2];
+      const float np = nb*tb;
+      const float nperp = nt - np;
+      //n.(t_perp x b) = t.(b x n)
+      const float ncross = t[0]*bxn[0] + t[1]*bxn[1] + t[2]*bxn[2];
+      const float dist = nplane - (n[0]*batch.x[it] + n[1]*batch.y[it] + n[2]*batch.z[it]);
+
+      //straight line as starting point, then Newton iterations on n.(r(s) - r_plane) = 0
+      bool ok = std::fabs(nt) >= kMinCosine;
+      float s = dist/(ok ? nt : 1.f);
+      for (int i = 0; i < kMaxIterations; ++i){
+        const float ks = k*s;
+        //(sin(ks)/k, (1-cos(ks))/k) written to stay accurate for k -> 0
+        const bool small = std::fabs(ks) <= 1.e-6f;
+        const float sinhalf = std::sin(0.5f*ks);
+        const float sinks = small ? s : std::sin(ks)/k;
+        const float omcosks = small ? 0.5f*k*s*s : 2.f*sinhalf*sinhalf/k;
+        const float f = np*s + nperp*sinks + ncross*omcosks - dist;
+        const float ndir = np + nperp*std::cos(ks) + ncross*std::sin(ks);
+        ok = ok and std::fabs(ndir) >= kMinCosine;
+        s -= f/(ok ? ndir : 1.f);
+      }
+
+      const float ks = k*s;
+      const bool small = std::fabs(ks) <= 1.e-6f;
+      const float sinhalf = std::sin(0.5f*ks);
+      const float sinks = small ? s : std::sin(ks)/k;
+      const float omcosks = small ? 0.5f*k*s*s : 2.f*sinhalf*sinhalf/k;
+      const float coss = std::cos(ks);
+      const float sinn = std::sin(ks);
+      const float par[3] = {tb*b[0], tb*b[1], tb*b[2]};
+      const float perp[3] = {t[0]-par[0], t[1]-par[1], t[2]-par[2]};
+      const float cross[3] = {perp[1]*b[2]-perp[2]*b[1], perp[2]*b[0]-perp[0]*b[2], perp[0]*b[1]-perp[1]*b[0]};
+      batch.x[it] += par[0]*s + perp[0]*sinks + cross[0]*omcosks;
+      batch.y[it] += par[1]*s + perp[1]*sinks + cross[1]*omcosks;
+      batch.z[it] += par[2]*s + perp[2]*sinks + cross[2]*omcosks;
+      batch.tx[it] = par[0] + perp[0]*coss + cross[0]*sinn;
+      batch.ty[it] = par[1] + perp[1]*coss + cross[1]*sinn;
+      batch.tz[it] = par[2] + perp[2]*coss + cross[2]*sinn;
+      batch.path[it] = s;
+      batch.valid[it] = ok;
+    }
+  }
+
+  // single track version
+  // pos: position (cm), dir: unit direction, qoverp: charge/momentum (1/GeV), field: B (T)
+  // on success pos and dir are moved to the crossing point and path holds the signed path length
+  inline bool propagateToPlane(float pos[3], float dir[3], float qoverp, const float field[3],
+                               const float planePos[3], const float planeNormal[3], float &path)
+  {
+    TrackBatch<1> batch;
+    batch.x[0] = pos[0]; batch.y[0] = pos[1]; batch.z[0] = pos[2];
+    batch.tx[0] = dir[0]; batch.ty[0] = dir[1]; batch.tz[0] = dir[2];
+    batch.qoverp[0] = qoverp;
+    batch.size = 1;
+    propagateToPlane(batch, makePlaneSetup(field, planePos, planeNormal));
+    if (not batch.valid[0]) return false;
+    pos[0] = batch.x[0]; pos[1] = batch.y[0]; pos[2] = batch.z[0];
+    dir[0] = batch.tx[0]; dir[1] = batch.ty[0]; dir[2] = batch.tz[0];
+    path = batch.path[0];
+    return true;
+  }
+
+}
+
+#endif
@@ -0,0 +1,146 @@
+#include "GEMAlignmentEstimator.h"
+
+#include "FWCore/ServiceRegistry/interface/Service.h"
+#include "CommonTools/UtilAlgos/interface/TFileService.h"
+
+#include <cmath>
+#include <fstream>
+#include <iostream>
+
+GEMAlignmentEstimator::GEMAlignmentEstimator(const edm::ParameterSet& iConfig) :
+  selection_(iConfig)
+{
+  maxDphi_ = iConfig.getUntrackedParameter<double>("alignmentMaxDphi", 0.02);
+  maxClusterSize_ = iConfig.getUntrackedParameter<int>("alignmentMaxClusterSize", 6);
+  minEntries_ = iConfig.getUntrackedParameter<int>("alignmentMinEntries", 60);
+  window_ = iConfig.getUntrackedParameter<double>("alignmentWindow", 1.0);
+  output_ = iConfig.getUntrackedParameter<std::string>("alignmentOutput", "GEMAlignment_cff.py");
+  tableOutput_ = iConfig.getUntrackedParameter<std::string>("alignmentTableOutput", "GEMAlignmentTable.txt");
+
+  edm::Service<TFileService> fs;
+  TFileDirectory dir = fs->mkdir("alignment");
+  const char* endcaps[2] = {"Em", "Ep"};
+  for (int e=0; e<2; ++e){
+    for (int l=0; l<2; ++l){
+      h_residual_[e][l] = dir.make<TH3F>(Form("GE11_residual_%s_L%d", endcaps[e], l+1), Form("GE11 %s layer %d;chamber;roll;prop - rechit local x [cm]", endcaps[e], l+1),
+					 kNChambers, 0.5, kNChambers+0.5, kNRolls, 0.5, kNRolls+0.5, 200, -2.5, 2.5);
+      h_radius_[e][l] = dir.make<TProfile2D>(Form("GE11_radius_%s_L%d", endcaps[e], l+1), Form("GE11 %s layer %d;chamber;roll;radius [cm]", endcaps[e], l+1),
+					     kNChambers, 0.5, kNChambers+0.5, kNRolls, 0.5, kNRolls+0.5);
+    }
+  }
+}
+
+void GEMAlignmentEstimator::fill(const MuonData& data)
+{
+  if (not selection_.muon(data)) return;
+  const int e = data.muonendcap > 0 ? 1 : 0;
+  for (int l=0; l<2; ++l){
+    if (not data.has_GE11[l]) continue;
+    if (std::abs(data.rechit_prop_dphi_GE11[l]) > maxDphi_) continue;
+    if (data.rechit_clusterSize_GE11[l] > maxClusterSize_) continue;
+    //residual before alignment, with flipped strips if flippedGEMStrip
+    h_residual_[e][l]->Fill(data.chamber_GE11[l], data.roll_rechitGE11[l], -data.rechit_prop_dX_GE11[l]);
+    h_radius_[e][l]->Fill(data.chamber_GE11[l], data.roll_rechitGE11[l], data.middle_perp_rechitGE11[l]);
+  }
+}
+
+bool GEMAlignmentEstimator::rollMean(const TH3F& h, int chamberBin, int rollBin, double window, int minEntries, double& mean, double& error)
+{
+  const TAxis* axis = h.GetZaxis();
+  double center = 0.0;
+  double halfWidth = axis->GetXmax() - axis->GetXmin();
+  for (int iter=0; iter<3; ++iter){
+    double n = 0.0, sum = 0.0, sum2 = 0.0;
+    for (int b=1; b<=axis->GetNbins(); ++b){
+      const double x = axis->GetBinCenter(b);
+      if (std::abs(x - center) > halfWidth) continue;
+      const double w = h.GetBinContent(chamberBin, rollBin, b);
+      n += w;
+      sum += w*x;
+      sum2 += w*x*x;
+    }
+    if (n < minEntries) return false;
+    mean = sum/n;
+    error = std::sqrt(std::max(sum2/n - mean*mean, 0.0)/n);
+    center = mean;
+    halfWidth = window;
+  }
+  return true;
+}
+
+GEMAlignmentEstimator::Correction GEMAlignmentEstimator::fit(int endcap, int layer, int chamber) const
+{
+  //weighted straight line, residual = deltaX + rotation*(radius - mean radius)
+  Correction corr = {0.0, 0.0, 0, 0, 0.0};
+  const TH3F& h = *h_residual_[endcap][layer];
+  double sw = 0.0, swr = 0.0, swm = 0.0, swrr = 0.0, swrm = 0.0;
+  for (int roll=1; roll<=kNRolls; ++roll){
+    corr.entries += h_radius_[endcap][layer]->GetBinEntries(h_radius_[endcap][layer]->GetBin(chamber, roll));
+    double mean, error;
+    if (not rollMean(h, chamber, roll, window_, minEntries_, mean, error)) continue;
+    const double r = h_radius_[endcap][layer]->GetBinContent(chamber, roll);
+    const double w = error > 0 ? 1.0/(error*error) : 1.0;
+    sw += w;
+    swr += w*r;
+    swm += w*mean;
+    swrr += w*r*r;
+    swrm += w*r*mean;
+    corr.nRolls++;
+  }
+  if (corr.nRolls == 0) return corr;
+  corr.deltaX = swm/sw;
+  corr.rMean = swr/sw;
+  const double det = sw*swrr - swr*swr;
+  if (corr.nRolls >= 2 and det > 0)
+    corr.rotation = (sw*swrm - swr*swm)/det;
+  return corr;
+}
+
+void GEMAlignmentEstimator::write() const
+{
+  std::ofstream out(output_.c_str());
+  if (not out){
+    std::cout <<"GEMAlignmentEstimator: can't open "<< output_ << std::endl;
+    return;
+  }
+  out <<"## GE11 alignment from in-job residuals, prop - rechit local x\n";
+  out <<"## rechit local x is shifted by deltaX, rotation is the residual slope vs radius [rad]\n";
+  out <<"## endcap chamber layer deltaX[cm] rotation[rad] entries rolls\n";
+  for (int e=0; e<2; ++e)
+    for (int ch=1; ch<=kNChambers; ++ch)
+      for (int l=0; l<2; ++l){
+	const Correction corr = fit(e, l, ch);
+	if (corr.nRolls == 0) continue;
+	out <<"# "<< (e == 0 ? -1 : 1) <<" "<< ch <<" "<< l+1 <<" "<< corr.deltaX <<" "<< corr.rotation <<" "<< corr.entries <<" "<< corr.nRolls <<"\n";
+      }
+
+  //slice test chambers 27-30 of the minus endcap, index (chamber-27)*2 + layer-1
+  //GEM_alginment_deltaX has no rotation, the rotation is applied through the table below
+  out <<"import FWCore.ParameterSet.Config as cms\n";
+  std::string deltaX;
+  for (int ch=27; ch<=30; ++ch)
+    for (int l=0; l<2; ++l){
+      const Correction corr = fit(0, l, ch);
+      deltaX += (deltaX.empty() ? "" : ", ") + std::to_string(corr.deltaX);
+    }
+  out <<"GEM_alginment_deltaX = cms.vdouble("<< deltaX <<")\n";
+  std::cout <<"GEMAlignmentEstimator: alignment written to "<< output_ << std::endl;
+
+  if (tableOutput_.empty()) return;
+  std::ofstream table(tableOutput_.c_str());
+  table <<"# region chamber layer roll deltaX[cm] rotation[rad], see GEMAlignmentTable.h\n";
+  table <<"# rotation vs radius folded into the shift at the centre of each roll\n";
+  for (int e=0; e<2; ++e)
+    for (int ch=1; ch<=kNChambers; ++ch)
+      for (int l=0; l<2; ++l){
+	const Correction corr = fit(e, l, ch);
+	if (corr.nRolls == 0) continue;
+	for (int roll=1; roll<=kNRolls; ++roll){
+	  const double r = h_radius_[e][l]->GetBinContent(ch, roll);
+	  //rolls without hits keep the chamber shift
+	  const double shift = r > 0 ? corr.deltaX + corr.rotation*(r - corr.rMean) : corr.deltaX;
+	  table << (e == 0 ? -1 : 1) <<" "<< ch <<" "<< l+1 <<" "<< roll <<" "<< shift <<" 0\n";
+	}
+      }
+  std::cout <<"GEMAlignmentEstimator: alignment table written to "<< tableOutput_ << std::endl;
+}
@@ -0,0 +1,59 @@
+#ifndef GEMCSCBendingAnalyzer_MuonAnalyser_GEMAlignmentEstimator_h
+#define GEMCSCBendingAnalyzer_MuonAnalyser_GEMAlignmentEstimator_h
+
+// GE11 local x alignment from the standalone propagation residuals, accumulated in the job.
+// Residuals (prop - rechit, before alignment) go into fixed-bin histograms per endcap, layer,
+// chamber and roll, which can be merged across jobs with hadd (script/gemAlignmentFromHistograms.py).
+// At endJob each chamber/layer gets
+//   deltaX:   shift of the rechit local x, at the mean radius of the used rolls, cm
+//   rotation: slope of the roll residuals vs radius, rad
+// written as a config fragment in the format of GEM_alginment_deltaX (shift only, the fit results
+// as comments), and as a GEMAlignmentTable text file with the rotation folded into one shift per roll.
+
+#include <string>
+
+#include "FWCore/ParameterSet/interface/ParameterSet.h"
+
+#include "MuonData.h"
+#include "SliceTestSummary.h"
+
+#include "TH3F.h"
+#include "TProfile2D.h"
+
+class GEMAlignmentEstimator {
+public:
+  explicit GEMAlignmentEstimator(const edm::ParameterSet& iConfig);
+
+  void fill(const MuonData& data);
+  //fit all chambers and write the config fragment
+  void write() const;
+
+  struct Correction {
+    double deltaX;  //cm
+    double rotation;//rad
+    int entries;
+    int nRolls;//rolls used in the fit
+    double rMean;//cm, radius where deltaX applies
+  };
+  //robust mean of the residuals of one roll: mean within +-window around the mean of the full range, twice
+  static bool rollMean(const TH3F& h, int chamberBin, int rollBin, double window, int minEntries, double& mean, double& error);
+  Correction fit(int endcap, int layer, int chamber) const;
+
+  static const int kNChambers = SliceTestSummary::kNChambers;
+  static const int kNRolls = SliceTestSummary::kNRolls;
+
+private:
+  SummarySelection selection_;
+  double maxDphi_;//rad, rechit - propagation
+  int maxClusterSize_;
+  int minEntries_;//per roll
+  double window_; //cm
+  std::string output_;
+  std::string tableOutput_;//GEMAlignmentTable format, empty: not written
+
+  //[endcap][layer], endcap 0: minus, 1: plus
+  TH3F* h_residual_[2][2];//chamber x roll x residual
+  TProfile2D* h_radius_[2][2];//chamber x roll, radius of the roll middle
+};
+
+#endif
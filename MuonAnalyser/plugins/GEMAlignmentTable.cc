@@ -0,0 +1,28 @@
+#include "GEMAlignmentTable.h"
+
+#include "FWCore/Utilities/interface/Exception.h"
+
+#include <fstream>
+#include <iostream>
+
+void GEMAlignmentTable::load(const std::string& fileName)
+{
+  std::ifstream in(fileName.c_str());
+  if (not in)
+    throw cms::Exception("GEMAlignmentTable") <<"can't open alignment table "<< fileName;
+  int nentries = 0;
+  std::string error;
+  if (not table_.read(in, nentries, error))
+    throw cms::Exception("GEMAlignmentTable") << error <<" in "<< fileName;
+  std::cout <<"GEMAlignmentTable: "<< nentries <<" corrections from "<< fileName << std::endl;
+}
+
+void GEMAlignmentTable::setSliceTest(const std::vector<double>& deltaX)
+{
+  if (deltaX.size() != 8)//four GEM chambers, each 2 layers
+    throw cms::Exception("GEMAlignmentTable") <<"GEM_alginment_deltaX needs 8 values, got "<< deltaX.size();
+  //as before the table, the correction does not depend on the region
+  for (int region : {-1, 1})
+    for (size_t i=0; i<deltaX.size(); ++i)
+      set(region, 27 + i/2, i%2 + 1, 0, deltaX[i], 0.f);
+}
@@ -0,0 +1,34 @@
+#ifndef GEMCSCBendingAnalyzer_MuonAnalyser_GEMAlignmentTable_h
+#define GEMCSCBendingAnalyzer_MuonAnalyser_GEMAlignmentTable_h
+
+// GE11 rechit alignment corrections for every region, chamber, layer and eta partition,
+// looked up by GEMDetId. Table and text format in interface/GEMAlignmentTableCore.h:
+//   region chamber layer roll deltaX[cm] rotation[rad]
+// roll 0 sets all eta partitions of the chamber layer; later lines override earlier ones.
+
+#include <string>
+#include <vector>
+
+#include "DataFormats/MuonDetId/interface/GEMDetId.h"
+#include "GEMCSCBendingAnalyzer/MuonAnalyser/interface/GEMAlignmentTableCore.h"
+
+class GEMAlignmentTable {
+public:
+  typedef gemalignment::Entry Entry;
+
+  //roll 0 sets all rolls; returns false if out of range
+  bool set(int region, int chamber, int layer, int roll, float deltaX, float rotation) { return table_.set(region, chamber, layer, roll, deltaX, rotation); }
+  //the correction of a GE11 eta partition, zero if out of range
+  const Entry& get(const GEMDetId& id) const { return table_.get(id.region(), id.chamber(), id.layer(), id.roll()); }
+
+  //text table, throws cms::Exception if the file can't be read or a line can't be parsed
+  void load(const std::string& fileName);
+  //GEM_alginment_deltaX of the slice test, chambers 27-30 of both endcaps, (chamber-27)*2 + layer-1;
+  //throws cms::Exception unless there are 8 values
+  void setSliceTest(const std::vector<double>& deltaX);
+
+private:
+  gemalignment::Table table_;
+};
+
+#endif
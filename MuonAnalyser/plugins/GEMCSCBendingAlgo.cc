@@ -0,0 +1,1607 @@
+// system include files
+#include <assert.h> 
+#include <memory>
+#include <cmath>
+#include <iostream>
+#include <sstream>
+#include <chrono>
+#include <mutex>
+#include <algorithm>
+#include <unordered_map>
+#include <boost/foreach.hpp>
+#define foreach BOOST_FOREACH
+
+
+// user include files
+#include "GEMCSCBendingAlgo.h"
+
+#include "FWCore/Framework/interface/Frameworkfwd.h"
+
+#include "FWCore/Framework/interface/Event.h"
+#include "FWCore/Framework/interface/ESWatcher.h"
+
+#include "FWCore/ParameterSet/interface/ParameterSet.h"
+#include "FWCore/Utilities/interface/Exception.h"
+#include "FWCore/MessageLogger/interface/MessageLogger.h"
+#include "FWCore/ServiceRegistry/interface/Service.h"
+#include "CommonTools/UtilAlgos/interface/TFileService.h"
+
+//#include "RecoMuon/TrackingTools/interface/MuonSegmentMatcher.h"
+#include "RecoMuon/TrackingTools/interface/MuonServiceProxy.h"
+#include "TrackingTools/GeomPropagators/interface/Propagator.h"
+#include "TrackingTools/TrajectoryState/interface/TrajectoryStateTransform.h"
+#include "TrackPropagation/SteppingHelixPropagator/interface/SteppingHelixPropagator.h"
+#include "MagneticField/Engine/interface/MagneticField.h"
+#include "MagneticField/Records/interface/IdealMagneticFieldRecord.h"
+#include "TrackingTools/TrajectoryParametrization/interface/GlobalTrajectoryParameters.h"
+#include "TrackingTools/TrajectoryState/interface/TrajectoryStateOnSurface.h"
+#include "FastHelixPropagator.h"
+#include "GEMCSCBendingAnalyzer/MuonAnalyser/interface/MatchingCore.h"
+#include "GEMCSCBendingAnalyzer/MuonAnalyser/interface/AllocationCounter.h"
+
+#include "DataFormats/PatCandidates/interface/Muon.h"
+#include "DataFormats/DetId/interface/DetId.h"
+#include "DataFormats/TrackReco/interface/Track.h"
+
+#include "DataFormats/CSCRecHit/interface/CSCRecHit2D.h"
+#include "DataFormats/CSCRecHit/interface/CSCSegmentCollection.h"
+#include <DataFormats/CSCDigi/interface/CSCCorrelatedLCTDigiCollection.h>
+#include <DataFormats/CSCDigi/interface/CSCCorrelatedLCTDigi.h>
+#include "Geometry/CSCGeometry/interface/CSCGeometry.h"
+
+#include "DataFormats/GEMRecHit/interface/GEMRecHitCollection.h"
+#include "Geometry/GEMGeometry/interface/GEMGeometry.h"
+#include "Geometry/GEMGeometry/interface/GEMEtaPartitionSpecs.h"
+
+#include "Geometry/Records/interface/MuonGeometryRecord.h"
+#include "Geometry/CommonTopologies/interface/StripTopology.h"
+
+#include "DataFormats/Math/interface/deltaPhi.h"
+#include "FWCore/Framework/interface/ESHandle.h"
+
+#include "tbb/parallel_for.h"
+#include "tbb/parallel_invoke.h"
+
+#include "TH1D.h"
+#include "TH2D.h"
+#include "TString.h"
+#include "TGraphAsymmErrors.h"
+#include "TLorentzVector.h"
+
+using namespace std;
+using namespace edm;
+
+GEMCSCBendingAlgo::GEMCSCBendingAlgo(const edm::ParameterSet& iConfig, edm::ConsumesCollector&& iC)
+{
+  cscRecHits_ = iC.consumes<CSCRecHit2DCollection>(iConfig.getParameter<edm::InputTag>("cscRecHits"));
+  csclcts_ = iC.consumes<CSCCorrelatedLCTDigiCollection>(iConfig.getParameter<edm::InputTag>("csclcts"));
+  cscSegments_ = iC.consumes<CSCSegmentCollection>(iConfig.getParameter<edm::InputTag>("cscSegments"));
+  gemRecHits_ = iC.consumes<GEMRecHitCollection>(iConfig.getParameter<edm::InputTag>("gemRecHits"));
+  muonSummary_ = iC.consumes<edm::ValueMap<MuonSummary> >(iConfig.getParameter<edm::InputTag>("muonSummary"));
+  //standAloneMuons_ = consumes<reco::Track>(iConfig.getParameter<edm::InputTag>("standAloneMuons"));
+  edm::ParameterSet serviceParameters = iConfig.getParameter<edm::ParameterSet>("ServiceParameters");
+  GEMRechit_muon_deltaX_ =  iConfig.getUntrackedParameter<double>("GEMRechit_muon_deltaX", 10.0);
+  GEMRechit_muon_deltaR_ =  iConfig.getUntrackedParameter<double>("GEMRechit_muon_deltaR", 15.0);
+  CSCRechit_muon_deltaR_ =  iConfig.getUntrackedParameter<double>("CSCRechit_muon_deltaR", 8.0);
+  CSCSegment_muon_deltaR_ =  iConfig.getUntrackedParameter<double>("CSCSegment_muon_deltaR", 8.0);
+  CSCLCT_muon_deltaR_ =  iConfig.getUntrackedParameter<double>("CSCLCT_muon_deltaR", 8.0);
+  candidateWindow_ =  iConfig.getUntrackedParameter<double>("candidateWindow", 20.0);
+  minMuonEta_ =  iConfig.getUntrackedParameter<double>("minMuonEta", 1.4);
+  maxMuonEta_ =  iConfig.getUntrackedParameter<double>("maxMuonEta", 2.5);
+  matchMuonwithLCT_ =  iConfig.getUntrackedParameter<bool>("matchMuonwithLCT", false);
+  matchMuonwithCSCRechit_ =  iConfig.getUntrackedParameter<bool>("matchMuonwithCSCRechit", false);
+  applyGEMalignment_ =  iConfig.getUntrackedParameter<bool>("applyGEMalignment", false);
+  flippedGEMStrip_ =  iConfig.getUntrackedParameter<bool>("flippedGEMStrip", false);
+  useFastPropagator_ =  iConfig.getUntrackedParameter<bool>("useFastPropagator", false);
+  validateFastPropagator_ =  iConfig.getUntrackedParameter<bool>("validateFastPropagator", false);
+  fastPropagatorMinPt_ =  iConfig.getUntrackedParameter<double>("fastPropagatorMinPt", 20.0);
+  fastPropagatorMaxDistance_ =  iConfig.getUntrackedParameter<double>("fastPropagatorMaxDistance", 100.0);
+  concurrentPropagation_ =  iConfig.getUntrackedParameter<bool>("concurrentPropagation", false);
+  standalonePropagator_ =  iConfig.getUntrackedParameter<std::string>("standalonePropagator", "SteppingHelixPropagatorAny");
+  globalPropagator_ =  iConfig.getUntrackedParameter<std::string>("globalPropagator", "SteppingHelixPropagatorAny");
+  innerPropagator_ =  iConfig.getUntrackedParameter<std::string>("innerPropagator", "SteppingHelixPropagatorAny");
+  theService_ = new MuonServiceProxy(serviceParameters);
+  const std::string geometryCache = iConfig.getUntrackedParameter<std::string>("geometryCache", "");
+  if (not geometryCache.empty()){
+      if (not geometryCache_.open(geometryCache))
+	  throw cms::Exception("GEMCSCBendingAlgo") << geometryCache_.error();
+      useGeometryCache_ = true;
+  }
+
+  //full detector table if given, slice test chambers from GEM_alginment_deltaX otherwise
+  const std::string alignmentTable = iConfig.getUntrackedParameter<std::string>("GEMAlignmentTable", "");
+  if (not alignmentTable.empty())
+      alignment_.load(alignmentTable);
+  else
+      alignment_.setSliceTest(iConfig.getParameter<std::vector<double>>("GEM_alginment_deltaX"));//cm
+  //std::cout<<"error in GEM_alginment_deltaX_, size "<< GEM_alginment_deltaX_.size() << std::endl;
+  //further alignment/strip ordering hypotheses, each with a table, the slice test deltaX or no correction
+  const std::vector<edm::ParameterSet> hypotheses = iConfig.getUntrackedParameter<std::vector<edm::ParameterSet>>("alignmentHypotheses", std::vector<edm::ParameterSet>());
+  for (const auto& hypothesis : hypotheses){
+      if (hypotheses_.size() == size_t(MuonData::kMaxHypotheses)){
+	  edm::LogWarning("GEMCSCBendingAlgo") <<"only the first "<< MuonData::kMaxHypotheses <<" alignment hypotheses are evaluated";
+	  break;
+      }
+      hypotheses_.emplace_back();
+      AlignmentHypothesis& h = hypotheses_.back();
+      h.name = hypothesis.getParameter<std::string>("name");
+      h.flipped = hypothesis.getParameter<bool>("flippedGEMStrip");
+      if (hypothesis.exists("GEMAlignmentTable"))
+	  h.alignment.load(hypothesis.getParameter<std::string>("GEMAlignmentTable"));
+      else if (hypothesis.exists("GEM_alginment_deltaX"))
+	  h.alignment.setSliceTest(hypothesis.getParameter<std::vector<double>>("GEM_alginment_deltaX"));
+  }
+  //edm::ParameterSet matchParameters = iConfig.getParameter<edm::ParameterSet>("MatchParameters");
+  //edm::ConsumesCollector iC  = consumesCollector();
+  //theMatcher = new MuonSegmentMatcher(matchParameters, iC);
+
+  if (validateFastPropagator_){
+    edm::Service<TFileService> fs;
+    const char* stations[2] = {"GE11", "ME11"};
+    for (int i=0; i<2; ++i){
+      h_fastProp_dx_[i] = fs->make<TH1D>(Form("fastProp_dx_%s", stations[i]), Form("fast - stepping propagator, %s", stations[i]), 200, -0.5, 0.5);
+      h_fastProp_dx_[i]->GetXaxis()->SetTitle("local #Deltax [cm]");
+      h_fastProp_dy_[i] = fs->make<TH1D>(Form("fastProp_dy_%s", stations[i]), Form("fast - stepping propagator, %s", stations[i]), 200, -0.5, 0.5);
+      h_fastProp_dy_[i]->GetXaxis()->SetTitle("local #Deltay [cm]");
+    }
+  }
+}
+
+GEMCSCBendingAlgo::~GEMCSCBendingAlgo()
+{
+  delete theService_;
+}
+
+std::vector<std::string>
+GEMCSCBendingAlgo::hypothesisNames() const
+{
+  std::vector<std::string> names;
+  for (const auto& h : hypotheses_)
+      names.push_back(h.name);
+  return names;
+}
+
+void
+GEMCSCBendingAlgo::run(const edm::Event& iEvent, const edm::EventSetup& iSetup, const edm::View<reco::Muon>& muons,
+		       std::vector<size_t>& selected, std::vector<MuonData>& muonData, std::vector<MuonCandidates>* candidates,
+		       EventStats* stats)
+{
+  const allocationcounter::Counts allocStart = allocationcounter::now();
+  auto stageStart = std::chrono::steady_clock::now();
+  //us since the previous call
+  auto stageTime = [&stageStart](){
+      const auto now = std::chrono::steady_clock::now();
+      const float t = std::chrono::duration<float, std::micro>(now - stageStart).count();
+      stageStart = now;
+      return t;
+  };
+
+  iSetup.get<MuonGeometryRecord>().get(GEMGeometry_);
+
+  iSetup.get<MuonGeometryRecord>().get(CSCGeometry_);
+  if (useGeometryCache_ and iSetup.get<MuonGeometryRecord>().cacheIdentifier() != geometryCacheCheckId_){
+      checkGeometryCache();
+      geometryCacheCheckId_ = iSetup.get<MuonGeometryRecord>().cacheIdentifier();
+  }
+
+  // iSetup.get<TrackingComponentsRecord>().get("SteppingHelixPropagatorAny",propagator_);
+  // iSetup.get<IdealMagneticFieldRecord>().get(bField_);
+  theService_->update(iSetup);
+  auto propagator = theService_->propagator(standalonePropagator_);
+  auto propagator_gt = theService_->propagator(globalPropagator_);
+  auto propagator_inner = theService_->propagator(innerPropagator_);
+  //keyed on the GEM/CSC geometry and evaluated with the field, both watchers are checked every event
+  const bool fieldChanged = surfaceFieldWatcher_.check(iSetup);
+  const bool geometryChanged = surfaceGeometryWatcher_.check(iSetup);
+  if ((useFastPropagator_ or validateFastPropagator_) and (fieldChanged or geometryChanged))
+      fillSurfaceFieldCache();
+  if (stats) stats->t_setup = stageTime();
+  
+
+  edm::Handle<GEMRecHitCollection> gemRecHits;
+  iEvent.getByToken(gemRecHits_, gemRecHits);
+
+  //if (gemRecHits->size() == 0) return;
+      
+
+  bool hasCSCRechitcollection = false;
+  edm::Handle<CSCRecHit2DCollection> cscRecHits;
+  if (matchMuonwithCSCRechit_){
+      try{
+          iEvent.getByToken(cscRecHits_, cscRecHits);
+          hasCSCRechitcollection = true;
+      }catch (const cms::Exception&){
+        edm::LogError("GEMCSCBendingAlgo") << "can't get CSC rechits by label";
+        hasCSCRechitcollection = false;
+      }
+  }
+   
+
+  edm::Handle<CSCSegmentCollection> cscSegments;
+  iEvent.getByToken(cscSegments_, cscSegments);
+
+
+  bool hasLCTcollection = false;
+  edm::Handle<CSCCorrelatedLCTDigiCollection> cscLcts;
+  if (matchMuonwithLCT_){
+      try{
+        iEvent.getByToken(csclcts_, cscLcts);
+        hasLCTcollection = true;
+      }catch (const cms::Exception&){
+        edm::LogError("GEMCSCBendingAlgo") << "can't get LCTs by label";
+        hasLCTcollection = false;
+      }
+  }
+   
+  
+
+  //IDs, isolation and impact parameters at the best vertex, computed once by the MuonAnalyser producer
+  edm::Handle<edm::ValueMap<MuonSummary> > muonSummaries;
+  iEvent.getByToken(muonSummary_, muonSummaries);
+  if (not muonSummaries.isValid())
+      throw cms::Exception("GEMCSCBendingAlgo") <<"no muon summary: schedule the muonSummary producer (python/muonSummary_cfi.py) before this module";
+
+ // std::cout << "muons->size() " << muons->size() <<std::endl;
+  //cout<<"\nlumi="<<data_.lumi<<"\t run="<<data_.run<<"\t event"<<data_.run << endl; //edited by mohit
+
+  //edm::Handle<reco::Track> standAloneMuons;
+  //iEvent.getByToken( standAloneMuons_, standAloneMuons );
+  //std::cout <<"standalone muons "<< standAloneMuons->size() << std::endl;
+  //bool printAngle = true;
+  
+
+  //indices are emptied, not freed, their buckets and hit arrays are reused by the next event
+  EventScratch& scratch = scratch_;
+  hitindex::clearAll(scratch.gemHits);
+  hitindex::clearAll(scratch.gemHitsOtherFlip);
+  hitindex::clearAll(scratch.cscHits);
+  buildGEMHitIndex(*gemRecHits, scratch.gemHits, flippedGEMStrip_);
+  if (std::any_of(hypotheses_.begin(), hypotheses_.end(), [this](const AlignmentHypothesis& h){ return h.flipped != flippedGEMStrip_; }))
+      buildGEMHitIndex(*gemRecHits, scratch.gemHitsOtherFlip, not flippedGEMStrip_);
+  if (matchMuonwithCSCRechit_ and hasCSCRechitcollection)
+      buildCSCHitIndex(*cscRecHits, scratch.cscHits);
+
+  const EventInputs inputs = {gemRecHits, cscRecHits, cscSegments, cscLcts, hasCSCRechitcollection, hasLCTcollection, &scratch.gemHits, &scratch.cscHits, &scratch.gemHitsOtherFlip};
+  const TrackPropagators propagators = {&*propagator, &*propagator_gt, &*propagator_inner};
+  //new propagators from the event setup, the per thread copies are cloned again
+  if (propagators.sta != lastPropagators_.sta or propagators.gt != lastPropagators_.gt or propagators.inner != lastPropagators_.inner
+      or theService_->isTrackingComponentsRecordChanged()){
+      lastPropagators_ = propagators;
+      propagatorGeneration_++;
+  }
+  if (stats) stats->t_inputs = stageTime();
+
+  selected.clear();
+  std::vector<const reco::Muon*>& selectedMuons = scratch.selectedMuons;
+  std::vector<const MuonSummary*>& selectedSummaries = scratch.selectedSummaries;
+  selectedMuons.clear();
+  selectedSummaries.clear();
+  for (size_t i = 0; i < muons.size(); ++i) {
+    const reco::Muon* mu = &muons[i];
+    const reco::Track* muonTrack = 0;
+    if ( mu->globalTrack().isNonnull() ) muonTrack = mu->globalTrack().get();
+    else if ( mu->outerTrack().isNonnull()  ) muonTrack = mu->outerTrack().get();
+    else 
+	continue;
+
+    if (mu->pt() < 2.0) continue;//ignore low pt muon
+    if (mu->isGEMMuon()) {
+      LogDebug("GEMCSCBendingAlgo") << "isGEMMuon";
+    }
+
+    if (not mu->standAloneMuon()) continue;//not standalone muon
+    if (not mu->innerTrack()) continue;
+
+    //focus on endcap muons
+    //GEMs are installed on minus endcap, namly eta < 0
+    //if (muonTrack and mu->numberOfChambersCSCorDT() >= 2 and fabs(mu->eta()) > minMuonEta_ and fabs(mu->eta()) < maxMuonEta_) {
+    if (muonTrack and fabs(mu->eta()) > minMuonEta_ and fabs(mu->eta()) < maxMuonEta_){
+	selectedMuons.push_back(mu);
+	selectedSummaries.push_back(&(*muonSummaries)[muons.ptrAt(i)]);
+	selected.push_back(i);
+    }
+  }
+
+  //muons are independent, fill them concurrently
+  muonData.assign(selectedMuons.size(), MuonData());
+  if (candidates) candidates->resize(selectedMuons.size());
+  if (concurrentPropagation_ and selectedMuons.size() > 1)
+      tbb::parallel_for(size_t(0), selectedMuons.size(), [&](size_t i){
+	  fillMuonData(muonData[i], (candidates ? &(*candidates)[i] : nullptr), iEvent, selectedMuons[i], *selectedSummaries[i], inputs, propagators);
+      });
+  else
+      for (size_t i = 0; i < selectedMuons.size(); ++i)
+	  fillMuonData(muonData[i], (candidates ? &(*candidates)[i] : nullptr), iEvent, selectedMuons[i], *selectedSummaries[i], inputs, propagators);
+
+  if (candidates)
+      for (size_t i = 0; i < selected.size(); ++i)
+	  (*candidates)[i].muonIndex = selected[i];
+
+  for (const auto& data : muonData){
+      totalPropTime_ += data.prop_time;
+      nPropMuons_++;
+  }
+  const allocationcounter::Counts allocEnd = allocationcounter::now();
+  nEvents_++;
+  totalAllocations_ += allocEnd.n - allocStart.n;
+  totalAllocatedBytes_ += allocEnd.bytes - allocStart.bytes;
+
+  if (stats){
+      stats->t_muons = stageTime();
+      stats->t_propagation = 0.0;
+      for (const auto& data : muonData)
+	  stats->t_propagation += data.prop_time;
+      stats->nMuons = muons.size();
+      stats->nSelectedMuons = selected.size();
+      stats->nGEMRecHits = gemRecHits.isValid() ? int(gemRecHits->size()) : -1;
+      stats->nCSCRecHits = (hasCSCRechitcollection and cscRecHits.isValid()) ? int(cscRecHits->size()) : -1;
+      stats->nCSCSegments = cscSegments.isValid() ? int(cscSegments->size()) : -1;
+      stats->nAllocations = allocationcounter::available() ? (long long)(allocEnd.n - allocStart.n) : -1;
+      stats->allocatedBytes = allocationcounter::available() ? (long long)(allocEnd.bytes - allocStart.bytes) : -1;
+      stats->nLCTs = -1;
+      if (hasLCTcollection and cscLcts.isValid()){
+	  stats->nLCTs = 0;
+	  for (CSCCorrelatedLCTDigiCollection::DigiRangeIterator detUnit = cscLcts->begin(); detUnit != cscLcts->end(); detUnit++)
+	      stats->nLCTs += (*detUnit).second.second - (*detUnit).second.first;
+      }
+  }
+}
+
+void
+GEMCSCBendingAlgo::fillMuonData(MuonData& data, MuonCandidates* candidates, const edm::Event& iEvent, const reco::Muon* mu, const MuonSummary& summary, const EventInputs& inputs, const TrackPropagators& propagators)
+{
+      const reco::Track* muonTrack = mu->globalTrack().isNonnull() ? mu->globalTrack().get() : mu->outerTrack().get();
+      const reco::Track* standaloneMuon =  mu->standAloneMuon().get();
+      const reco::Track* innerTrack = mu->track().get();
+
+      data.init();
+      if (inputs.gemRecHits->size() > 0)
+	  data.hasGEMdata  = true;
+      
+      data.lumi = iEvent.id().luminosityBlock();
+      data.run = iEvent.id().run();
+      data.event = iEvent.id().event();
+      data.setSummary(summary);
+
+      if (candidates){
+	  candidates->init();
+	  candidates->run = data.run;
+	  candidates->lumi = data.lumi;
+	  candidates->event = data.event;
+	  candidates->muonpt = data.muonpt;
+	  candidates->muoneta = data.muoneta;
+	  candidates->muonphi = data.muonphi;
+	  candidates->muoncharge = data.muoncharge;
+	  candidates->has_TightID = data.has_TightID;
+	  candidates->window = candidateWindow_;
+      }
+
+      LogDebug("GEMCSCBendingAlgo") <<"muon pt "<< mu->pt() <<" eta "<< mu->eta() <<" phi "<< mu->phi() <<" charge "<< mu->charge();
+
+      
+      /**** trigger and reco muon match ****/
+      /**** end of trigger and reco muon match ****/
+
+
+
+
+      //starting states, shared by the GE11 and CSC blocks
+      //taken from the track extras as reco::TransientTrack::inner/outermostMeasurementState do,
+      //without building the transient tracks
+      const GlobalTrackingGeometry& trackingGeometry = *theService_->trackingGeometry();
+      const MagneticField* field = &*theService_->magneticField();
+      MuonStates states;
+      states.mu = mu;
+      states.muonTrack = muonTrack;
+      states.sta = trajectoryStateTransform::innerStateOnSurface(*standaloneMuon, trackingGeometry, field);
+      states.gt = trajectoryStateTransform::outerStateOnSurface(*muonTrack, trackingGeometry, field);
+      states.inner = trajectoryStateTransform::outerStateOnSurface(*innerTrack, trackingGeometry, field);
+
+      //GE11 and CSC blocks write disjoint parts of MuonData, GE11-ME11 bending is combined once both are done
+      float propTime_GE11 = 0.0;
+      float propTime_CSC = 0.0;
+      if (concurrentPropagation_){
+	  tbb::parallel_invoke(
+	      [&]{ propagateToGE11(data, candidates, states, inputs, threadPropagators(propagators), propTime_GE11); },
+	      [&]{ propagateToCSC(data, candidates, states, inputs, threadPropagators(propagators), propTime_CSC); });
+      }else{
+	  propagateToGE11(data, candidates, states, inputs, propagators, propTime_GE11);
+	  propagateToCSC(data, candidates, states, inputs, propagators, propTime_CSC);
+      }
+      data.prop_time = propTime_GE11 + propTime_CSC;
+      fillGE11ME11Bending(data);
+
+
+      /**** check gem reco hit used to build muon track and then propagate the track to nearby****/
+      /*
+      if (muonTrack->hitPattern().numberOfValidMuonGEMHits()) {
+        std::cout << "numberOfValidMuonGEMHits->size() " << muonTrack->hitPattern().numberOfValidMuonGEMHits()
+                  << " recHitsSize " << muonTrack->recHitsSize()
+                  << " pt " << muonTrack->pt()
+                  <<std::endl;
+        for (auto hit = muonTrack->recHitsBegin(); hit != muonTrack->recHitsEnd(); hit++) {
+          if ( (*hit)->geographicalId().det() == DetId::Detector::Muon && (*hit)->geographicalId().subdetId() ==  MuonSubdetId::GEM) {
+            //if ((*hit)->rawId() == ch->id().rawId() ) {
+            GEMDetId gemid((*hit)->geographicalId());
+            const auto& etaPart = GEMGeometry_->etaPartition(gemid);
+            TrajectoryStateOnSurface tsos = propagator->propagate(ttTrack.outermostMeasurementState(),etaPart->surface());
+            if (!tsos.isValid()) continue;
+            GlobalPoint tsosGP = tsos.globalPosition();
+            LocalPoint && tsos_localpos = tsos.localPosition();
+            LocalError && tsos_localerr = tsos.localError().positionError();
+            LocalPoint && dethit_localpos = (*hit)->localPosition();
+            LocalError && dethit_localerr = (*hit)->localPositionError();
+            auto res_x = (dethit_localpos.x() - tsos_localpos.x());
+            auto res_y = (dethit_localpos.y() - tsos_localpos.y());
+            auto pull_x = (dethit_localpos.x() - tsos_localpos.x()) /
+              std::sqrt(dethit_localerr.xx() + tsos_localerr.xx());
+            auto pull_y = (dethit_localpos.y() - tsos_localpos.y()) /
+              std::sqrt(dethit_localerr.yy() + tsos_localerr.yy());
+            cout << "gem hit "<< gemid<< endl;
+            cout << " gp " << etaPart->toGlobal((*hit)->localPosition())<< endl;
+            cout << " tsosGP "<< tsosGP << endl;
+            cout << " res_x " << res_x
+                 << " res_y " << res_y
+                 << " pull_x " << pull_x
+                 << " pull_y " << pull_y
+                 << endl;
+          }
+        }
+      }*/
+      /**** end of checking gem reco hit used to build muon track and then propagating the track to nearby****/
+     //std::cout << "end of checking gem reco hit used to build muon track and then propagating the track to nearby "<< std::endl;
+
+
+
+      /**** check csc reco hit used to build muon track and then propagate the track to nearby****/
+     /*
+      if (muonTrack->hitPattern().numberOfValidMuonCSCHits()) {
+        std::cout << "numberOfValidMuonCSCHits->size() " << muonTrack->hitPattern().numberOfValidMuonCSCHits()
+                  << " recHitsSize " << muonTrack->recHitsSize()
+                  << " pt " << muonTrack->pt()
+                  <<std::endl;
+        for (auto hit = muonTrack->recHitsBegin(); hit != muonTrack->recHitsEnd(); hit++) {
+          if ( (*hit)->geographicalId().det() == DetId::Detector::Muon && (*hit)->geographicalId().subdetId() == MuonSubdetId::CSC) {
+	    std::cout <<" hit detid "<< (*hit)->rawId() << std::endl;
+	     
+            //if ((*hit)->rawId() == ch->id().rawId() ) {
+            CSCDetId cscid((*hit)->geographicalId());
+	    std::cout <<"csc rect hit in det id "<< cscid <<" hit "<<  (*hit)->localPosition() << std::endl;
+            const auto& layer = CSCGeometry_->layer(cscid);
+            TrajectoryStateOnSurface tsos = propagator->propagate(ttTrack.outermostMeasurementState(),ch->surface());
+            if (!tsos.isValid()) continue;
+            GlobalPoint tsosGP = tsos.globalPosition();
+            LocalPoint && tsos_localpos = tsos.localPosition();
+            LocalError && tsos_localerr = tsos.localError().positionError();
+            LocalPoint && dethit_localpos = (*hit)->localPosition();
+            LocalError && dethit_localerr = (*hit)->localPositionError();
+            auto res_x = (dethit_localpos.x() - tsos_localpos.x());
+            auto res_y = (dethit_localpos.y() - tsos_localpos.y());
+            auto pull_x = (dethit_localpos.x() - tsos_localpos.x()) /
+              std::sqrt(dethit_localerr.xx() + tsos_localerr.xx());
+            auto pull_y = (dethit_localpos.y() - tsos_localpos.y()) /
+              std::sqrt(dethit_localerr.yy() + tsos_localerr.yy());
+            cout << "csc hit "<< cscid<< endl;
+            cout << " gp " << ch->toGlobal((*hit)->localPosition())<< endl;
+            cout << " tsosGP "<< tsosGP << endl;
+            cout << " res_x " << res_x
+                 << " res_y " << res_y
+                 << " pull_x " << pull_x
+                 << " pull_y " << pull_y
+                 << endl;
+          }
+        }
+      }*/
+      /**** end of checking csc reco hit used to build muon track and then propagating the track to nearby****/
+      //std::cout  <<" end of checking csc reco hit used to build muon track and then propagating the track to nearby "<< std::endl;
+}
+
+//a thread runs one propagation block at a time (it only picks other tasks once its own block is done),
+//so its copies are never used by two blocks at once
+GEMCSCBendingAlgo::TrackPropagators
+GEMCSCBendingAlgo::threadPropagators(const TrackPropagators& propagators)
+{
+  ThreadPropagators& local = threadPropagators_.local();
+  if (local.generation != propagatorGeneration_){
+      local.sta.reset(propagators.sta->clone());
+      local.gt.reset(propagators.gt->clone());
+      local.inner.reset(propagators.inner->clone());
+      local.generation = propagatorGeneration_;
+  }
+  return {local.sta.get(), local.gt.get(), local.inner.get()};
+}
+
+void
+GEMCSCBendingAlgo::propagateToGE11(MuonData& data, MuonCandidates* candidates, const MuonStates& states, const EventInputs& inputs, const TrackPropagators& propagators, float& propTime)
+{
+      const Propagator* const trackPropagators[3] = {propagators.sta, propagators.gt, propagators.inner};
+      const TrajectoryStateOnSurface trackStates[3] = {states.sta, states.gt, states.inner};
+      /**** propagating track to GEM station and then associating gem reco hit to track ****/
+      data.nHypotheses = hypotheses_.size();
+      for (const auto& ch : GEMGeometry_->etaPartitions()) {
+	  //only GE1/1 !!!
+	 if (ch->id().station() != 1) continue;
+        //if ( !detLists.insert( ch->surface().position().z() ).second ) continue;
+
+        TrajectoryStateOnSurface tsosAll[3];
+        propagateToSurface(trackPropagators, trackStates, tsosAll, 3, *ch, 0, propTime);
+        const TrajectoryStateOnSurface& tsos = tsosAll[0];
+        const TrajectoryStateOnSurface& tsos_gt = tsosAll[1];
+        const TrajectoryStateOnSurface& tsos_inner = tsosAll[2];
+
+        if (!tsos.isValid()) continue;
+        if (!tsos_gt.isValid()) continue;
+        if (!tsos_inner.isValid()) continue;
+
+        GlobalPoint tsosGP = tsos.globalPosition();
+        GlobalPoint tsosGP_gt = tsos_gt.globalPosition();
+        GlobalPoint tsosGP_inner = tsos_inner.globalPosition();
+	if (tsosGP.eta() * states.mu->eta() < 0.0) continue;
+
+        const LocalPoint pos = ch->toLocal(tsosGP);
+        const LocalPoint pos_gt = ch->toLocal(tsosGP_gt);
+        const LocalPoint pos_inner = ch->toLocal(tsosGP_inner);
+        const LocalPoint pos2D(pos.x(), pos.y(), 0);
+	const LocalPoint pos2D_gt(pos_gt.x(), pos_gt.y(), 0); 
+	const LocalPoint pos2D_inner(pos_inner.x(), pos_inner.y(), 0); 
+        const BoundPlane& bps(ch->surface());
+        //cout << "transientTrack using standalone muon tsos gp   "<< tsosGP << ch->id() <<" tttrack.innermost Z position "<< ttTrack.innermostMeasurementState().globalPosition().z() <<" outermost Z position "<< ttTrack.outermostMeasurementState().globalPosition().z() <<endl;
+	//cout <<"transientTrack using global track inner "<< ttTrack_gt.innermostMeasurementState().globalPosition().z() <<" outermost Z position "<< ttTrack_gt.outermostMeasurementState().globalPosition().z() <<endl;
+        //cout << "transientTrack using innertrack tsos gp   "<< tsosGP_inner << ch->id() <<" tttrack.innermost Z position "<< ttTrack_inner.innermostMeasurementState().globalPosition().z() <<" outermost Z position "<< ttTrack_inner.outermostMeasurementState().globalPosition().z() <<endl;
+
+        if (bps.bounds().inside(pos2D) and ch->id().station() == 1 and ch->id().ring() == 1) {
+	  //if (ch->id().station() == 1 and ch->id().ring() == 1 )
+	  //    cout << "projection to GEM, in chamber "<< ch->id() << " pos = "<<pos<< " R = "<<pos.mag() <<" inside "
+          //     <<  bps.bounds().inside(pos2D) <<endl;
+	  //if (ch->id().station() == 1 and ch->id().ring() == 1 ) 
+		//cout <<"chamber id " << ch->id() << " propagation using standalone muon  tsos gp   "<< tsosGP <<" using globaltrack "<< tsosGP_gt <<" using innerTrack "<< tsosGP_inner << endl;
+	    data.has_propGE11[ch->id().layer()-1]= true;
+	    data.roll_propGE11[ch->id().layer()-1] = ch->id().roll();
+	    data.chamber_propGE11[ch->id().layer()-1] = ch->id().chamber();
+	    data.prop_phi_GE11[ch->id().layer()-1] = tsosGP.phi();
+	    data.prop_eta_GE11[ch->id().layer()-1] = tsosGP.eta();
+	    data.prop_x_GE11[ch->id().layer()-1]   = tsosGP.x();
+	    data.prop_y_GE11[ch->id().layer()-1]   = tsosGP.y();
+	    data.prop_r_GE11[ch->id().layer()-1]   = tsosGP.mag();
+	    data.prop_perp_GE11[ch->id().layer()-1]   = tsosGP.perp();
+	    data.prop_localx_GE11[ch->id().layer()-1] = pos.x();
+	    data.prop_localy_GE11[ch->id().layer()-1] = pos.y();
+
+            LocalPoint temp(tsosGP.x(), tsosGP.y(), 0);
+            LocalPoint local_coords(pos.x(), temp.mag()); // This is technically an approximation, but close enough
+	    float local_phi_rad = (3.14159265/2.) - local_coords.phi();
+	    float local_phi_deg = 180*(local_phi_rad)/3.14159265;
+            data.prop_localphi_rad_GE11[ch->id().layer()-1] = local_phi_rad;
+            data.prop_localphi_deg_GE11[ch->id().layer()-1] = local_phi_deg;
+
+	    data.propgt_phi_GE11[ch->id().layer()-1] = tsosGP_gt.phi();
+	    data.propgt_eta_GE11[ch->id().layer()-1] = tsosGP_gt.eta();
+	    data.propgt_x_GE11[ch->id().layer()-1]   = tsosGP_gt.x();
+	    data.propgt_y_GE11[ch->id().layer()-1]   = tsosGP_gt.y();
+	    data.propgt_r_GE11[ch->id().layer()-1]   = tsosGP_gt.mag();
+	    data.propgt_perp_GE11[ch->id().layer()-1]   = tsosGP_gt.perp();
+	    data.propgt_localx_GE11[ch->id().layer()-1] = pos_gt.x();
+	    data.propgt_localy_GE11[ch->id().layer()-1] = pos_gt.y();
+            LocalPoint temp_gt(tsosGP_gt.x(), tsosGP_gt.y(), 0);
+            LocalPoint local_coords_gt(pos_gt.x(), temp_gt.mag()); // This is technically an approximation, but close enough
+	    float local_phi_rad_gt = (3.14159265/2.) - local_coords_gt.phi();
+	    float local_phi_deg_gt = 180*(local_phi_rad_gt)/3.14159265;
+	    data.propgt_localphi_rad_GE11[ch->id().layer()-1] = local_phi_rad_gt;
+            data.propgt_localphi_deg_GE11[ch->id().layer()-1] = local_phi_deg_gt;
+
+	    data.propinner_phi_GE11[ch->id().layer()-1] = tsosGP_inner.phi();
+	    data.propinner_eta_GE11[ch->id().layer()-1] = tsosGP_inner.eta();
+	    data.propinner_x_GE11[ch->id().layer()-1]   = tsosGP_inner.x();
+	    data.propinner_y_GE11[ch->id().layer()-1]   = tsosGP_inner.y();
+	    data.propinner_r_GE11[ch->id().layer()-1]   = tsosGP_inner.mag();
+	    data.propinner_perp_GE11[ch->id().layer()-1]   = tsosGP_inner.perp();
+	    data.propinner_localx_GE11[ch->id().layer()-1] = pos_inner.x();
+	    data.propinner_localy_GE11[ch->id().layer()-1] = pos_inner.y();
+            LocalPoint temp_inner(tsosGP_inner.x(), tsosGP_inner.y(), 0);
+            LocalPoint local_coords_inner(pos_inner.x(), temp_inner.mag()); // This is technically an approximation, but close enough
+	    float local_phi_rad_inner = (3.14159265/2.) - local_coords_inner.phi();
+	    float local_phi_deg_inner = 180*(local_phi_rad_inner)/3.14159265;
+            data.propinner_localphi_rad_GE11[ch->id().layer()-1] = local_phi_rad_inner;
+	    data.propinner_localphi_deg_GE11[ch->id().layer()-1] = local_phi_deg_inner;
+
+
+
+	    const auto& etaPart_ch = GEMGeometry_->etaPartition(ch->id());
+	    LocalPoint lp_middle = etaPart_ch->centreOfStrip(etaPart_ch->nstrips()/2);
+	    float strip = etaPart_ch->strip(pos);
+
+
+	    //Appling fidcut
+	    const float fidcut_angle = 1;
+	    const float cut_ang = 5 - fidcut_angle;
+	    const float fidcut_y = 5;
+	    const float cut_even_high = 250 - fidcut_y;
+	    const float cut_odd_high = 235 - fidcut_y;
+	    const float cut_low = 130 + fidcut_y;
+	    if(ch->id().chamber()%2 == 0){ //even
+	      if( fabs(local_phi_deg) < cut_ang && pos.y() + etaPart_ch->toGlobal(lp_middle).perp() > cut_low && pos.y() + etaPart_ch->toGlobal(lp_middle).perp() < cut_even_high){
+	        data.prop_has_fidcut_GE11[ch->id().layer()-1] = 1;}
+              if( fabs(local_phi_deg_gt) < cut_ang && pos_gt.y() + etaPart_ch->toGlobal(lp_middle).perp() > cut_low && pos_gt.y() + etaPart_ch->toGlobal(lp_middle).perp() < cut_even_high){
+	        data.gt_has_fidcut_GE11[ch->id().layer()-1] = 1;}
+              if( fabs(local_phi_deg_inner) < cut_ang && pos_inner.y() + etaPart_ch->toGlobal(lp_middle).perp() > cut_low && pos_inner.y() + etaPart_ch->toGlobal(lp_middle).perp() < cut_even_high){
+	        data.inner_has_fidcut_GE11[ch->id().layer()-1] = 1;}
+	    }
+
+            if(ch->id().chamber()%2 == 1){ //odd
+              if( fabs(local_phi_deg) < cut_ang && pos.y() + etaPart_ch->toGlobal(lp_middle).perp() > cut_low && pos.y() + etaPart_ch->toGlobal(lp_middle).perp() < cut_odd_high){
+                data.prop_has_fidcut_GE11[ch->id().layer()-1] = 1;}
+              if( fabs(local_phi_deg_gt) < cut_ang && pos_gt.y() + etaPart_ch->toGlobal(lp_middle).perp() > cut_low && pos_gt.y() + etaPart_ch->toGlobal(lp_middle).perp() < cut_odd_high){
+                data.gt_has_fidcut_GE11[ch->id().layer()-1] = 1;}
+              if( fabs(local_phi_deg_inner) < cut_ang && pos_inner.y() + etaPart_ch->toGlobal(lp_middle).perp() > cut_low && pos_inner.y() + etaPart_ch->toGlobal(lp_middle).perp() < cut_odd_high){
+                data.inner_has_fidcut_GE11[ch->id().layer()-1] = 1;}
+            }
+
+
+	    //const auto& etaPart_ch = GEMGeometry_->etaPartition(ch->id());
+	    //LocalPoint lp_middle = etaPart_ch->centreOfStrip(etaPart_ch->nstrips()/2);
+	    //float strip = etaPart_ch->strip(pos);
+	    //if (printAngle){
+	    //    cout <<"GEM id "<< ch->id() << endl;
+	    //    for (int s = 1; s <= etaPart_ch->specificTopology().nstrips(); s++)
+	    //         cout << "strip "<< s <<" localpoint "<< etaPart_ch->centreOfStrip(s) <<" stripangle "<<etaPart_ch->specificTopology().stripAngle(s-0.5) <<" pitch "<< etaPart_ch->specificTopology().pitch() <<" localPitch "<< etaPart_ch->localPitch(etaPart->centreOfStrip(s)) << endl;
+	    //    printAngle = false;
+	    //}
+
+
+
+
+
+
+
+	    strip = getCenterStripNumber_float(strip);
+	    LocalPoint lp_center = etaPart_ch->centreOfStrip(strip);
+	    //std::cout <<"prop muon lp "<< pos <<" center of strip lp "<< lp_center <<" strip "<< strip <<std::endl;
+	    data.prop_localx_center_GE11[ch->id().layer()-1] = lp_center.x();
+	    data.prop_strip_GE11[ch->id().layer()-1] = strip;
+	    data.middle_perp_propGE11[ch->id().layer()-1] = etaPart_ch->toGlobal(lp_middle).perp();//middle in the roll of prop
+
+	    if (bps.bounds().inside(pos2D_gt)){
+		float strip_gt = etaPart_ch->strip(pos_gt);
+		strip_gt =  getCenterStripNumber_float(strip_gt);
+		LocalPoint lp_center_gt = etaPart_ch->centreOfStrip(strip_gt);
+		data.propgt_localx_center_GE11[ch->id().layer()-1] = lp_center_gt.x();
+	    }
+	    if (bps.bounds().inside(pos2D_inner)){
+		float strip_inner = etaPart_ch->strip(pos_inner);
+		strip_inner =  getCenterStripNumber_float(strip_inner);
+		LocalPoint lp_center_inner = etaPart_ch->centreOfStrip(strip_inner);
+		data.propinner_localx_center_GE11[ch->id().layer()-1] = lp_center_inner.x();
+	    }
+
+
+
+	  float mindX = 9999.0;
+	  const residuals::Extrapolations prop = {{pos.x(), pos_gt.x(), pos_inner.x()}, {pos.y(), pos_gt.y(), pos_inner.y()}};
+	  //use all GEM reco hit collection instead, because reco muon algorithm might be inefficiency in using GEM hits
+          //for (auto hit = muonTrack->recHitsBegin(); hit != muonTrack->recHitsEnd(); hit++) {
+	  //nearest hit in local x in this and the neighbouring rolls, from the hits sorted by local x
+	  const GEMRecHit* hit = nullptr;
+	  bool hitInWindow = false;
+	  for (int roll = ch->id().roll() - 1; roll <= ch->id().roll() + 1; ++roll){
+	      if (roll < 1) continue;
+	      const GEMDetId rollId(ch->id().region(), ch->id().ring(), ch->id().station(), ch->id().layer(), ch->id().chamber(), roll);
+	      auto sorted = inputs.gemHits->find(rollId.rawId());
+	      if (sorted == inputs.gemHits->end()) continue;
+	      if (sorted->second.countInWindow(pos.x(), GEMRechit_muon_deltaX_) > 0)
+		  hitInWindow = true;
+	      const auto* nearest = sorted->second.nearestInX(pos.x());
+	      if (nearest and fabs(nearest->x - pos.x()) < mindX){
+		  mindX = fabs(nearest->x - pos.x());
+		  hit = nearest->hit;
+	      }
+	  }
+	  if (hitInWindow and not data.has_GE11[ch->id().layer()-1])
+	      data.nrechit_GE11 += 1;
+	  data.cand_dX_GE11[ch->id().layer()-1] = std::min(data.cand_dX_GE11[ch->id().layer()-1], mindX);
+	  if (not hypotheses_.empty() and ch->id().station() == 1 and ch->id().ring() == 1)
+	      evaluateHypotheses(data, ch, prop, tsosGP, inputs);
+	  if (candidates and ch->id().station() == 1 and ch->id().ring() == 1)
+	      storeGE11Candidates(*candidates, ch, prop, tsosGP, inputs);
+
+	  if (hit and ch->id().station() == 1 and ch->id().ring() == 1){
+              GEMDetId gemid((hit)->geographicalId());
+                const auto& etaPart = GEMGeometry_->etaPartition(gemid);
+		float strip = etaPart->strip(hit->localPosition());
+		LocalPoint lp_middle_hit = etaPart->centreOfStrip(etaPart->nstrips()/2);//middle in the roll of rechit
+		float deltay_roll =  etaPart_ch->toGlobal(lp_middle).perp() - etaPart->toGlobal(lp_middle_hit).perp();
+		float strip_flipped = getFlippedStripNumber(strip);
+		//CSC layer geometry redefined the strip angle here:
+		//https://github.com/cmssw-sw/cmssw/blob/from-CMSSW_10_5_X_2019-01-15-1100_ME0Trigger/Geometry/CSCGeometry/src/CSCLayerGeometry.cc
+		//M_PI_2 - theStripTopology->stripAngle(strip-0.5), strip is int strip number
+		//GEM geometry does not 
+		//float stripAngle = M_PI_2 - etaPart->specificTopology().stripAngle(strip) - M_PI/2.;
+	        //float stripAngle_flipped =  M_PI_2 - etaPart->specificTopology().stripAngle(strip_flipped) - M_PI/2.;
+		float stripAngle = etaPart->specificTopology().stripAngle(strip);
+	        float stripAngle_flipped =  etaPart->specificTopology().stripAngle(strip_flipped);
+                //std::cout <<"strip "<< strip <<" stripAngle "<< etaPart->specificTopology().stripAngle(strip)<<" sin "<< sin(strip)<<" cos "<< cos(strip) <<" flippedstrip "<< strip_flipped <<" stripAngle "<<  etaPart->specificTopology().stripAngle(strip_flipped) <<" sin "<<sin(stripAngle_flipped)<<" cos "<< cos(stripAngle_flipped) << std::endl;
+        		
+		LocalPoint lp_flipped = etaPart->centreOfStrip(strip_flipped);
+		LocalPoint lp_aligned(0.0, 0.0);
+		if (applyGEMalignment_){
+		    const GEMAlignmentTable::Entry& corr = alignment_.get(gemid);
+		    lp_aligned = LocalPoint(matching::alignedX(lp_flipped.x(), lp_flipped.y(), corr.deltaX, corr.rotation), lp_flipped.y(), lp_flipped.z());
+		}
+		//all hit variants against all three extrapolations in one pass
+		//RdPhi is taken relative to the middle of the propagated roll, hence yRef = -deltay_roll
+		residuals::Hits<residuals::kNGEMVariants> hitVariants;
+		residuals::setHit(hitVariants, residuals::kRaw, hit->localPosition().x(), hit->localPosition().y(), -deltay_roll, stripAngle);
+		residuals::setHit(hitVariants, residuals::kFlipped, lp_flipped.x(), lp_flipped.y(), -deltay_roll, stripAngle_flipped);
+		residuals::setHit(hitVariants, residuals::kAligned, lp_aligned.x(), lp_aligned.y(), -deltay_roll, stripAngle_flipped);
+		residuals::Residuals<residuals::kNGEMVariants> res;
+		residuals::compute(prop, hitVariants, res);
+		float deltaR_local = res.dR[residuals::kRaw][residuals::kSta];
+		float deltaX_local = res.dX[residuals::kRaw][residuals::kSta];
+		float deltaR_local_flipped = res.dR[residuals::kFlipped][residuals::kSta];
+		float deltaX_local_flipped = res.dX[residuals::kFlipped][residuals::kSta];
+		float deltaX_local_aligned  = applyGEMalignment_ ? res.dX[residuals::kAligned][residuals::kSta] : 0.0;
+
+                //bool rechit_used = std::find( muonTrack->recHitsBegin(), muonTrack->recHitsEnd(), hit->recHits().begin()) != muonTrack->recHitsEnd();
+		bool rechit_used = false;
+		/*
+		for (auto muonhit = muonTrack->recHitsBegin(); muonhit != muonTrack->recHitsEnd(); muonhit++) {
+		    if ( (*muonhit)->rawId() == ch->id().rawId() ) {
+			float deltaX_hitmatch = (hit)->localPosition().x() - (*muonhit)->localPosition().x();
+			//cout <<"muonhit GEMid "<< GEMDetId((*muonhit)->geographicalId()) <<" lp "<< (*muonhit)->localPosition() <<" deltaX_hitmatch "<< deltaX_hitmatch << endl;
+			if (fabs(deltaX_hitmatch) < 0.01) // deltaX should be just 0.0
+			    rechit_used = true;
+		    }
+		}*/
+
+		    /*cout << "found hit at GEM detector "<< gemid <<" strip "<< strip <<" flipped strip "<< strip_flipped
+			 << " lp " << (hit)->localPosition()
+			 << " flipped lp "<< lp_flipped
+			 << " gp " << etaPart->toGlobal((hit)->localPosition())
+			 << " flipped gp " << etaPart->toGlobal(lp_flipped)
+			 << " bx " << hit->BunchX() <<" firstclusterstrip "<< hit->firstClusterStrip() <<" cluster size "<< hit->clusterSize()
+			 << " "<< (*hit) <<" "
+			 << (rechit_used ? "used by muon track":"not used by muon track")
+			 <<" propagated lp "<< pos 
+			 <<" propagated gp "<< etaPart->toGlobal(pos)
+			 <<" deltaX_local "<< deltaX_local <<" local-dR " << deltaR_local
+			 <<" deltaX_local_flipped "<< deltaX_local_flipped << " local-dR flipped "<< deltaR_local_flipped
+			 << endl;
+			 */
+		    if (applyGEMalignment_){
+			 LogDebug("GEMCSCBendingAlgo") << "after applying GEM alignment, aligned lp " << lp_aligned
+			 << " aligned gp " << etaPart->toGlobal(lp_aligned)
+			 <<" deltaX_local_aligned "<< deltaX_local_aligned;
+		    }
+		    
+		    data.has_GE11[gemid.layer()-1] = 1;
+		    data.roll_rechitGE11[gemid.layer()-1] = gemid.roll();
+	            data.middle_perp_rechitGE11[gemid.layer()-1] = etaPart->toGlobal(lp_middle_hit).perp();//middle in the roll of prop
+		    data.rechit_firstClusterStrip_GE11[gemid.layer()-1] = hit->firstClusterStrip();
+		    data.rechit_clusterSize_GE11[gemid.layer()-1] = hit->clusterSize();
+		    data.rechit_BX_GE11[gemid.layer()-1] = hit->BunchX();
+		    data.rechit_used_GE11[gemid.layer()-1] = rechit_used;
+		    data.chamber_GE11[gemid.layer()-1] = gemid.chamber();
+		    if (flippedGEMStrip_){
+		      data.rechit_prop_dR_GE11[gemid.layer()-1] = deltaR_local_flipped;
+		      data.rechit_prop_dX_GE11[gemid.layer()-1] = deltaX_local_flipped;
+		      float sinAngle = hitVariants.sinAngle[residuals::kFlipped];
+		      float cosAngle = hitVariants.cosAngle[residuals::kFlipped];
+		      data.rechit_prop_RdPhi_GE11[gemid.layer()-1] = res.RdPhi[residuals::kFlipped][residuals::kSta];
+		      data.rechit_propgt_RdPhi_GE11[gemid.layer()-1] = res.RdPhi[residuals::kFlipped][residuals::kGlobal];
+		      data.rechit_propinner_RdPhi_GE11[gemid.layer()-1] = res.RdPhi[residuals::kFlipped][residuals::kInner];
+		      data.rechit_strip_GE11[gemid.layer()-1] = strip_flipped;
+			    
+		      data.stripangle_topology[gemid.layer()-1] = etaPart->specificTopology().stripAngle(strip_flipped);
+		      data.stripangle_test[gemid.layer()-1] = stripAngle_flipped;
+		      data.cos_stripangle_test[gemid.layer()-1] = cosAngle;
+		      data.sin_stripangle_test[gemid.layer()-1] = sinAngle;
+		      data.stand_RdPhi_minus_GE11[gemid.layer()-1] = res.RdPhiMinus[residuals::kFlipped][residuals::kSta];
+		      data.gt_RdPhi_minus_GE11[gemid.layer()-1] = res.RdPhiMinus[residuals::kFlipped][residuals::kGlobal];
+		      data.inner_RdPhi_minus_GE11[gemid.layer()-1] = res.RdPhiMinus[residuals::kFlipped][residuals::kInner];
+			    
+			    
+		      //std::cout << "dX "<< data.rechit_prop_dX_GE11[gemid.layer()-1]<<" dX for alignment(ST) "<< data.rechit_prop_RdPhi_GE11[gemid.layer()-1]<<" dX for alignment(Track) "<<data.rechit_propinner_RdPhi_GE11[gemid.layer()-1] << std::endl;
+		      data.rechit_phi_GE11[gemid.layer()-1] = etaPart->toGlobal(lp_flipped).phi();
+		      data.rechit_eta_GE11[gemid.layer()-1] = etaPart->toGlobal(lp_flipped).eta();
+		      data.rechit_x_GE11[gemid.layer()-1] = etaPart->toGlobal(lp_flipped).x();
+		      data.rechit_y_GE11[gemid.layer()-1] = etaPart->toGlobal(lp_flipped).y();
+		      data.rechit_localx_GE11[gemid.layer()-1] = lp_flipped.x();
+		      data.rechit_localy_GE11[gemid.layer()-1] = lp_flipped.y();
+                      data.rechit_localphi_GE11[ch->id().layer()-1] = asin(lp_flipped.x()/etaPart->toGlobal(lp_flipped).perp());
+		      data.rechit_r_GE11[gemid.layer()-1] = etaPart->toGlobal(lp_flipped).mag();
+		      data.rechit_perp_GE11[gemid.layer()-1] = etaPart->toGlobal(lp_flipped).perp();
+		      data.rechit_stripangle_GE11[gemid.layer()-1] = stripAngle_flipped;
+		    }else {
+		      data.rechit_prop_dR_GE11[gemid.layer()-1] = deltaR_local;
+		      data.rechit_prop_dX_GE11[gemid.layer()-1] = deltaX_local;
+		      float sinAngle = hitVariants.sinAngle[residuals::kRaw];
+		      float cosAngle = hitVariants.cosAngle[residuals::kRaw];
+		      data.rechit_prop_RdPhi_GE11[gemid.layer()-1] = res.RdPhi[residuals::kRaw][residuals::kSta];
+		      data.rechit_propgt_RdPhi_GE11[gemid.layer()-1] = res.RdPhi[residuals::kRaw][residuals::kGlobal];
+		      data.rechit_propinner_RdPhi_GE11[gemid.layer()-1] = res.RdPhi[residuals::kRaw][residuals::kInner];
+		      data.rechit_stripangle_GE11[gemid.layer()-1] = stripAngle;
+		      data.rechit_strip_GE11[gemid.layer()-1] = strip;
+			    
+			    
+		      data.stripangle_topology[gemid.layer()-1] = etaPart->specificTopology().stripAngle(strip);
+		      data.stripangle_test[gemid.layer()-1] = stripAngle;
+		      data.cos_stripangle_test[gemid.layer()-1] = cosAngle;
+		      data.sin_stripangle_test[gemid.layer()-1] = sinAngle;
+		      data.stand_RdPhi_minus_GE11[gemid.layer()-1] = res.RdPhiMinus[residuals::kRaw][residuals::kSta];
+		      data.gt_RdPhi_minus_GE11[gemid.layer()-1] = res.RdPhiMinus[residuals::kRaw][residuals::kGlobal];
+		      data.inner_RdPhi_minus_GE11[gemid.layer()-1] = res.RdPhiMinus[residuals::kRaw][residuals::kInner];
+			    
+			    
+			    
+		      //std::cout << "dX "<< data.rechit_prop_dX_GE11[gemid.layer()-1]<<" dX for alignment(ST) "<< data.rechit_prop_RdPhi_GE11[gemid.layer()-1]<<" dX for alignment(Track) "<<data.rechit_propinner_RdPhi_GE11[gemid.layer()-1] << std::endl;
+		      data.rechit_phi_GE11[gemid.layer()-1] = etaPart->toGlobal((hit)->localPosition()).phi();
+		      data.rechit_eta_GE11[gemid.layer()-1] = etaPart->toGlobal((hit)->localPosition()).eta();
+		      data.rechit_x_GE11[gemid.layer()-1] = etaPart->toGlobal((hit)->localPosition()).x();
+		      data.rechit_y_GE11[gemid.layer()-1] = etaPart->toGlobal((hit)->localPosition()).y();
+		      data.rechit_r_GE11[gemid.layer()-1] = etaPart->toGlobal((hit)->localPosition()).mag();
+		      data.rechit_perp_GE11[gemid.layer()-1] = etaPart->toGlobal((hit)->localPosition()).perp();
+		      data.rechit_localx_GE11[gemid.layer()-1] = (hit)->localPosition().x();
+		      data.rechit_localy_GE11[gemid.layer()-1] = (hit)->localPosition().y();
+                      data.rechit_localphi_GE11[ch->id().layer()-1] = asin((hit)->localPosition().x()/etaPart->toGlobal((hit)->localPosition()).perp());
+		    }
+		    data.rechit_prop_dphi_GE11[gemid.layer()-1] = reco::deltaPhi(tsosGP.phi(), data.rechit_phi_GE11[gemid.layer()-1]);
+		    if (applyGEMalignment_){
+			data.rechit_prop_aligneddX_GE11[gemid.layer()-1] = deltaX_local_aligned;
+			data.rechit_alignedphi_GE11[gemid.layer()-1] = etaPart->toGlobal(lp_aligned).phi();
+			data.rechit_alignedlocalx_GE11[gemid.layer()-1] = lp_aligned.x();
+			data.rechit_prop_aligneddphi_GE11[gemid.layer()-1] = reco::deltaPhi(tsosGP.phi(), data.rechit_alignedphi_GE11[gemid.layer()-1]);
+		    }
+
+          }//end of matched hit
+        }
+      }
+      /**** end of propagating track to GEM station and then associating gem reco hit to track ****/
+     //std::cout <<" end of propagating track to GEM station and then associating gem reco hit to track "<< std::endl;
+}
+
+void
+GEMCSCBendingAlgo::propagateToCSC(MuonData& data, MuonCandidates* candidates, const MuonStates& states, const EventInputs& inputs, const TrackPropagators& propagators, float& propTime)
+{
+      const Propagator* const trackPropagators[3] = {propagators.sta, propagators.gt, propagators.inner};
+      const TrajectoryStateOnSurface trackStates[3] = {states.sta, states.gt, states.inner};
+      /**** propagating track to CSC station and then associating csc reco hit to track ****/
+      for (const auto& ch : CSCGeometry_->layers()) {
+
+	 //ME1/1 only
+	bool isME11 = (ch->id().station() == 1 and (ch->id().ring() == 1 or ch->id().ring() == 4));
+	//if (isME11) cout <<"this is ME11 CSC layer "<< ch->id() << endl;
+        //TrajectoryStateOnSurface tsos = propagator->propagate(ttTrack.outermostMeasurementState(),ch->surface());
+        TrajectoryStateOnSurface tsosAll[3];
+        propagateToSurface(trackPropagators, trackStates, tsosAll, 3, *ch, (isME11 ? 1 : -1), propTime);
+        const TrajectoryStateOnSurface& tsos = tsosAll[0];
+        const TrajectoryStateOnSurface& tsos_gt = tsosAll[1];
+        const TrajectoryStateOnSurface& tsos_inner = tsosAll[2];
+        if (!tsos.isValid()) continue;
+        if (!tsos_gt.isValid()) continue;
+        if (!tsos_inner.isValid()) continue;
+
+        GlobalPoint tsosGP = tsos.globalPosition();
+        GlobalPoint tsosGP_gt = tsos_gt.globalPosition();
+        GlobalPoint tsosGP_inner = tsos_inner.globalPosition();
+
+	if (tsosGP.eta() * states.mu->eta() < 0.0) continue;
+	
+        const LocalPoint pos = ch->toLocal(tsosGP);
+        const LocalPoint pos2D(pos.x(), pos.y(), 0);
+        const LocalPoint pos_gt = ch->toLocal(tsosGP_gt);
+        const LocalPoint pos_inner = ch->toLocal(tsosGP_inner);
+	const residuals::Extrapolations prop = {{pos.x(), pos_gt.x(), pos_inner.x()}, {pos.y(), pos_gt.y(), pos_inner.y()}};
+	//const LocalPoint pos2D_gt(pos_gt.x(), pos_gt.y(), 0); 
+	//const LocalPoint pos2D_inner(pos_inner.x(), pos_inner.y(), 0); 
+        const BoundPlane& bps(ch->surface());
+        //cout << "tsos gp   "<< tsosGP << ch->id() <<endl;
+        //cout << "tsos gp   "<< tsosGP << ch->id() <<" tttrack.innermost Z position "<< ttTrack.innermostMeasurementState().globalPosition().z() <<" outermost Z position "<< ttTrack.outermostMeasurementState().globalPosition().z() <<endl;
+
+        if (bps.bounds().inside(pos2D)) {
+	  //if (ch->id().station() == 1 and ch->id().ring() == 1 )
+	  //    cout << "projection to CSC, in layer "<< ch->id() << " pos = "<<pos<< " R = "<<pos.mag() <<" inside "
+          //     <<  bps.bounds().inside(pos2D) <<endl;
+	  if (ch->id().station() == 1 and (ch->id().ring() == 1 or ch->id().ring() == 4) ){
+	    data.has_propME11[ch->id().layer()-1] = true;
+	    data.chamber_propME11[ch->id().station() - 1] = ch->id().chamber();
+	    data.ring_propME11[ch->id().station() - 1] = ch->id().ring();
+	    data.prop_phi_ME11[ch->id().layer()-1] = tsosGP.phi();
+	    data.prop_eta_ME11[ch->id().layer()-1] = tsosGP.eta();
+	    data.prop_x_ME11[ch->id().layer()-1] = tsosGP.x();
+	    data.prop_y_ME11[ch->id().layer()-1] = tsosGP.y();
+	    data.prop_r_ME11[ch->id().layer()-1] = tsosGP.mag();
+	    data.prop_perp_ME11[ch->id().layer()-1] = tsosGP.perp();
+	    data.propgt_phi_ME11[ch->id().layer()-1] = tsosGP_gt.phi();
+	    data.propgt_eta_ME11[ch->id().layer()-1] = tsosGP_gt.eta();
+	    data.propgt_x_ME11[ch->id().layer()-1]   = tsosGP_gt.x();
+	    data.propgt_y_ME11[ch->id().layer()-1]   = tsosGP_gt.y();
+	    data.propgt_r_ME11[ch->id().layer()-1]   = tsosGP_gt.mag();
+	    data.propgt_perp_ME11[ch->id().layer()-1]   = tsosGP_gt.perp();
+	    data.propinner_phi_ME11[ch->id().layer()-1] = tsosGP_inner.phi();
+	    data.propinner_eta_ME11[ch->id().layer()-1] = tsosGP_inner.eta();
+	    data.propinner_x_ME11[ch->id().layer()-1]   = tsosGP_inner.x();
+	    data.propinner_y_ME11[ch->id().layer()-1]   = tsosGP_inner.y();
+	    data.propinner_r_ME11[ch->id().layer()-1]   = tsosGP_inner.mag();
+	    data.propinner_perp_ME11[ch->id().layer()-1]   = tsosGP_inner.perp();
+
+	    data.prop_localx_ME11[ch->id().layer()-1] = pos.x();
+	    data.prop_localy_ME11[ch->id().layer()-1] = pos.y();
+	    data.propgt_localx_ME11[ch->id().layer()-1] = pos_gt.x();
+	    data.propgt_localy_ME11[ch->id().layer()-1] = pos_gt.y();
+	    data.propinner_localx_ME11[ch->id().layer()-1] = pos_inner.x();
+	    data.propinner_localy_ME11[ch->id().layer()-1] = pos_inner.y();
+	  }
+	  
+
+	  if (ch->id().layer() == 3)//keylayer
+	  {
+	      data.has_prop_st[ch->id().station() -1] = true;
+	      data.prop_phi_st[ch->id().station() - 1] = tsosGP.phi();
+	      data.prop_eta_st[ch->id().station() - 1] = tsosGP.eta();
+	      data.prop_x_st[ch->id().station() - 1]   = tsosGP.x();
+	      data.prop_y_st[ch->id().station() - 1]   = tsosGP.y();
+	      data.prop_r_st[ch->id().station() - 1]   = tsosGP.mag();
+	      data.prop_perp_st[ch->id().station() - 1]   = tsosGP.perp();
+	      data.prop_chamber_st[ch->id().station() - 1] = ch->id().chamber();
+	      data.prop_ring_st[ch->id().station() - 1] = ch->id().ring();
+	      data.prop_localx_st[ch->id().station()-1] = pos.x();
+	      data.prop_localy_st[ch->id().station()-1] = pos.y();
+	      data.propgt_phi_st[ch->id().station() - 1]    = tsosGP_gt.phi();
+	      data.propgt_eta_st[ch->id().station() - 1]    = tsosGP_gt.eta();
+	      data.propgt_x_st[ch->id().station() - 1]      = tsosGP_gt.x();
+	      data.propgt_y_st[ch->id().station() - 1]      = tsosGP_gt.y();
+	      data.propgt_r_st[ch->id().station() - 1]      = tsosGP_gt.mag();
+	      data.propgt_perp_st[ch->id().station() - 1]   = tsosGP_gt.perp();
+	      data.propgt_localx_st[ch->id().station()-1] = pos_gt.x();
+	      data.propgt_localy_st[ch->id().station()-1] = pos_gt.y();
+	      data.propinner_phi_st[ch->id().station() - 1]    = tsosGP_inner.phi();
+	      data.propinner_eta_st[ch->id().station() - 1]    = tsosGP_inner.eta();
+	      data.propinner_x_st[ch->id().station() - 1]      = tsosGP_inner.x();
+	      data.propinner_y_st[ch->id().station() - 1]      = tsosGP_inner.y();
+	      data.propinner_r_st[ch->id().station() - 1]      = tsosGP_inner.mag();
+	      data.propinner_perp_st[ch->id().station() - 1]   = tsosGP_inner.perp();
+	      data.propinner_localx_st[ch->id().station()-1] = pos_inner.x();
+	      data.propinner_localy_st[ch->id().station()-1] = pos_inner.y();
+
+	      CSCSegment matchedSeg;
+	      float mindR = 9999.0;
+	      bool hasCSCsegment  = matchRecoMuonwithCSCSeg(pos, inputs.cscSegments, ch->id(), matchedSeg, mindR);
+	      data.cand_dR_cscseg_st[ch->id().station() - 1] = std::min(data.cand_dR_cscseg_st[ch->id().station() - 1], mindR);
+
+	      if (mindR < CSCSegment_muon_deltaR_ and not data.has_cscseg_st[ch->id().station() -1])
+		  data.ncscseg += 1;
+	      if (hasCSCsegment and mindR < CSCSegment_muon_deltaR_){
+		  //std::cout <<"CSC segment is found "<< std::endl;
+		  data.has_cscseg_st[ch->id().station() - 1] = hasCSCsegment;
+		  data.cscseg_phi_st[ch->id().station() - 1] = ch->toGlobal(matchedSeg.localPosition()).phi();
+		  data.cscseg_eta_st[ch->id().station() - 1] = ch->toGlobal(matchedSeg.localPosition()).eta();
+		  data.cscseg_x_st[ch->id().station() - 1] = ch->toGlobal(matchedSeg.localPosition()).x();
+		  data.cscseg_y_st[ch->id().station() - 1] = ch->toGlobal(matchedSeg.localPosition()).y();
+		  data.cscseg_r_st[ch->id().station() - 1] = ch->toGlobal(matchedSeg.localPosition()).mag();
+		  data.cscseg_perp_st[ch->id().station() - 1] = ch->toGlobal(matchedSeg.localPosition()).perp();
+		  data.cscseg_localx_st[ch->id().station() - 1] = matchedSeg.localPosition().x();
+		  data.cscseg_localy_st[ch->id().station() - 1] = matchedSeg.localPosition().y();
+		  data.cscseg_prop_dR_st[ch->id().station() - 1] = mindR;
+		  data.cscseg_prop_dphi_st[ch->id().station() - 1] = reco::deltaPhi(tsosGP.phi(), data.cscseg_phi_st[ch->id().station() - 1]);
+		  data.cscseg_chamber_st[ch->id().station() - 1] = ch->id().chamber();
+		  data.cscseg_ring_st[ch->id().station() - 1] = ch->id().ring();
+		  float strip = ch->geometry()->strip(matchedSeg.localPosition());
+		  float stripAngle = ch->geometry()->stripAngle(strip);
+		  residuals::Hits<1> segHit;
+		  residuals::setHit(segHit, 0, matchedSeg.localPosition().x(), matchedSeg.localPosition().y(), matchedSeg.localPosition().y(), stripAngle);
+		  residuals::Residuals<1> res;
+		  residuals::compute(prop, segHit, res);
+		  data.cscseg_strip_st[ch->id().station() - 1] = strip;
+		  data.cscseg_stripangle_st[ch->id().station() - 1] = stripAngle-M_PI/2.0;
+		  data.cscseg_prop_RdPhi_st[ch->id().station() - 1] = res.RdPhi[0][residuals::kSta];
+		  data.cscseg_propgt_RdPhi_st[ch->id().station() - 1] = res.RdPhi[0][residuals::kGlobal];
+		  data.cscseg_propinner_RdPhi_st[ch->id().station() - 1] = res.RdPhi[0][residuals::kInner];
+		  if (abs(matchedSeg.localPosition().x() - pos.x())> CSCSegment_muon_deltaR_ || abs(matchedSeg.localPosition().y() - pos.y())> CSCSegment_muon_deltaR_){
+		      LogDebug("GEMCSCBendingAlgo") <<"CSCid " << ch->id()<<" prop lp "<< pos << " matched CSCsegment, lp "<< matchedSeg.localPosition() <<" gp "<< ch->toGlobal(matchedSeg.localPosition()) <<" dR(prop, seg) "<< mindR <<" cscseg_prop_RdPhi_st "<< data.cscseg_prop_RdPhi_st[ch->id().station() - 1] <<" cscseg_propinner_RdPhi_st "<< data.cscseg_propinner_RdPhi_st[ch->id().station() - 1] <<" strip "<< strip <<" stripangle "<< stripAngle;
+		  }
+	      }else
+		  LogDebug("GEMCSCBendingAlgo") <<" no CSC segment is found";
+	  }
+	  
+	  if (matchMuonwithLCT_ and inputs.hasLCTcollection and ch->id().layer() == 3)//keylayer
+	  {
+	      CSCCorrelatedLCTDigi matchedLCT;
+	      LocalPoint lctlp;
+	      float mindR = 9999.0;
+	      bool hasCSCLct  = matchRecoMuonwithCSCLCT(pos, inputs.cscLcts, ch->id(), matchedLCT, lctlp, mindR);
+	      data.cand_dR_csclct_st[ch->id().station() - 1] = std::min(data.cand_dR_csclct_st[ch->id().station() - 1], mindR);
+	      if (mindR < CSCLCT_muon_deltaR_ and not data.has_csclct_st[ch->id().station() -1])
+		  data.ncscLct += 1;
+	      if (hasCSCLct){
+		  data.has_csclct_st[ch->id().station() - 1] = hasCSCLct;
+		  //CSCDetId cscid((*cscseg)->geographicalId());
+		  //GlobalPoint seggp = CSCGeometry_->idToDet((*cscseg)->cscDetId())->surface().toGlobal((*cscseg)->localPosition());
+		  data.csclct_phi_st[ch->id().station() - 1] = ch->toGlobal(lctlp).phi();
+		  data.csclct_eta_st[ch->id().station() - 1] = ch->toGlobal(lctlp).eta();
+		  data.csclct_x_st[ch->id().station() - 1] = ch->toGlobal(lctlp).x();
+		  data.csclct_y_st[ch->id().station() - 1] = ch->toGlobal(lctlp).y();
+		  data.csclct_r_st[ch->id().station() - 1] = ch->toGlobal(lctlp).mag();
+		  data.csclct_perp_st[ch->id().station() - 1] = ch->toGlobal(lctlp).perp();
+		  data.csclct_prop_dR_st[ch->id().station() - 1] = mindR;
+		  data.csclct_prop_dphi_st[ch->id().station() - 1] = reco::deltaPhi(tsosGP.phi(), data.csclct_phi_st[ch->id().station() - 1]);
+		  data.csclct_chamber_st[ch->id().station() - 1] = ch->id().chamber();
+		  data.csclct_ring_st[ch->id().station() - 1] = ch->id().ring();
+		  data.csclct_keyStrip_st[ch->id().station() - 1] = matchedLCT.getStrip();
+		  data.csclct_keyWG_st[ch->id().station() - 1] = matchedLCT.getKeyWG();
+		  data.csclct_matchWin_st[ch->id().station() - 1] = matchedLCT.getBX0();
+		  data.csclct_pattern_st[ch->id().station() - 1] = matchedLCT.getPattern();
+		  //std::cout <<" CSCid " << ch->id() << " found matched CSC LCT, lp "<< lctlp <<" gp "<< ch->toGlobal(lctlp) << std::endl;
+		  //if (ch->id().station() == 1 and (ch->id().ring() == 1 or ch->id().ring() == 4)){
+		  //    for(unsigned int i=0; i<2; i++){
+		  //        if (data.has_GE11[i]){
+		  //            data.dphi_CSCseg_GE11Rechit[i] = reco::deltaPhi(data.cscseg_phi_st[ch->id().station() - 1], data.rechit_phi_GE11[i]);
+		  //        }
+		  //    }
+		  //}//ME11-GE11, dphi(CSCLCT, GEMPad), L1
+	      }
+	  }
+	  //use all CSC reco hit collection instead, because reco muon algorithm might be inefficiency in using CSC hits
+          //for (auto hit = muonTrack->recHitsBegin(); hit != muonTrack->recHitsEnd(); hit++) {
+	  //only ME11 rechits
+	  if (candidates and isME11)
+	      storeME11Candidates(*candidates, ch, prop, tsosGP, inputs);
+	  //nearest hit in local (x, y) of this layer, from the hits sorted by local x
+	  float mindR = 9999.0;
+	  const CSCRecHit2D* hit = nullptr;
+          if (matchMuonwithCSCRechit_ and inputs.hasCSCRechitcollection and isME11) {
+	      auto sorted = inputs.cscHits->find(ch->id().rawId());
+	      if (sorted != inputs.cscHits->end()){
+		  const auto* nearest = sorted->second.nearestInR(pos.x(), pos.y(), mindR);
+		  if (nearest) hit = nearest->hit;
+	      }
+	  }
+	  if (hit) {
+                CSCDetId cscid((hit)->geographicalId());
+                //const CSCLayer* layer = CSCGeometry_->layer(cscid);
+		//if (layer == ch) cout <<" layer and ch are the same!! "<< endl;
+	        if (mindR < CSCRechit_muon_deltaR_ and not data.has_ME11[cscid.layer() -1])
+		    data.nrechit_ME11 += 1;
+		data.cand_dR_ME11[cscid.layer()-1] = std::min(data.cand_dR_ME11[cscid.layer()-1], mindR);
+
+		bool rechit_used = false;
+		
+		for (auto muonhit = states.muonTrack->recHitsBegin(); muonhit != states.muonTrack->recHitsEnd(); muonhit++) {
+		    if ( (*muonhit)->rawId() == ch->id().rawId() ) {
+			float deltaX_hitmatch = (hit)->localPosition().x() - (*muonhit)->localPosition().x();
+			if (fabs(deltaX_hitmatch) < 0.01) // deltaX should be just 0.0
+			    rechit_used = true;
+			LogDebug("GEMCSCBendingAlgo") <<"muonhit CSCid "<< CSCDetId((*muonhit)->geographicalId()) <<" lp "<< (*muonhit)->localPosition() <<" deltaX_hitmatch "<< deltaX_hitmatch << (rechit_used ? "matched":"notmatched");
+		    }
+		}
+
+
+		if (ch->id().station() == 1 and (ch->id().ring()==1 or ch->id().ring() ==4)){
+		    //cout << "found hit ME11 CSC detector "<< cscid
+		    //     << " lp " << (hit)->localPosition()
+		    //     << " gp " << ch->toGlobal((hit)->localPosition())
+		    //     <<" "<< (*hit)
+		    //     << endl;
+		    data.has_ME11[cscid.layer()-1] = 1;
+		    data.rechit_used_ME11[cscid.layer()-1] = rechit_used;
+		    data.chamber_ME11[cscid.layer()-1] = ch->id().chamber();
+
+		    data.rechit_hitWire_ME11[cscid.layer()-1] = hit->hitWire();
+		    data.rechit_nStrips_ME11[cscid.layer()-1] = hit->nStrips();
+		    int centralStrip = -1;
+		    if (hit->nStrips() > 0)
+			centralStrip = hit->channels(hit->nStrips()/2);
+		    data.rechit_centralStrip_ME11[cscid.layer()-1] = centralStrip;
+		    data.rechit_halfstrip_ME11[cscid.layer()-1] = (hit->positionWithinStrip()<0.0)? 2*(centralStrip-1):2*(centralStrip-1)+1;
+		    //data.rechit_WG_ME11[cscid.layer()-1] = ch->geometry()->wireGroup(hit->hitWire());
+		    //std::cout <<"WG "<< data.rechit_WG_ME11[cscid.layer()-1] <<" wire "<< hit->hitWire() << std::endl;
+		    if (hit->nStrips() > 0 and hit->hitWire() >=0){
+			GlobalPoint rechit_L1_gp = ch->toGlobal(ch->geometry()->stripWireGroupIntersection(centralStrip, hit->hitWire()));
+			data.rechit_L1phi_ME11[cscid.layer()-1] = rechit_L1_gp.phi();
+			data.rechit_L1eta_ME11[cscid.layer()-1] = rechit_L1_gp.eta();
+		    }//use resolution at L1
+		    int strip = ch->geometry()->nearestStrip(hit->localPosition());
+		    float stripAngle = ch->geometry()->stripAngle(strip) - M_PI/2.;
+		    residuals::Hits<1> cscHit;
+		    residuals::setHit(cscHit, 0, hit->localPosition().x(), hit->localPosition().y(), hit->localPosition().y(), stripAngle);
+		    residuals::Residuals<1> res;
+		    residuals::compute(prop, cscHit, res);
+		    data.rechit_prop_dR_ME11[cscid.layer()-1] = mindR;
+		    data.rechit_phi_ME11[cscid.layer()-1] = ch->toGlobal((hit)->localPosition()).phi();
+		    data.rechit_eta_ME11[cscid.layer()-1] = ch->toGlobal((hit)->localPosition()).eta();
+		    data.rechit_x_ME11[cscid.layer()-1] = ch->toGlobal((hit)->localPosition()).x();
+		    data.rechit_y_ME11[cscid.layer()-1] = ch->toGlobal((hit)->localPosition()).y();
+		    data.rechit_localx_ME11[cscid.layer()-1] = (hit)->localPosition().x();
+		    data.rechit_localy_ME11[cscid.layer()-1] = (hit)->localPosition().y();
+		    data.rechit_r_ME11[cscid.layer()-1] = ch->toGlobal((hit)->localPosition()).mag();
+		    data.rechit_perp_ME11[cscid.layer()-1] = ch->toGlobal((hit)->localPosition()).perp();
+		    data.rechit_prop_dphi_ME11[cscid.layer()-1] = reco::deltaPhi(tsosGP.phi(),  data.rechit_phi_ME11[cscid.layer()-1]);
+		    data.rechit_prop_RdPhi_ME11[cscid.layer()-1] = res.RdPhi[0][residuals::kSta];
+		    data.rechit_propgt_RdPhi_ME11[cscid.layer()-1] = res.RdPhi[0][residuals::kGlobal];
+		    data.rechit_propinner_RdPhi_ME11[cscid.layer()-1] = res.RdPhi[0][residuals::kInner];
+
+		}
+          }//end of matched csc rechit
+
+        }//if (bps.bounds().inside(pos2D)) 
+      }
+
+
+      /**** end of propagating track to CSC station and then associating csc reco hit to track ****/
+      ///std::cout <<"end of propagating track to CSC station and then associating csc reco hit to track" << std::endl;
+}
+
+void
+GEMCSCBendingAlgo::fillGE11ME11Bending(MuonData& data)
+{
+      //GE11-ME11 bending of every alignment hypothesis
+      for (int h=0; h<data.nHypotheses; h++){
+	  for (unsigned int i=0; i<2; i++){
+	      if (not data.hyp_has_GE11[h][i]) continue;
+	      if (data.has_cscseg_st[0] and (data.cscseg_ring_st[0] == 1 or data.cscseg_ring_st[0] == 4))
+		  data.hyp_dphi_CSCSeg_GE11Rechit[h][i] = reco::deltaPhi(data.cscseg_phi_st[0], data.hyp_rechit_phi_GE11[h][i]);
+	      if (data.has_ME11[2])
+		  data.hyp_dphi_keyCSCRechit_GE11Rechit[h][i] = reco::deltaPhi(data.rechit_phi_ME11[2], data.hyp_rechit_phi_GE11[h][i]);
+	  }
+      }
+      for (unsigned int i=0; i<2; i++){
+	  //ME11-GE11, deltaPhi(propME11, propGE11), ME11 key layer
+	  if (data.has_propME11[2] and data.has_propGE11[i])
+	      data.dphi_propCSC_propGE11[i] = reco::deltaPhi(data.prop_phi_ME11[2], data.prop_phi_GE11[i]);
+	  if (not data.has_GE11[i]) continue;
+	  //ME11-GE11, dphi(CSCsegment, GEMRechit)
+	  if (data.has_cscseg_st[0] and (data.cscseg_ring_st[0] == 1 or data.cscseg_ring_st[0] == 4)){
+	      data.dphi_CSCSeg_GE11Rechit[i] = reco::deltaPhi(data.cscseg_phi_st[0], data.rechit_phi_GE11[i]);
+	      data.dphi_CSCSeg_alignedGE11Rechit[i] = reco::deltaPhi(data.cscseg_phi_st[0], data.rechit_alignedphi_GE11[i]);
+	  }
+	  //ME11-GE11, dphi(CSCRechit, GEMRechit), ME11 key layer
+	  if (data.has_ME11[2]){
+	      data.dphi_keyCSCRechit_GE11Rechit[i] = reco::deltaPhi(data.rechit_phi_ME11[2], data.rechit_phi_GE11[i]);
+	      data.dphi_keyCSCRechit_alignedGE11Rechit[i] = reco::deltaPhi(data.rechit_phi_ME11[2], data.rechit_alignedphi_GE11[i]);
+	      if (data.rechit_L1phi_ME11[2] < 4.0){//avoid fake value
+		  data.dphi_keyCSCRechitL1_GE11Rechit[i] = reco::deltaPhi(data.rechit_L1phi_ME11[2], data.rechit_phi_GE11[i]);
+		  data.dphi_keyCSCRechitL1_alignedGE11Rechit[i] = reco::deltaPhi(data.rechit_L1phi_ME11[2], data.rechit_alignedphi_GE11[i]);
+	      }
+	  }
+      }
+}
+
+
+
+void
+GEMCSCBendingAlgo::evaluateHypotheses(MuonData& data, const GEMEtaPartition* ch, const residuals::Extrapolations& prop, const GlobalPoint& tsosGP, const EventInputs& inputs)
+{
+      const int layer = ch->id().layer()-1;
+      const float pos_x = prop.x[residuals::kSta];
+      const LocalPoint lp_middle = ch->centreOfStrip(ch->nstrips()/2);
+      //one hit per hypothesis, all of them against the three extrapolations in one pass
+      residuals::Hits<MuonData::kMaxHypotheses> hits = {};
+      const GEMEtaPartition* hitEtaPart[MuonData::kMaxHypotheses] = {};
+      const GEMDetId id = ch->id();
+      auto rollKey = [&id](int roll){ return GEMDetId(id.region(), id.ring(), id.station(), id.layer(), id.chamber(), roll).rawId(); };
+      for (size_t i = 0; i < hypotheses_.size(); ++i){
+	  const AlignmentHypothesis& h = hypotheses_[i];
+	  const hitindex::Index<GEMRecHit>* index = (h.flipped == flippedGEMStrip_ ? inputs.gemHits : inputs.gemHitsOtherFlip);
+	  //nearest hit in local x in this and the neighbouring rolls, with the strip ordering of the hypothesis
+	  float mindX = 9999.0;
+	  const hitindex::Entry<GEMRecHit>* hit = matching::nearestInRolls(*index, ch->id().roll(), rollKey, pos_x, mindX);
+	  if (hit == nullptr) continue;
+	  //entries are keyed by the local x with the strip ordering of the index already applied
+	  const GEMDetId gemid(hit->hit->geographicalId());
+	  const auto& etaPart = GEMGeometry_->etaPartition(gemid);
+	  float strip = etaPart->strip(hit->hit->localPosition());
+	  if (h.flipped) strip = getFlippedStripNumber(strip);
+	  const GEMAlignmentTable::Entry& corr = h.alignment.get(gemid);
+	  const LocalPoint lp_middle_hit = etaPart->centreOfStrip(etaPart->nstrips()/2);
+	  const float deltay_roll = ch->toGlobal(lp_middle).perp() - etaPart->toGlobal(lp_middle_hit).perp();
+	  residuals::setHit(hits, i, matching::alignedX(hit->x, hit->y, corr.deltaX, corr.rotation), hit->y, -deltay_roll, etaPart->specificTopology().stripAngle(strip));
+	  hitEtaPart[i] = etaPart;
+      }
+      residuals::Residuals<MuonData::kMaxHypotheses> res;
+      residuals::compute(prop, hits, res);
+
+      for (size_t i = 0; i < hypotheses_.size(); ++i){
+	  if (hitEtaPart[i] == nullptr) continue;
+	  const GlobalPoint gp = hitEtaPart[i]->toGlobal(LocalPoint(hits.x[i], hits.y[i], 0.0));
+	  data.hyp_has_GE11[i][layer] = true;
+	  data.hyp_rechit_localx_GE11[i][layer] = hits.x[i];
+	  data.hyp_rechit_phi_GE11[i][layer] = gp.phi();
+	  data.hyp_prop_dX_GE11[i][layer] = res.dX[i][residuals::kSta];
+	  data.hyp_prop_RdPhi_GE11[i][layer] = res.RdPhi[i][residuals::kSta];
+	  data.hyp_propinner_RdPhi_GE11[i][layer] = res.RdPhi[i][residuals::kInner];
+	  data.hyp_prop_dphi_GE11[i][layer] = reco::deltaPhi(tsosGP.phi(), gp.phi());
+      }
+}
+
+void
+GEMCSCBendingAlgo::storeGE11Candidates(MuonCandidates& candidates, const GEMEtaPartition* ch, const residuals::Extrapolations& prop, const GlobalPoint& tsosGP, const EventInputs& inputs)
+{
+      if (candidates.nGE11Props == MuonCandidates::kMaxGE11Props){
+	  candidates.nDropped++;
+	  return;
+      }
+      const int n = candidates.nGE11Props++;
+      const GEMDetId id = ch->id();
+      candidates.propGE11_region[n] = id.region();
+      candidates.propGE11_chamber[n] = id.chamber();
+      candidates.propGE11_layer[n] = id.layer();
+      candidates.propGE11_roll[n] = id.roll();
+      candidates.propGE11_middlePerp[n] = ch->toGlobal(ch->centreOfStrip(ch->nstrips()/2)).perp();
+      candidates.propGE11_phi[n] = tsosGP.phi();
+      for (int t = 0; t < MuonCandidates::kNTracks; ++t){
+	  candidates.propGE11_x[n][t] = prop.x[t];
+	  candidates.propGE11_y[n][t] = prop.y[t];
+      }
+
+      //hits of this and the neighbouring rolls within the window of any track, each hit stored once per muon
+      //the window is applied to the local x with both strip orderings, so that gemcscRematch can rematch
+      //with either; the index is sorted in one ordering only, so all hits of the roll are checked
+      float xmin = prop.x[0], xmax = prop.x[0];
+      for (int t = 1; t < MuonCandidates::kNTracks; ++t){
+	  xmin = std::min(xmin, prop.x[t]);
+	  xmax = std::max(xmax, prop.x[t]);
+      }
+      for (int roll = id.roll() - 1; roll <= id.roll() + 1; ++roll){
+	  if (roll < 1) continue;
+	  const GEMDetId rollId(id.region(), id.ring(), id.station(), id.layer(), id.chamber(), roll);
+	  auto sorted = inputs.gemHits->find(rollId.rawId());
+	  if (sorted == inputs.gemHits->end()) continue;
+	  const auto& etaPart = GEMGeometry_->etaPartition(rollId);
+	  const float middlePerp = etaPart->toGlobal(etaPart->centreOfStrip(etaPart->nstrips()/2)).perp();
+	  const float x0 = 0.5*(xmin + xmax);
+	  const float window = 0.5*(xmax - xmin) + candidateWindow_;
+	  sorted->second.forEach([&](const hitindex::Entry<GEMRecHit>& e){
+	      const GEMRecHit* hit = e.hit;
+	      const LocalPoint lp = hit->localPosition();
+	      const float strip = etaPart->strip(lp);
+	      const float strip_flipped = getFlippedStripNumber(strip);
+	      const LocalPoint lp_flipped = etaPart->centreOfStrip(strip_flipped);
+	      if (std::fabs(lp.x() - x0) >= window and std::fabs(lp_flipped.x() - x0) >= window) return;
+	      for (int i = 0; i < candidates.nGE11Hits; ++i)
+		  if (candidates.hitGE11_roll[i] == roll and candidates.hitGE11_layer[i] == id.layer() and candidates.hitGE11_chamber[i] == id.chamber()
+		      and candidates.hitGE11_region[i] == id.region() and candidates.hitGE11_x[i] == lp.x()) return;
+	      if (candidates.nGE11Hits == MuonCandidates::kMaxGE11Hits){
+		  candidates.nDropped++;
+		  return;
+	      }
+	      const int h = candidates.nGE11Hits++;
+	      const GlobalPoint gp = etaPart->toGlobal(lp);
+	      candidates.hitGE11_region[h] = id.region();
+	      candidates.hitGE11_chamber[h] = id.chamber();
+	      candidates.hitGE11_layer[h] = id.layer();
+	      candidates.hitGE11_roll[h] = roll;
+	      candidates.hitGE11_BX[h] = hit->BunchX();
+	      candidates.hitGE11_clusterSize[h] = hit->clusterSize();
+	      candidates.hitGE11_firstClusterStrip[h] = hit->firstClusterStrip();
+	      candidates.hitGE11_strip[h] = strip;
+	      candidates.hitGE11_x[h] = lp.x();
+	      candidates.hitGE11_flippedX[h] = lp_flipped.x();
+	      candidates.hitGE11_y[h] = lp.y();
+	      candidates.hitGE11_stripAngle[h] = etaPart->specificTopology().stripAngle(strip);
+	      candidates.hitGE11_flippedStripAngle[h] = etaPart->specificTopology().stripAngle(strip_flipped);
+	      candidates.hitGE11_middlePerp[h] = middlePerp;
+	      candidates.hitGE11_phi[h] = gp.phi();
+	      candidates.hitGE11_flippedPhi[h] = etaPart->toGlobal(lp_flipped).phi();
+	      candidates.hitGE11_dphidx[h] = reco::deltaPhi(etaPart->toGlobal(LocalPoint(lp.x() + 1.0, lp.y(), lp.z())).phi(), gp.phi());
+	  });
+      }
+}
+
+void
+GEMCSCBendingAlgo::storeME11Candidates(MuonCandidates& candidates, const CSCLayer* ch, const residuals::Extrapolations& prop, const GlobalPoint& tsosGP, const EventInputs& inputs)
+{
+      if (candidates.nME11Props == MuonCandidates::kMaxME11Props){
+	  candidates.nDropped++;
+	  return;
+      }
+      const int n = candidates.nME11Props++;
+      const CSCDetId id = ch->id();
+      candidates.propME11_endcap[n] = id.endcap();
+      candidates.propME11_chamber[n] = id.chamber();
+      candidates.propME11_ring[n] = id.ring();
+      candidates.propME11_layer[n] = id.layer();
+      candidates.propME11_phi[n] = tsosGP.phi();
+      for (int t = 0; t < MuonCandidates::kNTracks; ++t){
+	  candidates.propME11_x[n][t] = prop.x[t];
+	  candidates.propME11_y[n][t] = prop.y[t];
+      }
+
+      //ME11 rechits are only indexed with matchMuonwithCSCRechit
+      if (not (matchMuonwithCSCRechit_ and inputs.hasCSCRechitcollection)) return;
+      auto sorted = inputs.cscHits->find(id.rawId());
+      if (sorted == inputs.cscHits->end()) return;
+      sorted->second.forEachInWindow(prop.x[residuals::kSta], candidateWindow_, [&](const hitindex::Entry<CSCRecHit2D>& e){
+	  const float dx = e.x - prop.x[residuals::kSta];
+	  const float dy = e.y - prop.y[residuals::kSta];
+	  if (dx*dx + dy*dy >= candidateWindow_*candidateWindow_) return;
+	  if (candidates.nME11Hits == MuonCandidates::kMaxME11Hits){
+	      candidates.nDropped++;
+	      return;
+	  }
+	  const int h = candidates.nME11Hits++;
+	  const LocalPoint lp = e.hit->localPosition();
+	  candidates.hitME11_endcap[h] = id.endcap();
+	  candidates.hitME11_chamber[h] = id.chamber();
+	  candidates.hitME11_ring[h] = id.ring();
+	  candidates.hitME11_layer[h] = id.layer();
+	  candidates.hitME11_x[h] = lp.x();
+	  candidates.hitME11_y[h] = lp.y();
+	  candidates.hitME11_stripAngle[h] = ch->geometry()->stripAngle(ch->geometry()->nearestStrip(lp)) - M_PI/2.;
+	  candidates.hitME11_phi[h] = ch->toGlobal(lp).phi();
+      });
+}
+
+//////////////  Get the matching with CSC-sgements...
+bool GEMCSCBendingAlgo::matchRecoMuonwithCSCSeg(const LocalPoint muonlp, edm::Handle<CSCSegmentCollection> cscSegments, CSCDetId idCSC, CSCSegment &matchedSeg, float &mindR){
+
+  float deltaCSCR = 9999.;
+  bool matched = false;
+  for(CSCSegmentCollection::const_iterator segIt=cscSegments->begin(); segIt != cscSegments->end(); segIt++) {
+    CSCDetId id  = (CSCDetId)(*segIt).cscDetId();
+    if(idCSC.endcap() != id.endcap())continue;
+    if(idCSC.station() != id.station())continue;
+    if(idCSC.chamber() != id.chamber())continue;
+      
+    Bool_t ed1 = (idCSC.station() == 1) && ((idCSC.ring() == 1 || idCSC.ring() == 4) && (id.ring() == 1 || id.ring() == 4));
+    Bool_t ed2 = (idCSC.station() == 1) && ((idCSC.ring() == 2 && id.ring() == 2) || (idCSC.ring() == 3 && id.ring() == 3));
+    Bool_t ed3 = (idCSC.station() != 1) && (idCSC.ring() == id.ring());
+    Bool_t TMCSCMatch = (ed1 || ed2 || ed3);
+    if(! TMCSCMatch)continue;
+    
+    //TrajectoryStateOnSurface TrajSuf_ = surfExtrapTrkSam(trackRef, cscchamber->toGlobal( (*segIt).localPosition() ).z());
+
+
+    const float dx = (*segIt).localPosition().x() - muonlp.x();
+    const float dy = (*segIt).localPosition().y() - muonlp.y();
+    float deltaR_local = std::sqrt(dx*dx + dy*dy);
+
+    if ( deltaR_local < deltaCSCR  ){
+      matched = true;
+      deltaCSCR = deltaR_local;
+      mindR = deltaR_local;
+      matchedSeg = *segIt;
+      //std::cout << " Seg mathced to propagated track: segment id "<<id <<" lp "<< (*segIt).localPosition() << " and targeted idCSC "<< idCSC <<" lp "<< muonlp <<" deltaR_local "<< deltaR_local <<std::endl;
+      //if (id.ring() == 4) std::cout <<"find CSC segment in ME1a! "<< std::endl;
+    }
+  }//loop over segments
+  return matched;
+
+}
+
+
+
+//////////////  Get the matching with CSC LCT...
+bool GEMCSCBendingAlgo::matchRecoMuonwithCSCLCT(const LocalPoint muonlp, edm::Handle<CSCCorrelatedLCTDigiCollection> cscLcts, CSCDetId idCSC, CSCCorrelatedLCTDigi &matchedLCT, LocalPoint &matchedlctlp, float &mindR){
+
+  float deltaCSCR = 9999.;
+  bool matched = false;
+  for (CSCCorrelatedLCTDigiCollection::DigiRangeIterator detUnitIt = cscLcts->begin(); 
+       detUnitIt != cscLcts->end(); detUnitIt++) {
+
+    CSCDetId id = (*detUnitIt).first;
+ 
+    
+    if(idCSC.endcap() != id.endcap())continue;
+    if(idCSC.station() != id.station())continue;
+    if(idCSC.chamber() != id.chamber())continue;
+      
+    Bool_t ed1 = (idCSC.station() == 1) && ((idCSC.ring() == 1 || idCSC.ring() == 4) && (id.ring() == 1 || id.ring() == 4));
+    Bool_t ed2 = (idCSC.station() == 1) && ((idCSC.ring() == 2 && id.ring() == 2) || (idCSC.ring() == 3 && id.ring() == 3));
+    Bool_t ed3 = (idCSC.station() != 1) && (idCSC.ring() == id.ring());
+    Bool_t TMCSCMatch = (ed1 || ed2 || ed3);
+    if(! TMCSCMatch)continue;
+    
+    const CSCCorrelatedLCTDigiCollection::Range& Lctrange = (*detUnitIt).second;
+    for (CSCCorrelatedLCTDigiCollection::const_iterator lctIt = Lctrange.first; lctIt != Lctrange.second; lctIt++) {
+      bool lct_valid = (*lctIt).isValid();
+      if(!lct_valid)continue;
+
+      int wireGroup_id = (*lctIt).getKeyWG()+1;
+      int strip_id=(*lctIt).getStrip()/2+1;
+      bool me11=(id.station() == 1) && (id.ring() == 1 || id.ring() == 4); 
+      bool  me11a = me11 && strip_id>64;
+      if ( me11a ) {
+        strip_id-=64;
+        id=CSCDetId(idCSC.endcap(), 1, 4, idCSC.chamber(), 3); //id for key layer
+      }
+      const CSCLayerGeometry *layerGeom = CSCGeometry_->chamber(id)->layer (3)->geometry ();
+      LocalPoint lctlp = layerGeom->stripWireGroupIntersection(strip_id, wireGroup_id);
+
+
+      const float dx = lctlp.x() - muonlp.x();
+      const float dy = lctlp.y() - muonlp.y();
+      float deltaR_local = std::sqrt(dx*dx + dy*dy);
+      //std::cout << " LCT mathced to TT: "<<id.endcap()<<" "<<id.station()<<" "<< id.chamber() << " and targeted idCSC "<< idCSC <<" deltaR_local "<< deltaR_local <<std::endl;
+     
+     
+      if ( deltaR_local < deltaCSCR  ){
+        matched = true;
+        deltaCSCR = deltaR_local;
+        mindR = deltaR_local;
+        matchedlctlp = lctlp;
+        matchedLCT = *lctIt;
+
+ 
+      }
+    }
+  }//loop over LCTs
+  return matched;
+
+}
+
+float GEMCSCBendingAlgo::getCenterStripNumber_float(float strip){
+
+    return matching::centerStripNumber(strip);
+
+}
+
+float GEMCSCBendingAlgo::getFlippedStripNumber(float strip){
+
+    if (not matching::validGEMStrip(strip))
+	edm::LogWarning("GEMCSCBendingAlgo") <<"strip number of a rechit out of range: strip "<< strip;
+    return matching::flippedStripNumber(strip);
+}
+
+void GEMCSCBendingAlgo::buildGEMHitIndex(const GEMRecHitCollection& gemRecHits, hitindex::Index<GEMRecHit>& index, bool flipped){
+
+    for (auto hit = gemRecHits.begin(); hit != gemRecHits.end(); hit++){
+	if ( (hit)->geographicalId().det() != DetId::Detector::Muon or (hit)->geographicalId().subdetId() != MuonSubdetId::GEM) continue;
+	GEMDetId gemid((hit)->geographicalId());
+	if (gemid.station() != 1) continue;
+	float x = hit->localPosition().x();
+	if (flipped and useGeometryCache_){
+	    const geomcache::Det det = geometryCache_.find(gemid.rawId());
+	    if (not det)
+		throw cms::Exception("GEMCSCBendingAlgo") <<"geometry cache has no GE11 eta partition "<< gemid <<" of a rechit";
+	    x = det.centreOfStrip(getFlippedStripNumber(det.strip(hit->localPosition().x(), hit->localPosition().y()))).x;
+	}
+	else if (flipped){
+	    const auto& etaPart = GEMGeometry_->etaPartition(gemid);
+	    x = etaPart->centreOfStrip(getFlippedStripNumber(etaPart->strip(hit->localPosition()))).x();
+	}
+	index[gemid.rawId()].add(x, hit->localPosition().y(), &*hit);
+    }
+    hitindex::sortAll(index);
+}
+
+void GEMCSCBendingAlgo::buildCSCHitIndex(const CSCRecHit2DCollection& cscRecHits, hitindex::Index<CSCRecHit2D>& index){
+
+    for (auto hit = cscRecHits.begin(); hit != cscRecHits.end(); hit++){
+	if ((hit)->geographicalId().det() != DetId::Detector::Muon or (hit)->geographicalId().subdetId() != MuonSubdetId::CSC) continue;
+	CSCDetId cscid((hit)->geographicalId());
+	//only ME11 rechits are matched
+	if (cscid.station() != 1 or (cscid.ring() != 1 and cscid.ring() != 4)) continue;
+	index[cscid.rawId()].add(hit->localPosition().x(), hit->localPosition().y(), &*hit);
+    }
+    hitindex::sortAll(index);
+}
+
+void GEMCSCBendingAlgo::propagateToSurface(const Propagator* const propagators[], const TrajectoryStateOnSurface states[], TrajectoryStateOnSurface tsos[], int n, const GeomDet& det, int station, float& propTime){
+
+    auto start = std::chrono::steady_clock::now();
+    propagateToSurfaceImpl(propagators, states, tsos, n, det, station);
+    propTime += std::chrono::duration<float, std::micro>(std::chrono::steady_clock::now() - start).count();
+}
+
+void GEMCSCBendingAlgo::propagateToSurfaceImpl(const Propagator* const propagators[], const TrajectoryStateOnSurface states[], TrajectoryStateOnSurface tsos[], int n, const GeomDet& det, int station){
+
+    const BoundPlane& surface = det.surface();
+    if (not (useFastPropagator_ or validateFastPropagator_)){
+	for (int i = 0; i < n; ++i)
+	    tsos[i] = states[i].isValid() ? propagators[i]->propagate(states[i], surface) : TrajectoryStateOnSurface();
+	return;
+    }
+
+    //surface and field setup, shared by all tracks of the batch
+    const GlobalVector B = surfaceField(det);
+    const GlobalVector normal = surface.normalVector();
+    const float b[3] = {B.x(), B.y(), B.z()};
+    const float planePos[3] = {surface.position().x(), surface.position().y(), surface.position().z()};
+    const float planeNormal[3] = {normal.x(), normal.y(), normal.z()};
+    const fasthelix::PlaneSetup setup = fasthelix::makePlaneSetup(b, planePos, planeNormal);
+    const MagneticField* field = &*theService_->magneticField();
+
+    for (int first = 0; first < n; first += kFastPropBatchSize){
+	const int last = std::min(n, first + kFastPropBatchSize);
+	fasthelix::TrackBatch<kFastPropBatchSize> batch;
+	int index[kFastPropBatchSize];
+	float momentum[kFastPropBatchSize];
+	for (int i = first; i < last; ++i){
+	    const TrajectoryStateOnSurface& state = states[i];
+	    bool fastPath = state.isValid() and state.globalMomentum().perp() > fastPropagatorMinPt_ and fabs(surface.localZ(state.globalPosition())) < fastPropagatorMaxDistance_;
+	    if (not fastPath){
+		tsos[i] = state.isValid() ? propagators[i]->propagate(state, surface) : TrajectoryStateOnSurface();
+		continue;
+	    }
+	    GlobalPoint gp = state.globalPosition();
+	    GlobalVector gv = state.globalMomentum();
+	    float p = gv.mag();
+	    const int k = batch.size++;
+	    batch.x[k] = gp.x(); batch.y[k] = gp.y(); batch.z[k] = gp.z();
+	    batch.tx[k] = gv.x()/p; batch.ty[k] = gv.y()/p; batch.tz[k] = gv.z()/p;
+	    batch.qoverp[k] = state.charge()/p;
+	    index[k] = i;
+	    momentum[k] = p;
+	}
+	if (batch.size == 0) continue;
+
+	fasthelix::propagateToPlane(batch, setup);
+
+	for (int k = 0; k < batch.size; ++k){
+	    const int i = index[k];
+	    TrajectoryStateOnSurface tsos_fast;
+	    if (batch.valid[k]){
+		const float p = momentum[k];
+		GlobalTrajectoryParameters gtp(GlobalPoint(batch.x[k], batch.y[k], batch.z[k]), GlobalVector(batch.tx[k]*p, batch.ty[k]*p, batch.tz[k]*p), states[i].charge(), field);
+		tsos_fast = TrajectoryStateOnSurface(gtp, surface);
+	    }
+	    if (validateFastPropagator_){
+		//keep the stepping result in the ntuple and only record the difference
+		tsos[i] = propagators[i]->propagate(states[i], surface);
+		if (tsos[i].isValid() and tsos_fast.isValid() and station >= 0){
+		    std::lock_guard<std::mutex> lock(fastPropHistMutex_);
+		    h_fastProp_dx_[station]->Fill(tsos_fast.localPosition().x() - tsos[i].localPosition().x());
+		    h_fastProp_dy_[station]->Fill(tsos_fast.localPosition().y() - tsos[i].localPosition().y());
+		}
+	    }
+	    else if (not tsos_fast.isValid())
+		tsos[i] = propagators[i]->propagate(states[i], surface);
+	    else
+		tsos[i] = tsos_fast;
+	}
+    }
+}
+
+void GEMCSCBendingAlgo::fillSurfaceFieldCache(){
+
+    //field is taken constant over the gap, evaluated at the destination surface
+    const MagneticField* field = &*theService_->magneticField();
+    surfaceField_.clear();
+    for (const auto& ch : GEMGeometry_->etaPartitions())
+	surfaceField_[ch->geographicalId().rawId()] = field->inTesla(ch->surface().position());
+    for (const auto& ch : CSCGeometry_->layers())
+	surfaceField_[ch->geographicalId().rawId()] = field->inTesla(ch->surface().position());
+}
+
+GlobalVector GEMCSCBendingAlgo::surfaceField(const GeomDet& det) const{
+
+    auto it = surfaceField_.find(det.geographicalId().rawId());
+    if (it != surfaceField_.end())
+	return it->second;
+    return theService_->magneticField()->inTesla(det.surface().position());
+}
+
+void GEMCSCBendingAlgo::checkGeometryCache() const{
+    //strip centres and a point off the centre line of every GE11 eta partition, cm
+    const float tolerance = 1e-3;
+    int nChecked = 0;
+    for (const auto& etaPart : GEMGeometry_->etaPartitions()){
+	if (etaPart->id().station() != 1) continue;
+	const geomcache::Det det = geometryCache_.find(etaPart->id().rawId());
+	if (not det)
+	    throw cms::Exception("GEMCSCBendingAlgo") <<"geometry cache has no GE11 eta partition "<< etaPart->id();
+	const GlobalPoint position = etaPart->surface().position();
+	const geomcache::GlobalPoint cached = det.toGlobal(0.0, 0.0);
+	bool same = det.nStrips() == etaPart->nstrips()
+	    and std::fabs(cached.x - position.x()) < tolerance and std::fabs(cached.y - position.y()) < tolerance and std::fabs(cached.z - position.z()) < tolerance;
+	for (float strip : {0.5f, etaPart->nstrips()/2.0f, etaPart->nstrips() - 0.5f}){
+	    const LocalPoint lp(etaPart->centreOfStrip(strip).x(), 0.5*etaPart->specificTopology().stripLength()*0.8);
+	    same = same and std::fabs(det.centreOfStrip(strip).x - etaPart->centreOfStrip(strip).x()) < tolerance
+		and std::fabs(det.strip(lp.x(), lp.y()) - etaPart->strip(lp)) < tolerance;
+	}
+	if (not same)
+	    throw cms::Exception("GEMCSCBendingAlgo") <<"geometry cache differs from the event setup geometry for "<< etaPart->id()
+						      <<", rewrite it with GEMCSCGeometryCacheWriter";
+	nChecked++;
+    }
+    edm::LogInfo("GEMCSCBendingAlgo") <<"geometry cache agrees with the event setup geometry for "<< nChecked <<" GE11 eta partitions";
+}
+
+void GEMCSCBendingAlgo::printSummary(const std::string& module) const{
+  std::cout << module <<" propagators: standalone "<< standalonePropagator_ <<" global "<< globalPropagator_ <<" inner "<< innerPropagator_
+	    <<(useFastPropagator_ ? " with fast helix path" : "")
+	    <<", muons "<< nPropMuons_ <<" mean propagation time per muon "<< (nPropMuons_ > 0 ? totalPropTime_/nPropMuons_ : 0.0) <<" us"<< std::endl;
+  if (allocationcounter::available())
+      std::cout << module <<" allocations per event "<< (nEvents_ > 0 ? double(totalAllocations_)/nEvents_ : 0.0)
+		<<", bytes per event "<< (nEvents_ > 0 ? double(totalAllocatedBytes_)/nEvents_ : 0.0) <<" over "<< nEvents_ <<" events"<< std::endl;
+  else
+      std::cout << module <<" allocations: counter not preloaded (bin/gemcscAllocationCounter.cc)"<< std::endl;
+}
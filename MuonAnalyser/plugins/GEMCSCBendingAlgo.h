@@ -0,0 +1,238 @@
+#ifndef GEMCSCBendingAnalyzer_MuonAnalyser_GEMCSCBendingAlgo_h
+#define GEMCSCBendingAnalyzer_MuonAnalyser_GEMCSCBendingAlgo_h
+
+// Per muon GE1/1 - ME1/1 matching: propagates the standalone, global and inner tracks
+// to GE1/1 and the CSC layers, matches GEM/CSC rechits, segments and LCTs and computes
+// the bending angles. Shared by SliceTestAnalysis (ntuple) and GEMCSCBendingProducer (EDM product).
+
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "FWCore/Framework/interface/Frameworkfwd.h"
+#include "FWCore/Framework/interface/ConsumesCollector.h"
+#include "FWCore/Framework/interface/ESHandle.h"
+#include "FWCore/Framework/interface/ESWatcher.h"
+#include "FWCore/ParameterSet/interface/ParameterSet.h"
+#include "FWCore/Utilities/interface/InputTag.h"
+#include "DataFormats/Common/interface/View.h"
+#include "DataFormats/Common/interface/ValueMap.h"
+
+#include "RecoMuon/TrackingTools/interface/MuonServiceProxy.h"
+#include "MagneticField/Records/interface/IdealMagneticFieldRecord.h"
+#include "Geometry/Records/interface/MuonGeometryRecord.h"
+#include "TrackingTools/GeomPropagators/interface/Propagator.h"
+#include "TrackingTools/TrajectoryState/interface/TrajectoryStateOnSurface.h"
+
+#include "DataFormats/MuonReco/interface/Muon.h"
+#include "DataFormats/CSCRecHit/interface/CSCRecHit2D.h"
+#include "DataFormats/CSCRecHit/interface/CSCSegmentCollection.h"
+#include <DataFormats/CSCDigi/interface/CSCCorrelatedLCTDigiCollection.h>
+#include <DataFormats/CSCDigi/interface/CSCCorrelatedLCTDigi.h>
+#include "DataFormats/GEMRecHit/interface/GEMRecHitCollection.h"
+#include "Geometry/CSCGeometry/interface/CSCGeometry.h"
+#include "Geometry/GEMGeometry/interface/GEMGeometry.h"
+
+#include "GEMCSCBendingAnalyzer/MuonAnalyser/interface/MuonCandidates.h"
+#include "GEMCSCBendingAnalyzer/MuonAnalyser/interface/MuonSummary.h"
+#include "GEMAlignmentTable.h"
+#include "MuonData.h"
+#include "GEMCSCBendingAnalyzer/MuonAnalyser/interface/ResidualKernel.h"
+#include "GEMCSCBendingAnalyzer/MuonAnalyser/interface/SortedHitIndex.h"
+#include "GEMCSCBendingAnalyzer/MuonAnalyser/interface/GeometryCache.h"
+
+#include "tbb/enumerable_thread_specific.h"
+
+#include "TH1D.h"
+
+class GEMCSCBendingAlgo {
+public:
+  GEMCSCBendingAlgo(const edm::ParameterSet& iConfig, edm::ConsumesCollector&& iC);
+  ~GEMCSCBendingAlgo();
+
+  //collection sizes and stage timings of one event
+  struct EventStats {
+    int nMuons, nSelectedMuons;
+    int nGEMRecHits, nCSCRecHits, nCSCSegments, nLCTs;//-1 if the collection is not read
+    float t_setup;      //us, event setup and propagators
+    float t_inputs;     //us, collections and hit indices
+    float t_muons;      //us, muon selection and matching
+    float t_propagation;//us, summed over muons, part of t_muons
+    long long nAllocations, allocatedBytes;//operator new calls and bytes in run(), -1 without the allocation counter
+  };
+
+  //selects endcap muons of the event and fills their data
+  //selected: indices in muons, muonData: one entry per selected muon, in collection order
+  //candidates: if given, one record per selected muon with all hits within candidateWindow
+  //stats: if given, filled for the event
+  void run(const edm::Event& iEvent, const edm::EventSetup& iSetup, const edm::View<reco::Muon>& muons,
+	   std::vector<size_t>& selected, std::vector<MuonData>& muonData, std::vector<MuonCandidates>* candidates = nullptr,
+	   EventStats* stats = nullptr);
+
+  //propagation time summary, printed at endJob by the owning module
+  void printSummary(const std::string& module) const;
+  //names of the alignment hypotheses, in the order of the hyp_ columns of MuonData
+  std::vector<std::string> hypothesisNames() const;
+
+private:
+  //per-event inputs shared by all muons
+  struct EventInputs {
+    edm::Handle<GEMRecHitCollection> gemRecHits;
+    edm::Handle<CSCRecHit2DCollection> cscRecHits;
+    edm::Handle<CSCSegmentCollection> cscSegments;
+    edm::Handle<CSCCorrelatedLCTDigiCollection> cscLcts;
+    bool hasCSCRechitcollection;
+    bool hasLCTcollection;
+    //GE11 rechits per eta partition and ME11 rechits per layer, sorted by local x
+    const hitindex::Index<GEMRecHit>* gemHits;
+    const hitindex::Index<CSCRecHit2D>* cscHits;
+    //GE11 rechits with the other strip ordering, only built if a hypothesis needs it
+    const hitindex::Index<GEMRecHit>* gemHitsOtherFlip;
+  };
+  //one named alignment/strip ordering hypothesis, evaluated on the same propagations as the nominal one
+  struct AlignmentHypothesis {
+    std::string name;
+    bool flipped;
+    GEMAlignmentTable alignment;
+  };
+  //standalone, global and inner track propagators
+  struct TrackPropagators {
+    const Propagator* sta;
+    const Propagator* gt;
+    const Propagator* inner;
+  };
+  //propagators are not reentrant, concurrent tasks work on copies owned by their thread,
+  //cloned again when the propagators of the event setup change (generation)
+  struct ThreadPropagators {
+    unsigned long generation = 0;
+    std::unique_ptr<Propagator> sta, gt, inner;
+  };
+  //per event containers kept between events so that their memory is reused,
+  //the owning modules are legacy modules and see one event at a time
+  struct EventScratch {
+    hitindex::Index<GEMRecHit> gemHits;
+    hitindex::Index<GEMRecHit> gemHitsOtherFlip;
+    hitindex::Index<CSCRecHit2D> cscHits;
+    std::vector<const reco::Muon*> selectedMuons;
+    std::vector<const MuonSummary*> selectedSummaries;
+  };
+  //starting states of the three track types of one muon
+  struct MuonStates {
+    const reco::Muon* mu;
+    const reco::Track* muonTrack;
+    TrajectoryStateOnSurface sta;
+    TrajectoryStateOnSurface gt;
+    TrajectoryStateOnSurface inner;
+  };
+
+  void fillMuonData(MuonData& data, MuonCandidates* candidates, const edm::Event& iEvent, const reco::Muon* mu, const MuonSummary& summary, const EventInputs& inputs, const TrackPropagators& propagators);
+  //GE11 and CSC blocks only write their own part of MuonData (and MuonCandidates, if not null) and can run concurrently
+  //copies of propagators for the calling thread
+  TrackPropagators threadPropagators(const TrackPropagators& propagators);
+  void propagateToGE11(MuonData& data, MuonCandidates* candidates, const MuonStates& states, const EventInputs& inputs, const TrackPropagators& propagators, float& propTime);
+  void propagateToCSC(MuonData& data, MuonCandidates* candidates, const MuonStates& states, const EventInputs& inputs, const TrackPropagators& propagators, float& propTime);
+  //GE11 rechits within candidateWindow_ of the propagation to eta partition ch, ME11 rechits within candidateWindow_ of the one to layer ch
+  void storeGE11Candidates(MuonCandidates& candidates, const GEMEtaPartition* ch, const residuals::Extrapolations& prop, const GlobalPoint& tsosGP, const EventInputs& inputs);
+  void storeME11Candidates(MuonCandidates& candidates, const CSCLayer* ch, const residuals::Extrapolations& prop, const GlobalPoint& tsosGP, const EventInputs& inputs);
+  //GE11-ME11 bending angles, needs both blocks
+  void fillGE11ME11Bending(MuonData& data);
+  //nearest hit and residuals of every hypothesis in one GE11 layer, from the propagations to eta partition ch
+  void evaluateHypotheses(MuonData& data, const GEMEtaPartition* ch, const residuals::Extrapolations& prop, const GlobalPoint& tsosGP, const EventInputs& inputs);
+
+  //match LCT to recoMuon
+  bool matchRecoMuonwithCSCLCT(const LocalPoint muonlp, edm::Handle<CSCCorrelatedLCTDigiCollection> lcts, CSCDetId cscid, CSCCorrelatedLCTDigi &matchedLCT,LocalPoint &matchedlctlp, float &mindR);
+  //match CSC seg to recoMuon
+  bool matchRecoMuonwithCSCSeg(const LocalPoint muonlp, edm::Handle<CSCSegmentCollection> cscSegments, CSCDetId cscid, CSCSegment &matchedSeg, float &mindR);
+
+  //get float strip number of one strip centre,like 0.5, 1.5
+  float getCenterStripNumber_float(float strip);
+  //strip number with the reversed strip ordering of the slice test chambers
+  float getFlippedStripNumber(float strip);
+
+  //per-event sorted hit arrays, GEM hits are keyed by local x with flipped strips if flipped
+  void buildGEMHitIndex(const GEMRecHitCollection& gemRecHits, hitindex::Index<GEMRecHit>& index, bool flipped);
+  void buildCSCHitIndex(const CSCRecHit2DCollection& cscRecHits, hitindex::Index<CSCRecHit2D>& index);
+
+  //propagate n states to the surface of det, state i with propagators[i], results in tsos[i]
+  //the analytic helix is used for short extrapolations of high pT tracks, all of them go as one batch
+  //and share the surface/field setup, so the three track types or several muons cost one setup
+  //station: 0 for GE11, 1 for ME11, -1 otherwise; only used to fill validation histograms
+  //propTime is incremented by the time spent here, us
+  void propagateToSurface(const Propagator* const propagators[], const TrajectoryStateOnSurface states[], TrajectoryStateOnSurface tsos[], int n, const GeomDet& det, int station, float& propTime);
+  void propagateToSurfaceImpl(const Propagator* const propagators[], const TrajectoryStateOnSurface states[], TrajectoryStateOnSurface tsos[], int n, const GeomDet& det, int station);
+  //field at the centre of GE11 eta partitions and CSC layers, rebuilt when the field or the muon geometry changes
+  void fillSurfaceFieldCache();
+  GlobalVector surfaceField(const GeomDet& det) const;
+  //GE11 strip lookups of the geometry cache compared to the event setup geometry, throws if they differ
+  void checkGeometryCache() const;
+
+  // ----------member data ---------------------------
+  edm::EDGetTokenT<GEMRecHitCollection> gemRecHits_;
+  edm::EDGetTokenT<CSCRecHit2DCollection> cscRecHits_;
+  edm::EDGetTokenT<CSCSegmentCollection> cscSegments_;
+  edm::EDGetTokenT<CSCCorrelatedLCTDigiCollection> csclcts_;
+  edm::EDGetTokenT<edm::ValueMap<MuonSummary> > muonSummary_;
+
+  MuonServiceProxy* theService_;
+
+  edm::ESHandle<CSCGeometry> CSCGeometry_;
+  edm::ESHandle<GEMGeometry> GEMGeometry_;
+
+  double maxMuonEta_, minMuonEta_;
+  bool matchMuonwithLCT_;
+  bool matchMuonwithCSCRechit_;
+
+  //find it out later
+  float GEMRechit_muon_deltaR_;//cm
+  float GEMRechit_muon_deltaX_;//cm
+  float CSCRechit_muon_deltaR_;  //cm
+  float CSCSegment_muon_deltaR_; //cm
+  float CSCLCT_muon_deltaR_;     //cm
+  float candidateWindow_;        //cm, hits stored for re-matching
+
+  //GEM alignment correction
+  bool applyGEMalignment_ = false;
+  GEMAlignmentTable alignment_;
+  bool flippedGEMStrip_ = false;
+  std::vector<AlignmentHypothesis> hypotheses_;
+
+  //analytic helix fast path, stepping propagator used below minPt or beyond maxDistance
+  bool useFastPropagator_ = false;
+  bool validateFastPropagator_ = false;
+  float fastPropagatorMinPt_;      //GeV
+  float fastPropagatorMaxDistance_;//cm
+  //propagator names from MuonServiceProxy, per track type
+  std::string standalonePropagator_;
+  std::string globalPropagator_;
+  std::string innerPropagator_;
+  //propagation time summary
+  double totalPropTime_ = 0.0;//us
+  unsigned long nPropMuons_ = 0;
+  //allocations in run(), with the preloaded allocation counter only
+  unsigned long nEvents_ = 0;
+  unsigned long long totalAllocations_ = 0;
+  unsigned long long totalAllocatedBytes_ = 0;
+  //residuals fast - stepping propagator, [0] GE11, [1] ME11
+  TH1D* h_fastProp_dx_[2];
+  TH1D* h_fastProp_dy_[2];
+  std::mutex fastPropHistMutex_;
+  //maximum number of tracks propagated in one fast helix batch
+  static constexpr int kFastPropBatchSize = 8;
+  std::unordered_map<uint32_t, GlobalVector> surfaceField_;
+  edm::ESWatcher<IdealMagneticFieldRecord> surfaceFieldWatcher_;
+  edm::ESWatcher<MuonGeometryRecord> surfaceGeometryWatcher_;
+  //GE11/ME11 geometry cache (GEMCSCGeometryCacheWriter) for the per hit strip lookups, checked when the geometry changes
+  bool useGeometryCache_ = false;
+  geomcache::GeometryCache geometryCache_;
+  unsigned long long geometryCacheCheckId_ = 0;
+  //run GE11 and CSC blocks, and muons of one event, as concurrent tasks
+  bool concurrentPropagation_ = false;
+  tbb::enumerable_thread_specific<ThreadPropagators> threadPropagators_;
+  TrackPropagators lastPropagators_ = {nullptr, nullptr, nullptr};
+  unsigned long propagatorGeneration_ = 0;
+  EventScratch scratch_;
+};
+
+#endif
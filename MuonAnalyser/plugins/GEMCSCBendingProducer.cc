@@ -0,0 +1,81 @@
+// Runs the GE1/1 - ME1/1 matching of SliceTestAnalysis and stores the result per muon
+// as edm::ValueMap<GEMCSCBending> keyed to the input muon collection.
+// Muons failing the selection get a default entry with valid = false.
+
+// system include files
+#include <memory>
+#include <iostream>
+
+// user include files
+#include "FWCore/Framework/interface/Frameworkfwd.h"
+#include "FWCore/Framework/interface/EDProducer.h"
+
+#include "FWCore/Framework/interface/Event.h"
+#include "FWCore/Framework/interface/MakerMacros.h"
+
+#include "FWCore/ParameterSet/interface/ParameterSet.h"
+
+#include "DataFormats/Common/interface/View.h"
+#include "DataFormats/Common/interface/ValueMap.h"
+#include "DataFormats/MuonReco/interface/Muon.h"
+
+#include "GEMCSCBendingAnalyzer/MuonAnalyser/interface/GEMCSCBending.h"
+#include "GEMCSCBendingAlgo.h"
+#include "MuonData.h"
+
+using namespace std;
+using namespace edm;
+
+class GEMCSCBendingProducer : public edm::EDProducer {
+public:
+  explicit GEMCSCBendingProducer(const edm::ParameterSet&);
+  ~GEMCSCBendingProducer(){};
+
+private:
+  virtual void produce(edm::Event&, const edm::EventSetup&);
+  virtual void endJob() ;
+
+  // ----------member data ---------------------------
+  edm::EDGetTokenT<edm::View<reco::Muon> > muons_;
+  std::unique_ptr<GEMCSCBendingAlgo> algo_;
+  //per event results of the algo, kept to reuse their memory
+  std::vector<size_t> selected_;
+  std::vector<MuonData> muonData_;
+};
+
+GEMCSCBendingProducer::GEMCSCBendingProducer(const edm::ParameterSet& iConfig)
+{
+  muons_ = consumes<View<reco::Muon> >(iConfig.getParameter<InputTag>("muons"));
+  algo_ = std::make_unique<GEMCSCBendingAlgo>(iConfig, consumesCollector());
+
+  produces<edm::ValueMap<GEMCSCBending> >();
+}
+
+void
+GEMCSCBendingProducer::produce(edm::Event& iEvent, const edm::EventSetup& iSetup)
+{
+  edm::Handle<View<reco::Muon> > muons;
+  iEvent.getByToken(muons_, muons);
+
+  std::vector<size_t>& selected = selected_;
+  std::vector<MuonData>& muonData = muonData_;
+  algo_->run(iEvent, iSetup, *muons, selected, muonData);
+
+  //one entry per muon, in collection order
+  std::vector<GEMCSCBending> bendings(muons->size());
+  for (size_t i = 0; i < selected.size(); ++i)
+      muonData[i].fillBending(bendings[selected[i]]);
+
+  auto out = std::make_unique<edm::ValueMap<GEMCSCBending> >();
+  edm::ValueMap<GEMCSCBending>::Filler filler(*out);
+  filler.insert(muons, bendings.begin(), bendings.end());
+  filler.fill();
+  iEvent.put(std::move(out));
+}
+
+void GEMCSCBendingProducer::endJob(){
+  algo_->printSummary("GEMCSCBendingProducer");
+}
+
+//define this as a plug-in
+DEFINE_FWK_MODULE(GEMCSCBendingProducer);
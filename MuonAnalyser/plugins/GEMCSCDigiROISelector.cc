@@ -0,0 +1,174 @@
+// GEM and CSC strip/wire digis of the GE1/1 and ME1/1 chambers that reconstructed muons point to,
+// as input of a regional local reconstruction (gemRecHits, csc2DRecHits, cscSegments on these digis),
+// see test/runRAW2DIGI_ROI_Ana.py. Chambers are taken whole, a muon selects a chamber if its
+// straight line (MuonROI.h) crosses the chamber plane within margin of the chamber bounds.
+// The muons must be in the input (RAW-RECO), RAW-only input is refused.
+// Outputs have the instance labels of the unpackers: "" for GEM, MuonCSCStripDigi and MuonCSCWireDigi.
+
+#include <atomic>
+#include <cmath>
+#include <iostream>
+#include <memory>
+#include <set>
+
+#include "FWCore/Framework/interface/Frameworkfwd.h"
+#include "FWCore/Framework/interface/global/EDProducer.h"
+
+#include "FWCore/Framework/interface/Event.h"
+#include "FWCore/Framework/interface/EventSetup.h"
+#include "FWCore/Framework/interface/ESHandle.h"
+#include "FWCore/Framework/interface/MakerMacros.h"
+
+#include "FWCore/ParameterSet/interface/ParameterSet.h"
+#include "FWCore/Utilities/interface/Exception.h"
+#include "DataFormats/Common/interface/View.h"
+#include "DataFormats/MuonReco/interface/Muon.h"
+#include "DataFormats/GEMDigi/interface/GEMDigiCollection.h"
+#include "DataFormats/CSCDigi/interface/CSCStripDigiCollection.h"
+#include "DataFormats/CSCDigi/interface/CSCWireDigiCollection.h"
+#include "Geometry/Records/interface/MuonGeometryRecord.h"
+#include "Geometry/GEMGeometry/interface/GEMGeometry.h"
+#include "Geometry/CSCGeometry/interface/CSCGeometry.h"
+
+#include "MuonROI.h"
+
+class GEMCSCDigiROISelector : public edm::global::EDProducer<> {
+public:
+  explicit GEMCSCDigiROISelector(const edm::ParameterSet&);
+  ~GEMCSCDigiROISelector(){};
+
+private:
+  void produce(edm::StreamID, edm::Event&, const edm::EventSetup&) const override;
+  void endJob() override;
+
+  //ME1/a and ME1/b as one chamber
+  static CSCDetId chamberKey(const CSCDetId& id) { return CSCDetId(id.endcap(), id.station(), id.ring() == 4 ? 1 : id.ring(), id.chamber(), 0); }
+
+  template <class Collection, class Id>
+  static std::unique_ptr<Collection> select(const Collection& digis, const std::set<Id>& chambers, Id (*key)(const Id&), unsigned long& nKept);
+
+  edm::EDGetTokenT<edm::View<reco::Muon> > muons_;
+  edm::EDGetTokenT<GEMDigiCollection> gemDigis_;
+  edm::EDGetTokenT<CSCStripDigiCollection> cscStripDigis_;
+  edm::EDGetTokenT<CSCWireDigiCollection> cscWireDigis_;
+  double minMuonPt_;
+  double minMuonEta_, maxMuonEta_;
+  float margin_;//cm
+
+  mutable std::atomic<unsigned long> nEvents_{0};
+  mutable std::atomic<unsigned long> nGEMChambers_{0}, nCSCChambers_{0};
+  mutable std::atomic<unsigned long> nGEMDigis_{0}, nGEMDigisKept_{0};
+  mutable std::atomic<unsigned long> nCSCDigis_{0}, nCSCDigisKept_{0};
+};
+
+GEMCSCDigiROISelector::GEMCSCDigiROISelector(const edm::ParameterSet& iConfig)
+{
+  muons_ = consumes<edm::View<reco::Muon> >(iConfig.getParameter<edm::InputTag>("muons"));
+  gemDigis_ = consumes<GEMDigiCollection>(iConfig.getParameter<edm::InputTag>("gemDigis"));
+  cscStripDigis_ = consumes<CSCStripDigiCollection>(iConfig.getParameter<edm::InputTag>("cscStripDigis"));
+  cscWireDigis_ = consumes<CSCWireDigiCollection>(iConfig.getParameter<edm::InputTag>("cscWireDigis"));
+  minMuonPt_ = iConfig.getUntrackedParameter<double>("minMuonPt", 2.0);
+  minMuonEta_ = iConfig.getUntrackedParameter<double>("minMuonEta", 1.4);
+  maxMuonEta_ = iConfig.getUntrackedParameter<double>("maxMuonEta", 2.5);
+  margin_ = iConfig.getUntrackedParameter<double>("margin", 20.0);
+
+  produces<GEMDigiCollection>();
+  produces<CSCStripDigiCollection>("MuonCSCStripDigi");
+  produces<CSCWireDigiCollection>("MuonCSCWireDigi");
+}
+
+template <class Collection, class Id>
+std::unique_ptr<Collection>
+GEMCSCDigiROISelector::select(const Collection& digis, const std::set<Id>& chambers, Id (*key)(const Id&), unsigned long& nKept)
+{
+  auto out = std::make_unique<Collection>();
+  for (auto detUnit = digis.begin(); detUnit != digis.end(); ++detUnit){
+    const auto& range = (*detUnit).second;
+    if (chambers.count(key((*detUnit).first)) == 0) continue;
+    out->put(range, (*detUnit).first);
+    nKept += range.second - range.first;
+  }
+  return out;
+}
+
+namespace {
+  GEMDetId gemChamberKey(const GEMDetId& id) { return id.chamberId(); }
+  template <class Collection>
+  unsigned long countDigis(const Collection& digis) {
+    unsigned long n = 0;
+    for (auto detUnit = digis.begin(); detUnit != digis.end(); ++detUnit)
+      n += (*detUnit).second.second - (*detUnit).second.first;
+    return n;
+  }
+}
+
+void
+GEMCSCDigiROISelector::produce(edm::StreamID, edm::Event& iEvent, const edm::EventSetup& iSetup) const
+{
+  edm::Handle<edm::View<reco::Muon> > muons;
+  iEvent.getByToken(muons_, muons);
+  //the muons come from the RECO part of the input, there is no muon reconstruction in the ROI workflow
+  if (not muons.isValid())
+    throw cms::Exception("GEMCSCDigiROISelector") <<"no muons in the input: the regional reconstruction needs RAW-RECO input, "
+						<<"use runRAW2DIGI_RECO_Ana.py for RAW-only input";
+  edm::Handle<GEMDigiCollection> gemDigis;
+  iEvent.getByToken(gemDigis_, gemDigis);
+  edm::Handle<CSCStripDigiCollection> cscStripDigis;
+  iEvent.getByToken(cscStripDigis_, cscStripDigis);
+  edm::Handle<CSCWireDigiCollection> cscWireDigis;
+  iEvent.getByToken(cscWireDigis_, cscWireDigis);
+
+  edm::ESHandle<GEMGeometry> gemGeometry;
+  iSetup.get<MuonGeometryRecord>().get(gemGeometry);
+  edm::ESHandle<CSCGeometry> cscGeometry;
+  iSetup.get<MuonGeometryRecord>().get(cscGeometry);
+
+  //chambers pointed to by the selected muons
+  std::set<GEMDetId> gemChambers;
+  std::set<CSCDetId> cscChambers;
+  for (const auto& mu : *muons){
+    if (mu.pt() < minMuonPt_ or std::fabs(mu.eta()) < minMuonEta_ or std::fabs(mu.eta()) > maxMuonEta_) continue;
+    if (not mu.standAloneMuon()) continue;
+    const muonroi::Line line = muonroi::muonLine(mu);
+    LocalPoint lp;
+    for (const auto& chamber : gemGeometry->chambers()){
+      const GEMDetId id = chamber->id();
+      if (id.station() != 1 or id.region()*mu.eta() < 0) continue;
+      if (muonroi::crossing(line, *chamber, lp) and muonroi::nearDet(lp, *chamber, margin_))
+	gemChambers.insert(id.chamberId());
+    }
+    for (const auto& chamber : cscGeometry->chambers()){
+      const CSCDetId id = chamber->id();
+      if (id.station() != 1 or (id.ring() != 1 and id.ring() != 4) or (id.endcap() == 1) != (mu.eta() > 0)) continue;
+      if (muonroi::crossing(line, *chamber, lp) and muonroi::nearDet(lp, *chamber, margin_))
+	cscChambers.insert(chamberKey(id));
+    }
+  }
+
+  unsigned long nGEMKept = 0, nCSCKept = 0;
+  auto gemOut = select(*gemDigis, gemChambers, &gemChamberKey, nGEMKept);
+  auto stripOut = select(*cscStripDigis, cscChambers, &GEMCSCDigiROISelector::chamberKey, nCSCKept);
+  auto wireOut = select(*cscWireDigis, cscChambers, &GEMCSCDigiROISelector::chamberKey, nCSCKept);
+
+  nEvents_++;
+  nGEMChambers_ += gemChambers.size();
+  nCSCChambers_ += cscChambers.size();
+  nGEMDigis_ += countDigis(*gemDigis);
+  nGEMDigisKept_ += nGEMKept;
+  nCSCDigis_ += countDigis(*cscStripDigis) + countDigis(*cscWireDigis);
+  nCSCDigisKept_ += nCSCKept;
+
+  iEvent.put(std::move(gemOut));
+  iEvent.put(std::move(stripOut), "MuonCSCStripDigi");
+  iEvent.put(std::move(wireOut), "MuonCSCWireDigi");
+}
+
+void GEMCSCDigiROISelector::endJob(){
+  const unsigned long n = nEvents_;
+  std::cout <<"GEMCSCDigiROISelector: "<< n <<" events, GE11 chambers per event "<< (n > 0 ? double(nGEMChambers_)/n : 0.0)
+	    <<", ME11 chambers per event "<< (n > 0 ? double(nCSCChambers_)/n : 0.0)
+	    <<", GEM digis kept "<< nGEMDigisKept_ <<" / "<< nGEMDigis_ <<", CSC strip and wire digis kept "<< nCSCDigisKept_ <<" / "<< nCSCDigis_ << std::endl;
+}
+
+//define this as a plug-in
+DEFINE_FWK_MODULE(GEMCSCDigiROISelector);
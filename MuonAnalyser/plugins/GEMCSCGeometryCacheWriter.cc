@@ -0,0 +1,163 @@
+// Writes the GE1/1 eta partitions and ME1/1 layers of the event setup geometry to the binary
+// cache of interface/GeometryCache.h, once, at the first run. See test/runGeometryCacheWriter.py.
+
+// system include files
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <vector>
+
+// user include files
+#include "FWCore/Framework/interface/Frameworkfwd.h"
+#include "FWCore/Framework/interface/EDAnalyzer.h"
+
+#include "FWCore/Framework/interface/Event.h"
+#include "FWCore/Framework/interface/Run.h"
+#include "FWCore/Framework/interface/EventSetup.h"
+#include "FWCore/Framework/interface/ESHandle.h"
+#include "FWCore/Framework/interface/MakerMacros.h"
+#include "FWCore/ParameterSet/interface/ParameterSet.h"
+#include "FWCore/Utilities/interface/Exception.h"
+
+#include "Geometry/Records/interface/MuonGeometryRecord.h"
+#include "Geometry/GEMGeometry/interface/GEMGeometry.h"
+#include "Geometry/CSCGeometry/interface/CSCGeometry.h"
+#include "Geometry/CSCGeometry/interface/CSCLayerGeometry.h"
+#include "Geometry/CommonTopologies/interface/StripTopology.h"
+#include "DataFormats/GeometrySurface/interface/TrapezoidalPlaneBounds.h"
+
+#include "GEMCSCBendingAnalyzer/MuonAnalyser/interface/GeometryCache.h"
+
+class GEMCSCGeometryCacheWriter : public edm::EDAnalyzer {
+public:
+  explicit GEMCSCGeometryCacheWriter(const edm::ParameterSet&);
+  ~GEMCSCGeometryCacheWriter(){};
+
+private:
+  virtual void beginRun(const edm::Run&, const edm::EventSetup&);
+  virtual void analyze(const edm::Event&, const edm::EventSetup&) {}
+
+  //surface, bounds and strips shared by both detector types
+  geomcache::DetRecord fillDet(const GeomDet& det, const StripTopology& topology, uint32_t type);
+
+  std::string fileName_;
+  bool written_ = false;
+  std::vector<geomcache::DetRecord> dets_;
+  std::vector<float> data_;
+};
+
+GEMCSCGeometryCacheWriter::GEMCSCGeometryCacheWriter(const edm::ParameterSet& iConfig)
+{
+  fileName_ = iConfig.getUntrackedParameter<std::string>("fileName", "GE11ME11Geometry.bin");
+}
+
+geomcache::DetRecord
+GEMCSCGeometryCacheWriter::fillDet(const GeomDet& det, const StripTopology& topology, uint32_t type)
+{
+  geomcache::DetRecord r;
+  std::memset(&r, 0, sizeof(r));
+  r.rawId = det.geographicalId().rawId();
+  r.type = type;
+
+  const BoundPlane& surface = det.surface();
+  r.position[0] = surface.position().x();
+  r.position[1] = surface.position().y();
+  r.position[2] = surface.position().z();
+  const auto& R = surface.rotation();
+  const float rotation[9] = {R.xx(), R.xy(), R.xz(), R.yx(), R.yy(), R.yz(), R.zx(), R.zy(), R.zz()};
+  std::copy(rotation, rotation+9, r.rotation);
+
+  const TrapezoidalPlaneBounds* trapezoid = dynamic_cast<const TrapezoidalPlaneBounds*>(&surface.bounds());
+  if (trapezoid){
+    //half bottom edge, half top edge, half thickness, apothem
+    const auto parameters = trapezoid->parameters();
+    r.halfWidthBottom = parameters[0];
+    r.halfWidthTop = parameters[1];
+    r.halfThickness = parameters[2];
+    r.halfLength = parameters[3];
+  }
+  else {
+    r.halfWidthBottom = r.halfWidthTop = surface.bounds().width()/2;
+    r.halfLength = surface.bounds().length()/2;
+    r.halfThickness = surface.bounds().thickness()/2;
+  }
+
+  const int n = topology.nstrips();
+  r.nStrips = n;
+  r.stripEdgeX = data_.size();
+  for (int e = 0; e <= n; ++e)
+    data_.push_back(topology.localPosition(float(e)).x());
+  r.stripEdgeAngle = data_.size();
+  for (int e = 0; e <= n; ++e)
+    data_.push_back(topology.stripAngle(float(e)));
+
+  //apex: crossing of the first and last strip edges, each through its ends
+  const LocalPoint a1 = topology.localPosition(MeasurementPoint(0.0, -0.5)), a2 = topology.localPosition(MeasurementPoint(0.0, 0.5));
+  const LocalPoint b1 = topology.localPosition(MeasurementPoint(float(n), -0.5)), b2 = topology.localPosition(MeasurementPoint(float(n), 0.5));
+  const float da = (a2.x() - a1.x())/(a2.y() - a1.y()), db = (b2.x() - b1.x())/(b2.y() - b1.y());
+  if (std::fabs(da - db) > 1e-7){
+    //x = a1.x + da (y - a1.y) = b1.x + db (y - b1.y)
+    r.apexY = (b1.x() - a1.x() + da*a1.y() - db*b1.y())/(da - db);
+    r.apexX = a1.x() + da*(r.apexY - a1.y());
+  }
+  return r;
+}
+
+void
+GEMCSCGeometryCacheWriter::beginRun(const edm::Run& run, const edm::EventSetup& iSetup)
+{
+  if (written_) return;
+
+  edm::ESHandle<GEMGeometry> gemGeometry;
+  iSetup.get<MuonGeometryRecord>().get(gemGeometry);
+  edm::ESHandle<CSCGeometry> cscGeometry;
+  iSetup.get<MuonGeometryRecord>().get(cscGeometry);
+
+  int nGEM = 0, nCSC = 0;
+  for (const auto& etaPart : gemGeometry->etaPartitions()){
+    if (etaPart->id().station() != 1) continue;
+    dets_.push_back(fillDet(*etaPart, etaPart->specificTopology(), geomcache::kGE11Roll));
+    nGEM++;
+  }
+  for (const auto& layer : cscGeometry->layers()){
+    const CSCDetId id = layer->id();
+    if (id.station() != 1 or (id.ring() != 1 and id.ring() != 4)) continue;
+    const CSCLayerGeometry* layerGeom = layer->geometry();
+    geomcache::DetRecord r = fillDet(*layer, *layerGeom->topology(), geomcache::kME11Layer);
+    r.nWireGroups = layerGeom->numberOfWireGroups();
+    r.wireGroupY = data_.size();
+    for (int wg = 1; wg <= int(r.nWireGroups); ++wg)
+      data_.push_back(layerGeom->yOfWireGroup(wg, 0.));
+    if (r.nWireGroups > 0)
+      r.wireSlope = (layerGeom->yOfWireGroup(1, 10.) - layerGeom->yOfWireGroup(1, -10.))/20.;
+    dets_.push_back(r);
+    nCSC++;
+  }
+  std::sort(dets_.begin(), dets_.end(), [](const geomcache::DetRecord& a, const geomcache::DetRecord& b){ return a.rawId < b.rawId; });
+
+  geomcache::FileHeader header;
+  std::memset(&header, 0, sizeof(header));
+  std::memcpy(header.magic, geomcache::kMagic, sizeof(header.magic));
+  header.version = geomcache::kVersion;
+  header.nDets = dets_.size();
+  header.nFloats = data_.size();
+  header.detOffset = sizeof(header);
+  header.floatOffset = header.detOffset + dets_.size()*sizeof(geomcache::DetRecord);
+
+  std::ofstream out(fileName_, std::ios::binary);
+  if (not out)
+    throw cms::Exception("GEMCSCGeometryCacheWriter") <<"can't open "<< fileName_;
+  out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+  out.write(reinterpret_cast<const char*>(dets_.data()), dets_.size()*sizeof(geomcache::DetRecord));
+  out.write(reinterpret_cast<const char*>(data_.data()), data_.size()*sizeof(float));
+  if (not out)
+    throw cms::Exception("GEMCSCGeometryCacheWriter") <<"can't write "<< fileName_;
+  written_ = true;
+
+  std::cout <<"GEMCSCGeometryCacheWriter: run "<< run.run() <<", "<< nGEM <<" GE11 eta partitions and "<< nCSC <<" ME11 layers written to "<< fileName_
+	    <<" ("<< header.floatOffset + data_.size()*sizeof(float) <<" bytes)"<< std::endl;
+}
+
+//define this as a plug-in
+DEFINE_FWK_MODULE(GEMCSCGeometryCacheWriter);
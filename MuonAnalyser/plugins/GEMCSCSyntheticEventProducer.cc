@@ -0,0 +1,457 @@
+// Synthetic GEM/CSC events on the real geometry, to measure throughput against occupancy without input files.
+// Per event:
+//   muons        straight lines from the origin with flat pt/eta/phi, with hits in every GEM eta partition and
+//                CSC layer crossed and a CSC segment per chamber with at least minSegmentHits layers;
+//                standalone, global and inner tracks and a reco::Muon pointing to them, a PF muon with the
+//                hit patterns and segment matches of the tight ID
+//   noise        Poisson numbers of GEM clusters per eta partition, CSC rechits per layer and
+//                CSC segments per chamber, all scaled by occupancyScale
+// Products: GEMRecHitCollection, GEMDigiCollection, GEMPadDigiCollection, GEMCoPadDigiCollection,
+// CSCRecHit2DCollection, CSCSegmentCollection, reco::MuonCollection, reco::VertexCollection and
+// reco::TrackCollection "standAlone", "global", "inner" with their TrackExtras.
+//
+// The primary vertex is at the origin with the inner tracks of the muons, and prompt barrel tracks
+// in "inner" up to the two tracks of the good vertex selection of MuonAnalyser.
+// The standalone track starts at its first CSC layer. The global and inner tracks end at their first GEM
+// eta partition (first CSC layer without GEM), since the transient tracks need states on muon detectors.
+// At benchmark pt the bending between GE11 and ME11 is well below the matching windows.
+// The random engine is seeded with seed, run and event, so events are reproducible in any job.
+
+// system include files
+#include <memory>
+#include <iostream>
+#include <map>
+#include <random>
+#include <set>
+
+// user include files
+#include "FWCore/Framework/interface/Frameworkfwd.h"
+#include "FWCore/Framework/interface/EDProducer.h"
+
+#include "FWCore/Framework/interface/Event.h"
+#include "FWCore/Framework/interface/EventSetup.h"
+#include "FWCore/Framework/interface/ESHandle.h"
+#include "FWCore/Framework/interface/MakerMacros.h"
+
+#include "FWCore/ParameterSet/interface/ParameterSet.h"
+
+#include "DataFormats/Common/interface/OwnVector.h"
+#include "DataFormats/GEMRecHit/interface/GEMRecHitCollection.h"
+#include "DataFormats/GEMDigi/interface/GEMDigiCollection.h"
+#include "DataFormats/GEMDigi/interface/GEMPadDigiCollection.h"
+#include "DataFormats/GEMDigi/interface/GEMCoPadDigiCollection.h"
+#include "DataFormats/CSCRecHit/interface/CSCRecHit2DCollection.h"
+#include "DataFormats/CSCRecHit/interface/CSCSegmentCollection.h"
+#include "DataFormats/CLHEP/interface/AlgebraicObjects.h"
+#include "DataFormats/MuonReco/interface/Muon.h"
+#include "DataFormats/MuonReco/interface/MuonFwd.h"
+#include "DataFormats/TrackReco/interface/Track.h"
+#include "DataFormats/TrackReco/interface/TrackExtra.h"
+#include "DataFormats/VertexReco/interface/Vertex.h"
+#include "DataFormats/SiPixelDetId/interface/PixelSubdetector.h"
+#include "DataFormats/SiStripDetId/interface/StripSubdetector.h"
+
+#include "Geometry/Records/interface/MuonGeometryRecord.h"
+#include "Geometry/GEMGeometry/interface/GEMGeometry.h"
+#include "Geometry/CSCGeometry/interface/CSCGeometry.h"
+
+using namespace std;
+using namespace edm;
+
+class GEMCSCSyntheticEventProducer : public edm::EDProducer {
+public:
+  explicit GEMCSCSyntheticEventProducer(const edm::ParameterSet&);
+  ~GEMCSCSyntheticEventProducer(){};
+
+private:
+  virtual void produce(edm::Event&, const edm::EventSetup&);
+
+  struct GeneratedMuon {
+    int charge;
+    GlobalVector momentum;
+    bool hasCSC, hasGEM;
+    GlobalPoint firstCSC, lastCSC, firstGEM;
+    DetId firstCSCId, lastCSCId, firstGEMId;
+    std::vector<CSCDetId> cscLayers;//layers with a hit
+    std::vector<std::pair<CSCDetId, LocalPoint> > cscSegments;//chambers with a segment, segment position
+  };
+
+  //crossing of the line point + t*dir, t > 0, with the plane of det; false if outside its bounds
+  bool crossing(const GeomDet& det, const GlobalPoint& point, const GlobalVector& dir, LocalPoint& lp) const;
+  int poisson(double mean, std::mt19937& rng) const;
+  //valid hits in 3 pixel and 3 TID disks, more than the 5 tracker layers of the tight ID
+  static void appendTrackerHits(reco::Track& track);
+
+  void addGEMCluster(const GEMEtaPartition* roll, int firstStrip, int clusterSize, int bx,
+		     std::map<GEMDetId, edm::OwnVector<GEMRecHit> >& gemHits, GEMDigiCollection& digis,
+		     std::map<GEMDetId, std::set<int> >& pads) const;
+  CSCRecHit2D makeCSCRecHit(const CSCLayer* layer, const LocalPoint& lp) const;
+  //rechits of the line in each layer of the chamber, and its segment if enough layers are hit
+  void addCSCLine(const CSCChamber* chamber, const GlobalPoint& point, const GlobalVector& dir,
+		  std::map<CSCDetId, edm::OwnVector<CSCRecHit2D> >& cscHits,
+		  std::map<CSCDetId, edm::OwnVector<CSCSegment> >& segments,
+		  GeneratedMuon* muon) const;
+
+  // ----------member data ---------------------------
+  unsigned int seed_;
+  int nMuons_;
+  double minMuonPt_, maxMuonPt_;
+  double minMuonEta_, maxMuonEta_;
+  int muonEndcap_;//1, -1 or 0 for both
+  double muonHitEfficiency_;
+  double occupancyScale_;
+  double gemClustersPerRoll_;
+  int maxGEMClusterSize_;
+  double cscHitsPerLayer_;
+  double cscSegmentsPerChamber_;
+  int minSegmentHits_;
+
+  const GEMGeometry* GEMGeometry_;
+  const CSCGeometry* CSCGeometry_;
+};
+
+GEMCSCSyntheticEventProducer::GEMCSCSyntheticEventProducer(const edm::ParameterSet& iConfig)
+{
+  seed_ = iConfig.getUntrackedParameter<unsigned int>("seed", 12345);
+  nMuons_ = iConfig.getUntrackedParameter<int>("nMuons", 1);
+  minMuonPt_ = iConfig.getUntrackedParameter<double>("minMuonPt", 20.0);
+  maxMuonPt_ = iConfig.getUntrackedParameter<double>("maxMuonPt", 100.0);
+  minMuonEta_ = iConfig.getUntrackedParameter<double>("minMuonEta", 1.6);
+  maxMuonEta_ = iConfig.getUntrackedParameter<double>("maxMuonEta", 2.2);
+  muonEndcap_ = iConfig.getUntrackedParameter<int>("muonEndcap", 0);
+  muonHitEfficiency_ = iConfig.getUntrackedParameter<double>("muonHitEfficiency", 0.97);
+  occupancyScale_ = iConfig.getUntrackedParameter<double>("occupancyScale", 1.0);
+  gemClustersPerRoll_ = iConfig.getUntrackedParameter<double>("gemClustersPerRoll", 0.05);
+  maxGEMClusterSize_ = iConfig.getUntrackedParameter<int>("maxGEMClusterSize", 3);
+  cscHitsPerLayer_ = iConfig.getUntrackedParameter<double>("cscHitsPerLayer", 0.05);
+  cscSegmentsPerChamber_ = iConfig.getUntrackedParameter<double>("cscSegmentsPerChamber", 0.01);
+  minSegmentHits_ = iConfig.getUntrackedParameter<int>("minSegmentHits", 4);
+
+  produces<GEMRecHitCollection>();
+  produces<GEMDigiCollection>();
+  produces<GEMPadDigiCollection>();
+  produces<GEMCoPadDigiCollection>();
+  produces<CSCRecHit2DCollection>();
+  produces<CSCSegmentCollection>();
+  produces<reco::VertexCollection>();
+  produces<reco::MuonCollection>();
+  produces<reco::TrackCollection>("standAlone");
+  produces<reco::TrackExtraCollection>("standAlone");
+  produces<reco::TrackCollection>("global");
+  produces<reco::TrackExtraCollection>("global");
+  produces<reco::TrackCollection>("inner");
+  produces<reco::TrackExtraCollection>("inner");
+}
+
+bool GEMCSCSyntheticEventProducer::crossing(const GeomDet& det, const GlobalPoint& point, const GlobalVector& dir, LocalPoint& lp) const
+{
+  const GlobalVector normal = det.surface().normalVector();
+  const double ndir = normal.dot(dir);
+  if (ndir == 0) return false;
+  const double t = normal.dot(det.surface().position() - point)/ndir;
+  if (t <= 0) return false;
+  const LocalPoint local = det.toLocal(point + t*dir);
+  lp = LocalPoint(local.x(), local.y(), 0.0);
+  return det.surface().bounds().inside(lp);
+}
+
+int GEMCSCSyntheticEventProducer::poisson(double mean, std::mt19937& rng) const
+{
+  if (mean <= 0) return 0;
+  std::poisson_distribution<int> dist(mean);
+  return dist(rng);
+}
+
+void GEMCSCSyntheticEventProducer::addGEMCluster(const GEMEtaPartition* roll, int firstStrip, int clusterSize, int bx,
+						 std::map<GEMDetId, edm::OwnVector<GEMRecHit> >& gemHits, GEMDigiCollection& digis,
+						 std::map<GEMDetId, std::set<int> >& pads) const
+{
+  //strips are 1..nstrips, positions as GEMRecHitProducer: centre of the cluster in the continuous strip coordinate
+  firstStrip = std::max(1, std::min(firstStrip, roll->nstrips() - clusterSize + 1));
+  const LocalPoint lp = roll->centreOfStrip(float(firstStrip - 1 + 0.5*clusterSize));
+  const float pitch = roll->pitch();
+  const float stripLength = roll->specificTopology().stripLength();
+  const LocalError err(clusterSize*clusterSize*pitch*pitch/12.0, 0.0, stripLength*stripLength/12.0);
+  gemHits[roll->id()].push_back(new GEMRecHit(roll->id(), bx, firstStrip, clusterSize, lp, err));
+  for (int strip = firstStrip; strip < firstStrip + clusterSize; ++strip){
+    digis.insertDigi(roll->id(), GEMDigi(strip, bx));
+    //two strips per pad
+    pads[roll->id()].insert(1 + (strip - 1)/2);
+  }
+}
+
+CSCRecHit2D GEMCSCSyntheticEventProducer::makeCSCRecHit(const CSCLayer* layer, const LocalPoint& lp) const
+{
+  const CSCLayerGeometry* geom = layer->geometry();
+  const int strip = geom->nearestStrip(lp);
+  const int wireGroup = geom->wireGroup(geom->nearestWire(lp));
+  CSCRecHit2D::ChannelContainer channels;
+  for (int s = strip - 1; s <= strip + 1; ++s)
+    if (s >= 1 and s <= geom->numberOfStrips()) channels.push_back(s);
+  //4 time samples per strip around the peak
+  CSCRecHit2D::ADCContainer adcs;
+  for (size_t s = 0; s < channels.size(); ++s){
+    const float peak = channels[s] == strip ? 200.0 : 80.0;
+    adcs.push_back(0.3*peak); adcs.push_back(peak); adcs.push_back(0.8*peak); adcs.push_back(0.4*peak);
+  }
+  CSCRecHit2D::ChannelContainer wgroups(1, wireGroup);
+  const LocalError err(0.01, 0.0, 0.25);//cm2, about strip and wire group resolutions
+  return CSCRecHit2D(layer->id(), lp, err, channels, adcs, wgroups, 150.0, 0.0, 0.1, 1);
+}
+
+void GEMCSCSyntheticEventProducer::addCSCLine(const CSCChamber* chamber, const GlobalPoint& point, const GlobalVector& dir,
+					      std::map<CSCDetId, edm::OwnVector<CSCRecHit2D> >& cscHits,
+					      std::map<CSCDetId, edm::OwnVector<CSCSegment> >& segments,
+					      GeneratedMuon* muon) const
+{
+  std::vector<CSCRecHit2D> hits;
+  for (const auto layer : chamber->layers()){
+    LocalPoint lp;
+    if (not crossing(*layer, point, dir, lp)) continue;
+    hits.push_back(makeCSCRecHit(layer, lp));
+    cscHits[layer->id()].push_back(new CSCRecHit2D(hits.back()));
+    if (muon){
+      muon->cscLayers.push_back(layer->id());
+      const GlobalPoint gp = layer->toGlobal(lp);
+      if (not muon->hasCSC or gp.mag() < muon->firstCSC.mag()){
+	muon->firstCSC = gp;
+	muon->firstCSCId = layer->id();
+      }
+      if (not muon->hasCSC or gp.mag() > muon->lastCSC.mag()){
+	muon->lastCSC = gp;
+	muon->lastCSCId = layer->id();
+      }
+      muon->hasCSC = true;
+    }
+  }
+  if (int(hits.size()) < minSegmentHits_) return;
+
+  LocalPoint origin;
+  if (not crossing(*chamber, point, dir, origin)) return;
+  std::vector<const CSCRecHit2D*> protoSegment;
+  for (const auto& hit : hits) protoSegment.push_back(&hit);
+  AlgebraicSymMatrix errors(4, 0);
+  errors[0][0] = errors[1][1] = 1e-4;//direction
+  errors[2][2] = 0.01; errors[3][3] = 0.25;//position, cm2
+  segments[chamber->id()].push_back(new CSCSegment(protoSegment, origin, chamber->toLocal(dir.unit()), errors, 1.0));
+  if (muon) muon->cscSegments.push_back({chamber->id(), origin});
+}
+
+void GEMCSCSyntheticEventProducer::appendTrackerHits(reco::Track& track)
+{
+  for (uint16_t disk = 1; disk <= 3; ++disk){
+    track.appendTrackerHitPattern(PixelSubdetector::PixelEndcap, disk, 0, TrackingRecHit::valid);
+    track.appendTrackerHitPattern(StripSubdetector::TID, disk, 0, TrackingRecHit::valid);
+  }
+}
+
+void
+GEMCSCSyntheticEventProducer::produce(edm::Event& iEvent, const edm::EventSetup& iSetup)
+{
+  edm::ESHandle<GEMGeometry> hGeom;
+  iSetup.get<MuonGeometryRecord>().get(hGeom);
+  GEMGeometry_ = &*hGeom;
+  edm::ESHandle<CSCGeometry> hGeomCSC;
+  iSetup.get<MuonGeometryRecord>().get(hGeomCSC);
+  CSCGeometry_ = &*hGeomCSC;
+
+  std::seed_seq seq{seed_, iEvent.id().run(), unsigned(iEvent.id().event()), unsigned(iEvent.id().event() >> 32)};
+  std::mt19937 rng(seq);
+  std::uniform_real_distribution<double> flat(0.0, 1.0);
+  const GlobalPoint ip(0.0, 0.0, 0.0);
+
+  std::map<GEMDetId, edm::OwnVector<GEMRecHit> > gemHits;
+  std::map<GEMDetId, std::set<int> > pads;
+  std::map<CSCDetId, edm::OwnVector<CSCRecHit2D> > cscHits;
+  std::map<CSCDetId, edm::OwnVector<CSCSegment> > segments;
+  auto gemDigis = std::make_unique<GEMDigiCollection>();
+
+  //muons
+  std::vector<GeneratedMuon> muons;
+  for (int m = 0; m < nMuons_; ++m){
+    GeneratedMuon muon;
+    muon.hasCSC = muon.hasGEM = false;
+    muon.charge = flat(rng) < 0.5 ? 1 : -1;
+    const int endcap = muonEndcap_ != 0 ? muonEndcap_ : (flat(rng) < 0.5 ? 1 : -1);
+    const double eta = endcap*(minMuonEta_ + (maxMuonEta_ - minMuonEta_)*flat(rng));
+    const double phi = M_PI*(2*flat(rng) - 1);
+    const double pt = minMuonPt_ + (maxMuonPt_ - minMuonPt_)*flat(rng);
+    muon.momentum = GlobalVector(pt*cos(phi), pt*sin(phi), pt*sinh(eta));
+    const GlobalVector dir = muon.momentum.unit();
+
+    for (const auto roll : GEMGeometry_->etaPartitions()){
+      LocalPoint lp;
+      if (roll->id().region() != endcap or not crossing(*roll, ip, dir, lp)) continue;
+      const GlobalPoint gp = roll->toGlobal(lp);
+      if (not muon.hasGEM or gp.mag() < muon.firstGEM.mag()){
+	muon.firstGEM = gp;
+	muon.firstGEMId = roll->id();
+	muon.hasGEM = true;
+      }
+      if (flat(rng) > muonHitEfficiency_) continue;
+      const int clusterSize = 1 + int(flat(rng)*maxGEMClusterSize_);
+      addGEMCluster(roll, int(roll->strip(lp)) + 1 - (clusterSize - 1)/2, clusterSize, 0, gemHits, *gemDigis, pads);
+    }
+    for (const auto chamber : CSCGeometry_->chambers())
+      if (chamber->id().zendcap() == endcap)
+	addCSCLine(chamber, ip, dir, cscHits, segments, &muon);
+    if (muon.hasCSC) muons.push_back(muon);
+  }
+
+  //noise
+  for (const auto roll : GEMGeometry_->etaPartitions()){
+    const int n = poisson(gemClustersPerRoll_*occupancyScale_, rng);
+    for (int i = 0; i < n; ++i){
+      const int clusterSize = 1 + int(flat(rng)*maxGEMClusterSize_);
+      const int bx = int(flat(rng)*5) - 2;
+      addGEMCluster(roll, 1 + int(flat(rng)*roll->nstrips()), clusterSize, bx, gemHits, *gemDigis, pads);
+    }
+  }
+  for (const auto layer : CSCGeometry_->layers()){
+    const CSCLayerGeometry* geom = layer->geometry();
+    const int n = poisson(cscHitsPerLayer_*occupancyScale_, rng);
+    for (int i = 0; i < n; ++i){
+      const int strip = 1 + int(flat(rng)*geom->numberOfStrips());
+      const int wireGroup = 1 + int(flat(rng)*geom->numberOfWireGroups());
+      const LocalPoint lp = geom->stripWireGroupIntersection(strip, wireGroup);
+      cscHits[layer->id()].push_back(new CSCRecHit2D(makeCSCRecHit(layer, lp)));
+    }
+  }
+  for (const auto chamber : CSCGeometry_->chambers()){
+    const int n = poisson(cscSegmentsPerChamber_*occupancyScale_, rng);
+    for (int i = 0; i < n; ++i){
+      //through a random point of the middle layer, within 0.2 rad of the direction from the origin
+      const CSCLayer* layer = chamber->layer(3);
+      const CSCLayerGeometry* geom = layer->geometry();
+      const int strip = 1 + int(flat(rng)*geom->numberOfStrips());
+      const int wireGroup = 1 + int(flat(rng)*geom->numberOfWireGroups());
+      const GlobalPoint gp = layer->toGlobal(geom->stripWireGroupIntersection(strip, wireGroup));
+      const GlobalVector tilt(0.2*(2*flat(rng) - 1), 0.2*(2*flat(rng) - 1), 0.2*(2*flat(rng) - 1));
+      const GlobalVector dir = (gp - ip).unit() + tilt;
+      addCSCLine(chamber, gp - 50*dir, dir, cscHits, segments, nullptr);
+    }
+  }
+
+  //coincidences of the same pad in both layers
+  auto gemPads = std::make_unique<GEMPadDigiCollection>();
+  auto gemCoPads = std::make_unique<GEMCoPadDigiCollection>();
+  for (const auto& rollPads : pads){
+    const GEMDetId& id = rollPads.first;
+    for (int pad : rollPads.second)
+      gemPads->insertDigi(id, GEMPadDigi(pad, 0));
+    if (id.layer() != 1) continue;
+    const GEMDetId other(id.region(), id.ring(), id.station(), 2, id.chamber(), id.roll());
+    const auto otherPads = pads.find(other);
+    if (otherPads == pads.end()) continue;
+    for (int pad : rollPads.second)
+      if (otherPads->second.count(pad))
+	gemCoPads->insertDigi(id, GEMCoPadDigi(id.roll(), GEMPadDigi(pad, 0), GEMPadDigi(pad, 0)));
+  }
+
+  auto gemRecHits = std::make_unique<GEMRecHitCollection>();
+  for (auto& rollHits : gemHits)
+    gemRecHits->put(rollHits.first, rollHits.second.begin(), rollHits.second.end());
+  auto cscRecHits = std::make_unique<CSCRecHit2DCollection>();
+  for (auto& layerHits : cscHits)
+    cscRecHits->put(layerHits.first, layerHits.second.begin(), layerHits.second.end());
+  auto cscSegments = std::make_unique<CSCSegmentCollection>();
+  for (auto& chamberSegments : segments)
+    cscSegments->put(chamberSegments.first, chamberSegments.second.begin(), chamberSegments.second.end());
+
+  //tracks and muons
+  const std::vector<std::string> trackLabels = {"standAlone", "global", "inner"};
+  std::vector<std::unique_ptr<reco::TrackCollection> > tracks;
+  std::vector<std::unique_ptr<reco::TrackExtraCollection> > extras;
+  std::vector<reco::TrackRefProd> trackRefs;
+  std::vector<reco::TrackExtraRefProd> extraRefs;
+  for (const auto& label : trackLabels){
+    tracks.push_back(std::make_unique<reco::TrackCollection>());
+    extras.push_back(std::make_unique<reco::TrackExtraCollection>());
+    trackRefs.push_back(iEvent.getRefBeforePut<reco::TrackCollection>(label));
+    extraRefs.push_back(iEvent.getRefBeforePut<reco::TrackExtraCollection>(label));
+  }
+  auto muonCollection = std::make_unique<reco::MuonCollection>();
+
+  reco::TrackBase::CovarianceMatrix trackCov;
+  reco::TrackExtra::CovarianceMatrix stateCov;
+  for (int i = 0; i < 5; ++i) trackCov(i, i) = stateCov(i, i) = 1e-6;
+  const double muonMass = 0.10566;
+  for (const auto& muon : muons){
+    const reco::TrackBase::Vector momentum(muon.momentum.x(), muon.momentum.y(), muon.momentum.z());
+    const reco::TrackBase::Point origin(0.0, 0.0, 0.0);
+    auto point = [](const GlobalPoint& gp){ return reco::TrackExtra::Point(gp.x(), gp.y(), gp.z()); };
+    const GlobalPoint& gemState = muon.hasGEM ? muon.firstGEM : muon.firstCSC;
+    const DetId gemStateId = muon.hasGEM ? muon.firstGEMId : muon.firstCSCId;
+    extras[0]->push_back(reco::TrackExtra(point(muon.lastCSC), momentum, true, point(muon.firstCSC), momentum, true,
+					  stateCov, muon.lastCSCId.rawId(), stateCov, muon.firstCSCId.rawId(), alongMomentum));
+    for (int t = 1; t < 3; ++t)
+      extras[t]->push_back(reco::TrackExtra(point(gemState), momentum, true, point(gemState), momentum, true,
+					    stateCov, gemStateId.rawId(), stateCov, gemStateId.rawId(), alongMomentum));
+
+    reco::Muon mu(muon.charge, reco::Particle::LorentzVector(momentum.x(), momentum.y(), momentum.z(), sqrt(momentum.mag2() + muonMass*muonMass)), origin);
+    for (int t = 0; t < 3; ++t){
+      tracks[t]->push_back(reco::Track(10.0, 10.0, origin, momentum, muon.charge, trackCov));
+      tracks[t]->back().setExtra(reco::TrackExtraRef(extraRefs[t], extras[t]->size() - 1));
+    }
+    //standalone: CSC hits, global: tracker and CSC hits, inner: tracker hits
+    for (const auto& id : muon.cscLayers){
+      tracks[0]->back().appendMuonHitPattern(id, TrackingRecHit::valid);
+      tracks[1]->back().appendMuonHitPattern(id, TrackingRecHit::valid);
+    }
+    appendTrackerHits(tracks[1]->back());
+    appendTrackerHits(tracks[2]->back());
+    const size_t index = tracks[0]->size() - 1;
+    mu.setOuterTrack(reco::TrackRef(trackRefs[0], index));
+    mu.setGlobalTrack(reco::TrackRef(trackRefs[1], index));
+    mu.setInnerTrack(reco::TrackRef(trackRefs[2], index));
+    mu.setBestTrack(reco::Muon::CombinedTrack);
+    mu.setType(reco::Muon::GlobalMuon | reco::Muon::TrackerMuon | reco::Muon::StandAloneMuon | reco::Muon::PFMuon);
+    //one segment match per chamber with a segment, arbitrated as the best one and on the track
+    std::vector<reco::MuonChamberMatch> matches;
+    for (const auto& segment : muon.cscSegments){
+      reco::MuonChamberMatch match;
+      match.id = segment.first;
+      match.x = segment.second.x();
+      match.y = segment.second.y();
+      reco::MuonSegmentMatch segmentMatch;
+      segmentMatch.x = segment.second.x();
+      segmentMatch.y = segment.second.y();
+      segmentMatch.setMask(reco::MuonSegmentMatch::BestInChamberByDR | reco::MuonSegmentMatch::BestInStationByDR | reco::MuonSegmentMatch::BelongsToTrackByDR);
+      match.segmentMatches.push_back(segmentMatch);
+      matches.push_back(match);
+    }
+    mu.setMatches(matches);
+    muonCollection->push_back(mu);
+  }
+
+  //prompt tracks, back to back in the barrel
+  const reco::TrackBase::Point origin(0.0, 0.0, 0.0);
+  for (int i = tracks[2]->size(); i < 2; ++i){
+    tracks[2]->push_back(reco::Track(10.0, 10.0, origin, reco::TrackBase::Vector(i%2 ? -1.0 : 1.0, 0.0, 0.0), 1, trackCov));
+    appendTrackerHits(tracks[2]->back());
+  }
+  auto vertices = std::make_unique<reco::VertexCollection>();
+  reco::Vertex::Error vertexError;
+  for (int i = 0; i < 3; ++i) vertexError(i, i) = 1e-4;
+  const double vertexNdof = 2.0*tracks[2]->size() - 3.0;
+  reco::Vertex vertex(reco::Vertex::Point(0.0, 0.0, 0.0), vertexError, vertexNdof, vertexNdof, tracks[2]->size());
+  for (size_t i = 0; i < tracks[2]->size(); ++i)
+    vertex.add(reco::TrackBaseRef(reco::TrackRef(trackRefs[2], i)));
+  vertices->push_back(vertex);
+
+  iEvent.put(std::move(gemRecHits));
+  iEvent.put(std::move(gemDigis));
+  iEvent.put(std::move(gemPads));
+  iEvent.put(std::move(gemCoPads));
+  iEvent.put(std::move(cscRecHits));
+  iEvent.put(std::move(cscSegments));
+  iEvent.put(std::move(vertices));
+  iEvent.put(std::move(muonCollection));
+  for (size_t t = 0; t < trackLabels.size(); ++t){
+    iEvent.put(std::move(tracks[t]), trackLabels[t]);
+    iEvent.put(std::move(extras[t]), trackLabels[t]);
+  }
+}
+
+//define this as a plug-in
+DEFINE_FWK_MODULE(GEMCSCSyntheticEventProducer);
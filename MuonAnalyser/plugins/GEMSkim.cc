@@ -1,42 +1,126 @@
+// Keeps events with an endcap muon that points at an instrumented GE1/1 chamber and has a GEM rechit
+// near its extrapolation there. The muon is extrapolated as a straight line (MuonROI.h), so the window
+// must cover the bending up to GE1/1. Stateless apart from the counters, runs as a global module.
+// Output content for the selected events: python/gemSkim_cff.py
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <iostream>
+#include <vector>
+
 #include "FWCore/Framework/interface/Frameworkfwd.h"
-#include "FWCore/Framework/interface/EDFilter.h"
+#include "FWCore/Framework/interface/global/EDFilter.h"
 
 #include "FWCore/Framework/interface/Event.h"
+#include "FWCore/Framework/interface/EventSetup.h"
+#include "FWCore/Framework/interface/ESHandle.h"
 #include "FWCore/Framework/interface/MakerMacros.h"
 
 #include "FWCore/ParameterSet/interface/ParameterSet.h"
+#include "DataFormats/Common/interface/View.h"
+#include "DataFormats/MuonReco/interface/Muon.h"
+#include "DataFormats/TrackReco/interface/Track.h"
 #include "DataFormats/GEMRecHit/interface/GEMRecHitCollection.h"
+#include "Geometry/Records/interface/MuonGeometryRecord.h"
+#include "Geometry/GEMGeometry/interface/GEMGeometry.h"
+
+#include "MuonROI.h"
 
-class GEMSkim : public edm::EDFilter {
+class GEMSkim : public edm::global::EDFilter<> {
 public:
   GEMSkim(const edm::ParameterSet&);
   ~GEMSkim() override;
 
 private:
-  void beginJob() override;
-  bool filter( edm::Event &, edm::EventSetup const& ) override;
+  bool filter(edm::StreamID, edm::Event&, edm::EventSetup const&) const override;
   void endJob() override;
-  
+
+  //straight line from the muon vertex crosses the chamber with a rechit within maxDistance_
+  bool matchedChamber(const reco::Muon& mu, const GEMChamber& chamber, const GEMRecHitCollection& gemRecHits) const;
+  bool instrumented(const GEMDetId& id) const;
+
   edm::EDGetTokenT<GEMRecHitCollection> gemRecHits_;
+  edm::EDGetTokenT<edm::View<reco::Muon> > muons_;
+  double minMuonPt_;
+  double minMuonEta_, maxMuonEta_;
+  float maxDistance_;//cm, local x window and roll boundary margin
+  std::vector<int> instrumentedChambers_;//chamber number with the region sign, e.g. -27; empty: all
+
+  mutable std::atomic<unsigned long> nEvents_{0};
+  mutable std::atomic<unsigned long> nWithMuon_{0};
+  mutable std::atomic<unsigned long> nPassed_{0};
 };
 
 GEMSkim::GEMSkim(const edm::ParameterSet& iConfig)
-{ 
+{
   gemRecHits_ = consumes<GEMRecHitCollection>(iConfig.getParameter<edm::InputTag>("gemRecHits"));
+  muons_ = consumes<edm::View<reco::Muon> >(iConfig.getParameter<edm::InputTag>("muons"));
+  minMuonPt_ = iConfig.getUntrackedParameter<double>("minMuonPt", 2.0);
+  minMuonEta_ = iConfig.getUntrackedParameter<double>("minMuonEta", 1.4);
+  maxMuonEta_ = iConfig.getUntrackedParameter<double>("maxMuonEta", 2.5);
+  maxDistance_ = iConfig.getUntrackedParameter<double>("maxDistance", 10.0);
+  instrumentedChambers_ = iConfig.getUntrackedParameter<std::vector<int> >("instrumentedChambers", std::vector<int>());
+}
+
+bool
+GEMSkim::instrumented(const GEMDetId& id) const
+{
+  if (instrumentedChambers_.empty()) return true;
+  return std::find(instrumentedChambers_.begin(), instrumentedChambers_.end(), id.region()*id.chamber()) != instrumentedChambers_.end();
+}
+
+bool
+GEMSkim::matchedChamber(const reco::Muon& mu, const GEMChamber& chamber, const GEMRecHitCollection& gemRecHits) const
+{
+  const muonroi::Line line = muonroi::muonLine(mu);
+  for (const auto& etaPart : chamber.etaPartitions()){
+    LocalPoint lp;
+    if (not muonroi::crossing(line, *etaPart, lp) or not muonroi::nearDet(lp, *etaPart, maxDistance_)) continue;
+
+    const auto range = gemRecHits.get(etaPart->id());
+    for (auto hit = range.first; hit != range.second; ++hit)
+      if (std::fabs(hit->localPosition().x() - lp.x()) < maxDistance_) return true;
+  }
+  return false;
 }
 
 bool
-GEMSkim::filter(edm::Event & iEvent, edm::EventSetup const& iSetup)
+GEMSkim::filter(edm::StreamID, edm::Event & iEvent, edm::EventSetup const& iSetup) const
 {
-  edm::Handle<GEMRecHitCollection> gemRecHits;  
+  nEvents_++;
+  edm::Handle<GEMRecHitCollection> gemRecHits;
   iEvent.getByToken(gemRecHits_, gemRecHits);
+  if (gemRecHits->size() == 0) return false;
+
+  edm::Handle<edm::View<reco::Muon> > muons;
+  iEvent.getByToken(muons_, muons);
 
-  if (gemRecHits->size()) return true;
+  edm::ESHandle<GEMGeometry> gemGeometry;
+  iSetup.get<MuonGeometryRecord>().get(gemGeometry);
 
+  bool withMuon = false;
+  for (const auto& mu : *muons){
+    if (mu.pt() < minMuonPt_ or std::fabs(mu.eta()) < minMuonEta_ or std::fabs(mu.eta()) > maxMuonEta_) continue;
+    if (not mu.standAloneMuon()) continue;
+    withMuon = true;
+    for (const auto& chamber : gemGeometry->chambers()){
+      const GEMDetId id = chamber->id();
+      if (id.station() != 1 or id.region()*mu.eta() < 0 or not instrumented(id)) continue;
+      if (matchedChamber(mu, *chamber, *gemRecHits)){
+	nWithMuon_++;
+	nPassed_++;
+	return true;
+      }
+    }
+  }
+  if (withMuon) nWithMuon_++;
   return false;
 }
-void GEMSkim::beginJob(){}
-void GEMSkim::endJob(){}
+
+void GEMSkim::endJob(){
+  std::cout <<"GEMSkim: "<< nPassed_ <<" of "<< nEvents_ <<" events passed, "<< nWithMuon_ <<" with a selected endcap muon"<< std::endl;
+}
 GEMSkim::~GEMSkim(){}
 
 //define this as a plug-in
@@ -0,0 +1,60 @@
+#include "MatchingWindowScan.h"
+
+#include "FWCore/ServiceRegistry/interface/Service.h"
+#include "CommonTools/UtilAlgos/interface/TFileService.h"
+
+MatchingWindowScan::MatchingWindowScan(const edm::ParameterSet& iConfig) :
+  selection_(iConfig)
+{
+  //defaults as in GEMCSCBendingAlgo
+  //GE11 matching window in local x, not the |dphi| cut of the summary efficiency (summaryMaxGE11Dphi)
+  GE11_ = book(iConfig, "GEMRechit_muon_deltaX", 10.0, "GE11 rechit matching window, local #Deltax (summary efficiency: |#Delta#phi| cut)", 2, "layer");
+  cscseg_ = book(iConfig, "CSCSegment_muon_deltaR", 8.0, "CSC segment, local #DeltaR", 4, "station");
+  //ME11 rechit and LCT candidates are only searched with matchMuonwithCSCRechit/matchMuonwithLCT
+  if (iConfig.getUntrackedParameter<bool>("matchMuonwithCSCRechit", false))
+    ME11_ = book(iConfig, "CSCRechit_muon_deltaR", 8.0, "ME11 rechit, local #DeltaR", 6, "layer");
+  if (iConfig.getUntrackedParameter<bool>("matchMuonwithLCT", false))
+    csclct_ = book(iConfig, "CSCLCT_muon_deltaR", 8.0, "CSC LCT, local #DeltaR", 4, "station");
+}
+
+MatchingWindowScan::Scan MatchingWindowScan::book(const edm::ParameterSet& iConfig, const char* name, double window, const char* title, int nlayers, const char* ytitle)
+{
+  Scan scan;
+  scan.windows = iConfig.getUntrackedParameter<std::vector<double> >(Form("scan%s", name),
+								      std::vector<double>(1, iConfig.getUntrackedParameter<double>(name, window)));
+  edm::Service<TFileService> fs;
+  TFileDirectory dir = fs->mkdir("windowScan");
+  const int n = scan.windows.size();
+  scan.den = dir.make<TH2D>(Form("%s_den", name), Form("%s, propagated;window [cm];%s", title, ytitle), n, -0.5, n-0.5, nlayers, 0.5, nlayers+0.5);
+  scan.num = dir.make<TH2D>(Form("%s_num", name), Form("%s, matched;window [cm];%s", title, ytitle), n, -0.5, n-0.5, nlayers, 0.5, nlayers+0.5);
+  for (int i=0; i<n; ++i){
+    scan.den->GetXaxis()->SetBinLabel(i+1, Form("%g", scan.windows[i]));
+    scan.num->GetXaxis()->SetBinLabel(i+1, Form("%g", scan.windows[i]));
+  }
+  return scan;
+}
+
+void MatchingWindowScan::fill(Scan& scan, int layer, float distance)
+{
+  if (not scan.den) return;
+  for (size_t i=0; i<scan.windows.size(); ++i){
+    scan.den->Fill(i, layer);
+    if (distance < scan.windows[i]) scan.num->Fill(i, layer);
+  }
+}
+
+void MatchingWindowScan::fill(const MuonData& data)
+{
+  if (not selection_.muon(data)) return;
+  for (int l=0; l<2; ++l)
+    if (selection_.GE11Denominator(data, l))
+      fill(GE11_, l+1, data.cand_dX_GE11[l]);
+  for (int l=0; l<6; ++l)
+    if (data.has_propME11[l])
+      fill(ME11_, l+1, data.cand_dR_ME11[l]);
+  for (int st=0; st<4; ++st){
+    if (not data.has_prop_st[st]) continue;
+    fill(cscseg_, st+1, data.cand_dR_cscseg_st[st]);
+    fill(csclct_, st+1, data.cand_dR_csclct_st[st]);
+  }
+}
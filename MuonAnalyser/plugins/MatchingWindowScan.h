@@ -0,0 +1,44 @@
+#ifndef GEMCSCBendingAnalyzer_MuonAnalyser_MatchingWindowScan_h
+#define GEMCSCBendingAnalyzer_MuonAnalyser_MatchingWindowScan_h
+
+// Efficiency against the matching windows, for a list of window values in one job.
+// The nearest candidate distances (cand_* of MuonData) are computed once per muon,
+// each window hypothesis is then only a comparison.
+// Output per detector type: num/den of hypothesis x layer (GE11, ME11) or station (segments, LCTs).
+// GE11 is scanned in local x, the variable of its matching window; the summary efficiency cuts on dphi.
+// ME11 rechits and LCTs are only scanned when the algorithm matches them (matchMuonwithCSCRechit/LCT).
+
+#include <vector>
+
+#include "FWCore/ParameterSet/interface/ParameterSet.h"
+
+#include "MuonData.h"
+#include "SliceTestSummary.h"
+
+#include "TH2D.h"
+
+class MatchingWindowScan {
+public:
+  explicit MatchingWindowScan(const edm::ParameterSet& iConfig);
+
+  void fill(const MuonData& data);
+
+private:
+  struct Scan {
+    std::vector<double> windows;//cm
+    TH2D* den = nullptr;//null: not scanned
+    TH2D* num = nullptr;
+  };
+  //windows from scan<name>, default: the matching window <name> itself
+  Scan book(const edm::ParameterSet& iConfig, const char* name, double window, const char* title, int nlayers, const char* ytitle);
+  //den for every hypothesis, num where distance < window
+  static void fill(Scan& scan, int layer, float distance);
+
+  SummarySelection selection_;
+  Scan GE11_;
+  Scan ME11_;
+  Scan cscseg_;
+  Scan csclct_;
+};
+
+#endif
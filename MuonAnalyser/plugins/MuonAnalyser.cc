@@ -1,152 +1,123 @@
-// -*- C++ -*-
-//
-// Package:    GEMCSCBendingAnalyzer/MuonAnalyser
-// Class:      MuonAnalyser
-//
-/**\class MuonAnalyser MuonAnalyser.cc GEMCSCBendingAnalyzer/MuonAnalyser/plugins/MuonAnalyser.cc
-
- Description: [one line class summary]
-
- Implementation:
-     [Notes on implementation]
-*/
-//
-// Original Author:  tao huang
-//         Created:  Tue, 17 Jul 2018 08:17:41 GMT
-//
-//
-
+// Computes MuonSummary (kinematics, IDs, isolation, impact parameters at the best vertex,
+// endcap flags) once per event for every muon and stores it as edm::ValueMap<MuonSummary>
+// keyed to the input muon collection, see python/muonSummary_cfi.py.
+// The analyzers read it through their muonSummary parameter instead of recomputing it.
 
 // system include files
+#include <algorithm>
+#include <cmath>
 #include <memory>
+#include <vector>
 
 // user include files
 #include "FWCore/Framework/interface/Frameworkfwd.h"
-#include "FWCore/Framework/interface/one/EDAnalyzer.h"
+#include "FWCore/Framework/interface/global/EDProducer.h"
 
 #include "FWCore/Framework/interface/Event.h"
 #include "FWCore/Framework/interface/MakerMacros.h"
 
 #include "FWCore/ParameterSet/interface/ParameterSet.h"
- #include "FWCore/Utilities/interface/InputTag.h"
- #include "DataFormats/TrackReco/interface/Track.h"
- #include "DataFormats/TrackReco/interface/TrackFwd.h"
-//
-// class declaration
-//
-
-// If the analyzer does not use TFileService, please remove
-// the template argument to the base class so the class inherits
-// from  edm::one::EDAnalyzer<>
-// This will improve performance in multithreaded jobs.
+#include "FWCore/Utilities/interface/InputTag.h"
 
+#include "DataFormats/Common/interface/View.h"
+#include "DataFormats/Common/interface/ValueMap.h"
+#include "DataFormats/MuonReco/interface/Muon.h"
+#include "DataFormats/MuonReco/interface/MuonSelectors.h"
+#include "DataFormats/TrackReco/interface/Track.h"
+#include "DataFormats/VertexReco/interface/Vertex.h"
+#include "DataFormats/VertexReco/interface/VertexFwd.h"
 
-using reco::TrackCollection;
+#include "GEMCSCBendingAnalyzer/MuonAnalyser/interface/MuonSummary.h"
 
-class MuonAnalyser : public edm::one::EDAnalyzer<edm::one::SharedResources>  {
-   public:
-      explicit MuonAnalyser(const edm::ParameterSet&);
-      ~MuonAnalyser();
+class MuonAnalyser : public edm::global::EDProducer<> {
+public:
+  explicit MuonAnalyser(const edm::ParameterSet&);
+  ~MuonAnalyser(){};
 
-      static void fillDescriptions(edm::ConfigurationDescriptions& descriptions);
+private:
+  void produce(edm::StreamID, edm::Event&, const edm::EventSetup&) const override;
 
+  void fillSummary(MuonSummary& summary, const reco::Muon& mu, const reco::Vertex& vertex, bool hasGoodVertex) const;
 
-   private:
-      virtual void beginJob() override;
-      virtual void analyze(const edm::Event&, const edm::EventSetup&) override;
-      virtual void endJob() override;
-
-      // ----------member data ---------------------------
-      edm::EDGetTokenT<TrackCollection> tracksToken_;  //used to select what tracks to read from configuration file
+  edm::EDGetTokenT<edm::View<reco::Muon> > muons_;
+  edm::EDGetTokenT<reco::VertexCollection> vertexCollection_;
 };
 
-//
-// constants, enums and typedefs
-//
-
-//
-// static data member definitions
-//
-
-//
-// constructors and destructor
-//
 MuonAnalyser::MuonAnalyser(const edm::ParameterSet& iConfig)
- :
-  tracksToken_(consumes<TrackCollection>(iConfig.getUntrackedParameter<edm::InputTag>("tracks")))
-
-{
-   //now do what ever initialization is needed
-
-}
-
-
-MuonAnalyser::~MuonAnalyser()
-{
-
-   // do anything here that needs to be done at desctruction time
-   // (e.g. close files, deallocate resources etc.)
-
-}
-
-
-//
-// member functions
-//
-
-// ------------ method called for each event  ------------
-void
-MuonAnalyser::analyze(const edm::Event& iEvent, const edm::EventSetup& iSetup)
 {
-   using namespace edm;
-
-    Handle<TrackCollection> tracks;
-    iEvent.getByToken(tracksToken_, tracks);
-    for(TrackCollection::const_iterator itTrack = tracks->begin();
-        itTrack != tracks->end();
-        ++itTrack) {
-      // do something with track parameters, e.g, plot the charge.
-      // int charge = itTrack->charge();
-    }
-
-#ifdef THIS_IS_AN_EVENT_EXAMPLE
-   Handle<ExampleData> pIn;
-   iEvent.getByLabel("example",pIn);
-#endif
+  muons_ = consumes<edm::View<reco::Muon> >(iConfig.getParameter<edm::InputTag>("muons"));
+  vertexCollection_ = consumes<reco::VertexCollection>(iConfig.getParameter<edm::InputTag>("vertexCollection"));
 
-#ifdef THIS_IS_AN_EVENTSETUP_EXAMPLE
-   ESHandle<SetupData> pSetup;
-   iSetup.get<SetupRecord>().get(pSetup);
-#endif
+  produces<edm::ValueMap<MuonSummary> >();
 }
 
-
-// ------------ method called once each job just before starting event loop  ------------
 void
-MuonAnalyser::beginJob()
+MuonAnalyser::fillSummary(MuonSummary& summary, const reco::Muon& mu, const reco::Vertex& vertex, bool hasGoodVertex) const
 {
+  summary.pt = mu.pt();
+  summary.eta = mu.eta();
+  summary.phi = mu.phi();
+  summary.px = mu.px();
+  summary.py = mu.py();
+  summary.pz = mu.pz();
+  summary.charge = mu.charge();
+
+  summary.isGlobal = mu.isGlobalMuon();
+  summary.isStandAlone = mu.isStandAloneMuon();
+  summary.isTracker = mu.isTrackerMuon();
+  summary.hasInnerTrack = mu.innerTrack().isNonnull();
+  summary.hasTightID = muon::isTightMuon(mu, vertex);
+  summary.hasMediumID = muon::isMediumMuon(mu);
+  summary.hasLooseID = muon::isLooseMuon(mu);
+  summary.nChamber = mu.numberOfChambersCSCorDT();
+  if (mu.innerTrack().isNonnull())
+      summary.nTrackerLayers = mu.innerTrack()->hitPattern().trackerLayersWithMeasurement();
+  if (mu.globalTrack().isNonnull())
+      summary.globalChi2 = mu.globalTrack()->normalizedChi2();
+
+  const auto& pfIso = mu.pfIsolationR04();
+  summary.pfIso = (pfIso.sumChargedHadronPt + std::max(0., pfIso.sumNeutralHadronEt + pfIso.sumPhotonEt - 0.5*pfIso.sumPUPt))/mu.pt();
+  summary.tkIso = mu.isolationR03().sumPt/mu.pt();
+
+  summary.hasGoodVertex = hasGoodVertex;
+  if (mu.muonBestTrack().isNonnull()){
+      summary.dxy = std::fabs(mu.muonBestTrack()->dxy(vertex.position()));
+      summary.dz = std::fabs(mu.muonBestTrack()->dz(vertex.position()));
+  }
+
+  const float absEta = std::fabs(mu.eta());
+  summary.endcap = mu.eta() > 0 ? 1 : -1;
+  summary.inME11 = absEta > 1.6 and absEta < 2.4;
+  summary.inGE11 = absEta > 1.55 and absEta < 2.18;
 }
 
-// ------------ method called once each job just after ending the event loop  ------------
 void
-MuonAnalyser::endJob()
+MuonAnalyser::produce(edm::StreamID, edm::Event& iEvent, const edm::EventSetup& iSetup) const
 {
-}
-
-// ------------ method fills 'descriptions' with the allowed parameters for the module  ------------
-void
-MuonAnalyser::fillDescriptions(edm::ConfigurationDescriptions& descriptions) {
-  //The following says we do not know what parameters are allowed so do no validation
-  // Please change this to state exactly what you do use, even if it is no parameters
-  edm::ParameterSetDescription desc;
-  desc.setUnknown();
-  descriptions.addDefault(desc);
-
-  //Specify that only 'tracks' is allowed
-  //To use, remove the default given above and uncomment below
-  //ParameterSetDescription desc;
-  //desc.addUntracked<edm::InputTag>("tracks","ctfWithMaterialTracks");
-  //descriptions.addDefault(desc);
+  edm::Handle<edm::View<reco::Muon> > muons;
+  iEvent.getByToken(muons_, muons);
+  edm::Handle<reco::VertexCollection> vertexCollection;
+  iEvent.getByToken(vertexCollection_, vertexCollection);
+
+  static const reco::Vertex noVertex;
+  const reco::Vertex* goodVertex = &noVertex;
+  for (const auto& vertex : *vertexCollection) {
+    if (vertex.isValid() && !vertex.isFake() && vertex.tracksSize() >= 2 && std::fabs(vertex.z()) < 24.) {
+      goodVertex = &vertex;
+      break;
+    }
+  }
+
+  //one entry per muon, in collection order
+  std::vector<MuonSummary> summaries(muons->size());
+  for (size_t i = 0; i < muons->size(); ++i)
+      fillSummary(summaries[i], (*muons)[i], *goodVertex, goodVertex != &noVertex);
+
+  auto out = std::make_unique<edm::ValueMap<MuonSummary> >();
+  edm::ValueMap<MuonSummary>::Filler filler(*out);
+  filler.insert(muons, summaries.begin(), summaries.end());
+  filler.fill();
+  iEvent.put(std::move(out));
 }
 
 //define this as a plug-in
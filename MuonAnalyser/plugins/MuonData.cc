@@ -0,0 +1,638 @@
+#include "MuonData.h"
+
+#include "FWCore/ServiceRegistry/interface/Service.h"
+#include "CommonTools/UtilAlgos/interface/TFileService.h"
+
+
+void MuonData::init()
+{
+  lumi = -99;
+  run = -99;
+  event = -99;
+
+  muonPx = -999999;
+  muonPy = -999999;
+  muonPz = -999999;
+  muondxy = -1;
+  muondz = -99999;
+  muon_ntrackhit = 0;
+  muon_nChamber = 0;
+  muon_chi2 = 0;
+  muonpt = 0.;
+  muoneta = -9.;
+  muonphi = -9.;
+  muoncharge = -9;
+  muonendcap = -9;
+  muonPFIso = -999999;
+  muonTkIso = -999999;
+  prop_time = 0.0;
+
+
+  has_TightID = 0;
+  has_MediumID = 0;
+  has_LooseID = 0;
+   
+  hasGEMdata = false;
+
+  nrechit_GE11 = 0;
+  nrechit_ME11 = 0;
+  ncscseg = 0;
+  ncscLct = 0;
+
+  for (int i=0; i<2; ++i){
+	
+    stripangle_topology[i] = 99999;
+    stripangle_test[i] = 99999;	
+    cos_stripangle_test[i] = 99999;
+    sin_stripangle_test[i] = 99999;
+    stand_RdPhi_minus_GE11[i] = 99999;
+    gt_RdPhi_minus_GE11[i] = 99999;
+    inner_RdPhi_minus_GE11[i] = 99999;
+	  
+    has_GE11[i] = 0;
+    prop_has_fidcut_GE11[i] = 0;
+    gt_has_fidcut_GE11[i] = 0;
+    inner_has_fidcut_GE11[i] = 0;
+    cand_dX_GE11[i] = 9999;
+    has_propGE11[i] = false;
+    middle_perp_propGE11[i] = -999999;
+    middle_perp_rechitGE11[i] = -999999;
+    rechit_phi_GE11[i] = -9;
+    rechit_alignedphi_GE11[i] = -9;
+    rechit_eta_GE11[i] = -9;
+    rechit_x_GE11[i] = 99999.0;
+    rechit_y_GE11[i] = 99999.0;
+    rechit_localx_GE11[i] = 99999.0;
+    rechit_localy_GE11[i] = 99999.0;
+    rechit_localphi_GE11[i] = 99999.0;
+    rechit_r_GE11[i] = 99999.0;
+    rechit_perp_GE11[i] = 99999.0;
+    rechit_stripangle_GE11[i] = 99999.0;
+    isGood_GE11[i] = 0;
+    roll_rechitGE11[i] = 0;
+    chamber_GE11[i] = 0;
+    prop_phi_GE11[i] = -9.0;
+    prop_eta_GE11[i] = -9.0;
+    prop_x_GE11[i] = 999999.0;
+    prop_y_GE11[i] = 999999.0;
+    prop_localx_GE11[i] = 999999.0;
+    prop_localy_GE11[i] = 999999.0;
+    prop_localphi_rad_GE11[i] = 9999999.0;
+    prop_localphi_deg_GE11[i] = 9999999.0;
+    prop_localx_center_GE11[i] = 999999.0;
+    prop_r_GE11[i] = 999999.0;
+    prop_perp_GE11[i] = 999999.0;
+    prop_localx_center_GE11[i]=999999.0;
+    prop_strip_GE11[i]=-1;
+    propgt_phi_GE11[i] = -9.0;
+    propgt_eta_GE11[i] = -9.0;
+    propgt_x_GE11[i] = 999999.0;
+    propgt_y_GE11[i] = 999999.0;
+    propgt_r_GE11[i] = 999999.0;
+    propgt_perp_GE11[i] = 999999.0;
+    propgt_localx_GE11[i] = 999999.0;
+    propgt_localy_GE11[i] = 999999.0;
+    propgt_localphi_rad_GE11[i] = 9999999.0;
+    propgt_localphi_deg_GE11[i] = 9999999.0;
+    propgt_localx_center_GE11[i]=999999.0;
+    propinner_phi_GE11[i] = -9.0;
+    propinner_eta_GE11[i] = -9.0;
+    propinner_x_GE11[i] = 999999.0;
+    propinner_y_GE11[i] = 999999.0;
+    propinner_r_GE11[i] = 999999.0;
+    propinner_perp_GE11[i] = 999999.0;
+    propinner_localx_GE11[i] = 999999.0;
+    propinner_localy_GE11[i] = 999999.0;
+    propinner_localphi_rad_GE11[i] = 9999999.0;
+    propinner_localphi_deg_GE11[i] = 9999999.0;
+    propinner_localx_center_GE11[i]=999999.0;
+    rechit_prop_dR_GE11[i] = 9999;
+    rechit_prop_dX_GE11[i] = 9999;
+    rechit_prop_RdPhi_GE11[i] = 9999;
+    rechit_propgt_RdPhi_GE11[i] = 9999;
+    rechit_propinner_RdPhi_GE11[i] = 9999;
+    rechit_prop_aligneddX_GE11[i] = 9999;
+    rechit_prop_dphi_GE11[i] = -9;
+    rechit_prop_aligneddphi_GE11[i] = -9;
+    rechit_strip_GE11[i] = -1.0;
+    //dphi_CSC_GE11[i] = -9;
+    //dphi_keyCSC_GE11[i] = -9;
+    //dphi_fitCSC_GE11[i] =-9;
+    rechit_used_GE11[i] = false;
+    rechit_BX_GE11[i] = false;//-1
+    rechit_firstClusterStrip_GE11[i] = false;//-1
+    rechit_clusterSize_GE11[i] = false;//-1
+
+    roll_propGE11[i] = -1;
+    chamber_propGE11[i] = -1;
+    dphi_CSCL1_GE11L1[i] = -9.0;
+    dphi_fitCSCL1_GE11L1[i] = -9.;
+    dphi_CSCSeg_GE11Rechit[i] = -9.;
+    dphi_keyCSCRechit_GE11Rechit[i] = -9.0;
+    dphi_CSCRechits_GE11Rechit[i] = -9.;
+    dphi_propCSC_propGE11[i] = -9.0;
+    dphi_keyCSCRechitL1_GE11Rechit[i] = -9.0;
+
+    dphi_CSCSeg_alignedGE11Rechit[i] = -9.;
+    dphi_keyCSCRechit_alignedGE11Rechit[i] = -9.0;
+    dphi_keyCSCRechitL1_alignedGE11Rechit[i] = -9.0;
+    
+  }
+  for (int i=0; i<6; ++i){
+    has_ME11[i] = 0;
+    rechit_phi_ME11[i]=-9;
+    rechit_eta_ME11[i] = -9;
+    rechit_x_ME11[i] = 999999.0;
+    rechit_y_ME11[i] = 999999.0;
+    rechit_localx_ME11[i] = 999999.0;
+    rechit_localy_ME11[i] = 999999.0;
+    rechit_r_ME11[i] = 999999.0;
+    rechit_perp_ME11[i] = 999999.0;
+
+    rechit_prop_dphi_ME11[i]=-9;
+    rechit_prop_RdPhi_ME11[i] = 9999;
+    rechit_propgt_RdPhi_ME11[i] = 9999;
+    rechit_propinner_RdPhi_ME11[i] = 9999;
+
+
+    prop_phi_ME11[i] = -9.0;
+    prop_eta_ME11[i] = -9.0;
+    prop_x_ME11[i] = 99999.0;
+    prop_y_ME11[i] = 99999.0;
+    prop_localx_ME11[i] = 99999.0;
+    prop_localy_ME11[i] = 99999.0;
+    prop_r_ME11[i] = 99999.0;
+    prop_perp_ME11[i] = 99999.0;
+    propgt_x_ME11[i] = 99999.0;
+    propgt_y_ME11[i] = 99999.0;
+    propgt_phi_ME11[i] = 99999.0;
+    propgt_eta_ME11[i] = 99999.0;
+    propgt_r_ME11[i] = 99999.0;
+    propgt_perp_ME11[i] = 99999.0;
+    propgt_localx_ME11[i] = 99999.0;
+    propgt_localy_ME11[i] = 99999.0;
+    propinner_x_ME11[i] = 99999.0;
+    propinner_y_ME11[i] = 99999.0;
+    propinner_phi_ME11[i] = 99999.0;
+    propinner_eta_ME11[i] = 99999.0;
+    propinner_r_ME11[i] = 99999.0;
+    propinner_perp_ME11[i] = 99999.0;
+    propinner_localx_ME11[i] = 99999.0;
+    propinner_localy_ME11[i] = 99999.0;
+    rechit_prop_dR_ME11[i] = 9999;
+    cand_dR_ME11[i] = 9999;
+    chamber_ME11[i] = -1;
+    has_propME11[i] = false;
+    ring_ME11[i] = -1;
+    chamber_propME11[i] = -1;
+    ring_propME11[i] = -1;
+    rechit_used_ME11[i] = false;
+    rechit_hitWire_ME11[i] = -1;
+    rechit_centralStrip_ME11[i] = -1;
+    rechit_nStrips_ME11[i] = 0; 
+    rechit_halfstrip_ME11[i] = -1; //-1
+    rechit_WG_ME11[i] = -1; // -1
+    rechit_L1eta_ME11[i] = -9;// -9
+    rechit_L1phi_ME11[i] = -9; //-9
+
+
+  }
+
+  for (int i = 0; i<4; ++i) {
+
+
+    has_prop_st[i] = false;
+    prop_phi_st[i] = -9;
+    prop_eta_st[i] = -9;
+    prop_x_st[i] = -99999.0;
+    prop_y_st[i] = -99999.0;
+    prop_localx_st[i] = -99999.0;
+    prop_localy_st[i] = -99999.0;
+    prop_r_st[i] = 0.0;
+    prop_perp_st[i] = 0.0;
+    propgt_phi_st[i] = -9;
+    propgt_eta_st[i] = -9;
+    propgt_x_st[i] = -99999.0;
+    propgt_y_st[i] = -99999.0;
+    propgt_localx_st[i] = -99999.0;
+    propgt_localy_st[i] = -99999.0;
+    propgt_r_st[i] = 0.0;
+    propgt_perp_st[i] = 0.0;
+    propinner_phi_st[i] = -9;
+    propinner_eta_st[i] = -9;
+    propinner_x_st[i] = -99999.0;
+    propinner_y_st[i] = -99999.0;
+    propinner_localx_st[i] = -99999.0;
+    propinner_localy_st[i] = -99999.0;
+    propinner_r_st[i] = 0.0;
+    propinner_perp_st[i] = 0.0;
+    prop_chamber_st[i] = -1;
+    prop_ring_st[i] = -1;
+
+    has_cscseg_st[i] = false;
+    cand_dR_cscseg_st[i] = 9999;
+    cand_dR_csclct_st[i] = 9999;
+    cscseg_phi_st[i] = -9;
+    cscseg_eta_st[i] = -9;
+    cscseg_x_st[i] = -99999.0;
+    cscseg_y_st[i] = -99999.0;
+    cscseg_localx_st[i] = -99999.0;
+    cscseg_localy_st[i] = -99999.0;
+    cscseg_r_st[i] = 0.0;
+    cscseg_perp_st[i] = 0.0;
+    cscseg_strip_st[i] = -99999.0;
+    cscseg_stripangle_st[i] = -99999.0;
+    cscseg_prop_RdPhi_st[i] = 9999;
+    cscseg_propgt_RdPhi_st[i] = 9999;
+    cscseg_propinner_RdPhi_st[i] = 9999;
+
+    cscseg_prop_dR_st[i] =  99999;
+    cscseg_chamber_st[i] = -1;
+    cscseg_ring_st[i] = -1;
+    has_csclct_st[i] =false;
+    csclct_phi_st[i] = -9.0;
+    csclct_eta_st[i] = -9.0;
+    csclct_x_st[i] = -99999.0;
+    csclct_y_st[i] = -99999.0;
+    csclct_r_st[i] = 0.0;
+    csclct_perp_st[i] = 0.0;
+    csclct_prop_dR_st[i] = 9999;
+    csclct_chamber_st[i] = -1;
+
+    csclct_ring_st[i] = -1;
+    csclct_keyStrip_st[i] = -1;
+    csclct_keyWG_st[i] = -1;
+    csclct_matchWin_st[i] = 0;
+    csclct_pattern_st[i] = -1;
+    
+    cscseg_prop_dphi_st[i]=-9;
+    csclct_prop_dphi_st[i]=-9;
+
+  }
+
+  nHypotheses = 0;
+  for (int h=0; h<kMaxHypotheses; ++h){
+    for (int i=0; i<2; ++i){
+      hyp_has_GE11[h][i] = false;
+      hyp_rechit_localx_GE11[h][i] = 99999;
+      hyp_rechit_phi_GE11[h][i] = -9;
+      hyp_prop_dX_GE11[h][i] = 99999;
+      hyp_prop_RdPhi_GE11[h][i] = 99999;
+      hyp_propinner_RdPhi_GE11[h][i] = 99999;
+      hyp_prop_dphi_GE11[h][i] = -9;
+      hyp_dphi_CSCSeg_GE11Rechit[h][i] = -9;
+      hyp_dphi_keyCSCRechit_GE11Rechit[h][i] = -9;
+    }
+  }
+
+}
+
+TTree* MuonData::book(TTree *t)
+{
+  edm::Service< TFileService > fs;
+  t = fs->make<TTree>("MuonData", "MuonData");
+	
+  t->Branch("stripangle_topology", stripangle_topology, "stripangle_topology[2]/F");
+  t->Branch("stripangle_test", stripangle_test, "stripangle_test[2]/F");
+  t->Branch("cos_stripangle_test", cos_stripangle_test, "cos_stripangle_test[2]/F");
+  t->Branch("sin_stripangle_test", sin_stripangle_test, "sin_stripangle_test[2]/F");
+  t->Branch("stand_RdPhi_minus_GE11", stand_RdPhi_minus_GE11, "stand_RdPhi_minus_GE11[2]/F");
+  t->Branch("gt_RdPhi_minus_GE11", gt_RdPhi_minus_GE11, "gt_RdPhi_minus_GE11[2]/F");
+  t->Branch("inner_RdPhi_minus_GE11", inner_RdPhi_minus_GE11, "inner_RdPhi_minus_GE11[2]/F");
+	    
+  t->Branch("lumi", &lumi);
+  t->Branch("run", &run);
+  t->Branch("event", &event);
+
+  t->Branch("muonpt", &muonpt);
+  t->Branch("muoneta", &muoneta);
+  t->Branch("muonphi", &muonphi);
+  t->Branch("muoncharge", &muoncharge);
+  t->Branch("muonendcap", &muonendcap);
+  t->Branch("muonPx", &muonPx);
+  t->Branch("muonPy", &muonPy);
+  t->Branch("muonPz", &muonPz);
+  t->Branch("muondxy", &muondxy);
+  t->Branch("muondz", &muondz);
+  t->Branch("muon_ntrackhit", &muon_ntrackhit);
+  t->Branch("muon_chi2", &muon_chi2);
+  t->Branch("muonPFIso", &muonPFIso);
+  t->Branch("muonTkIso", &muonTkIso);
+  t->Branch("muon_nChamber", &muon_nChamber);
+  t->Branch("prop_time", &prop_time);
+
+  t->Branch("has_MediumID", &has_MediumID);
+  t->Branch("has_LooseID", &has_LooseID);  
+  t->Branch("has_TightID", &has_TightID);
+  t->Branch("hasGEMdata", &hasGEMdata);
+
+
+  t->Branch("has_ME11", has_ME11, "has_ME11[6]/B");
+  t->Branch("chamber_ME11", chamber_ME11, "chamber_ME11[6]/I");
+  t->Branch("has_propME11", has_propME11, "has_propME11[6]/B");
+  t->Branch("ring_ME11", ring_ME11, "ring_ME11[6]/I");
+  t->Branch("chamber_propME11", chamber_propME11, "chamber_propME11[6]/I");
+  t->Branch("ring_propME11", ring_propME11, "ring_propME11[6]/I");
+  t->Branch("rechit_phi_ME11", rechit_phi_ME11, "rechit_phi_ME11[6]/F");
+  t->Branch("rechit_eta_ME11", rechit_eta_ME11, "rechit_eta_ME11[6]/F");
+  t->Branch("rechit_x_ME11", rechit_x_ME11, "rechit_x_ME11[6]/F");
+  t->Branch("rechit_y_ME11", rechit_y_ME11, "rechit_y_ME11[6]/F");
+  t->Branch("rechit_r_ME11", rechit_r_ME11, "rechit_r_ME11[6]/F");
+  t->Branch("rechit_perp_ME11", rechit_perp_ME11, "rechit_perp_ME11[6]/F");
+  t->Branch("rechit_localx_ME11",rechit_localx_ME11,"rechit_localx_ME11[6]/F");
+  t->Branch("rechit_localy_ME11",rechit_localy_ME11,"rechit_localy_ME11[6]/F");
+  t->Branch("rechit_L1eta_ME11", rechit_L1eta_ME11, "rechit_L1eta_ME11[6]/F");
+  t->Branch("rechit_L1phi_ME11", rechit_L1phi_ME11, "rechit_L1phi_ME11[6]/F");
+  t->Branch("rechit_hitWire_ME11", rechit_hitWire_ME11, "rechit_hitWire_ME11[6]/I");
+  t->Branch("rechit_WG_ME11", rechit_WG_ME11, "rechit_WG_ME11[6]/I");
+  t->Branch("rechit_nStrips_ME11", rechit_nStrips_ME11, "rechit_nStrips_ME11[6]/i");
+  t->Branch("rechit_centralStrip_ME11", rechit_centralStrip_ME11, "rechit_centralStrip_ME11[6]/I");
+  t->Branch("rechit_used_ME11", rechit_used_ME11, "rechit_used_ME11[6]/B");
+  t->Branch("prop_eta_ME11", prop_eta_ME11, "prop_eta_ME11[6]/F");
+  t->Branch("prop_phi_ME11", prop_phi_ME11, "prop_phi_ME11[6]/F");
+  t->Branch("prop_x_ME11",   prop_x_ME11,   "prop_x_ME11[6]/F");
+  t->Branch("prop_y_ME11",   prop_y_ME11,   "prop_y_ME11[6]/F");
+  t->Branch("prop_r_ME11",   prop_r_ME11,   "prop_r_ME11[6]/F");
+  t->Branch("prop_perp_ME11",   prop_perp_ME11,   "prop_perp_ME11[6]/F");
+  t->Branch("propgt_eta_ME11", propgt_eta_ME11, "propgt_eta_ME11[6]/F");
+  t->Branch("propgt_phi_ME11", propgt_phi_ME11, "propgt_phi_ME11[6]/F");
+  t->Branch("propgt_x_ME11",   propgt_x_ME11,   "propgt_x_ME11[6]/F");
+  t->Branch("propgt_y_ME11",   propgt_y_ME11,   "propgt_y_ME11[6]/F");
+  t->Branch("propgt_r_ME11",   propgt_r_ME11,   "propgt_r_ME11[6]/F");
+  t->Branch("propgt_perp_ME11",   propgt_perp_ME11,   "propgt_perp_ME11[6]/F");
+  t->Branch("propinner_eta_ME11", propinner_eta_ME11, "propinner_eta_ME11[6]/F");
+  t->Branch("propinner_phi_ME11", propinner_phi_ME11, "propinner_phi_ME11[6]/F");
+  t->Branch("propinner_x_ME11",   propinner_x_ME11,   "propinner_x_ME11[6]/F");
+  t->Branch("propinner_y_ME11",   propinner_y_ME11,   "propinner_y_ME11[6]/F");
+  t->Branch("propinner_perp_ME11",   propinner_perp_ME11,   "propinner_perp_ME11[6]/F");
+  t->Branch("prop_localx_ME11",prop_localx_ME11,"prop_localx_ME11[6]/F");
+  t->Branch("prop_localy_ME11",prop_localy_ME11,"prop_localy_ME11[6]/F");
+  t->Branch("propgt_localx_ME11",propgt_localx_ME11,"propgt_localx_ME11[6]/F");
+  t->Branch("propgt_localy_ME11",propgt_localy_ME11,"propgt_localy_ME11[6]/F");
+  t->Branch("propinner_localx_ME11",propinner_localx_ME11,"propinner_localx_ME11[6]/F");
+  t->Branch("propinner_localy_ME11",propinner_localy_ME11,"propinner_localy_ME11[6]/F");
+  t->Branch("rechit_prop_dR_ME11", rechit_prop_dR_ME11, "rechit_prop_dR_ME11[6]/F");
+  t->Branch("rechit_prop_dphi_ME11", rechit_prop_dphi_ME11, "rechit_prop_dphi_ME11[6]/F");
+  t->Branch("rechit_prop_RdPhi_ME11", rechit_prop_RdPhi_ME11, "rechit_prop_RdPhi_ME11[2]/F");
+  t->Branch("rechit_propgt_RdPhi_ME11", rechit_propgt_RdPhi_ME11, "rechit_propgt_RdPhi_ME11[2]/F");
+  t->Branch("rechit_propinner_RdPhi_ME11", rechit_propinner_RdPhi_ME11, "rechit_propinner_RdPhi_ME11[2]/F");
+
+
+  t->Branch("isGood_GE11", isGood_GE11, "isGood_GE11[2]/B");
+  t->Branch("has_GE11", has_GE11, "has_GE11[2]/B");
+  t->Branch("prop_has_fidcut_GE11", prop_has_fidcut_GE11, "prop_has_fidcut_GE11[2]/B");
+  t->Branch("gt_has_fidcut_GE11", gt_has_fidcut_GE11, "gt_has_fidcut_GE11[2]/B");
+  t->Branch("inner_has_fidcut_GE11", inner_has_fidcut_GE11, "inner_has_fidcut_GE11[2]/B");
+  t->Branch("cand_dX_GE11", cand_dX_GE11, "cand_dX_GE11[2]/F");
+  t->Branch("cand_dR_ME11", cand_dR_ME11, "cand_dR_ME11[6]/F");
+  t->Branch("cand_dR_cscseg_st", cand_dR_cscseg_st, "cand_dR_cscseg_st[4]/F");
+  t->Branch("cand_dR_csclct_st", cand_dR_csclct_st, "cand_dR_csclct_st[4]/F");
+  t->Branch("nHypotheses", &nHypotheses);
+  t->Branch("hyp_has_GE11", hyp_has_GE11, "hyp_has_GE11[nHypotheses][2]/B");
+  t->Branch("hyp_rechit_localx_GE11", hyp_rechit_localx_GE11, "hyp_rechit_localx_GE11[nHypotheses][2]/F");
+  t->Branch("hyp_rechit_phi_GE11", hyp_rechit_phi_GE11, "hyp_rechit_phi_GE11[nHypotheses][2]/F");
+  t->Branch("hyp_prop_dX_GE11", hyp_prop_dX_GE11, "hyp_prop_dX_GE11[nHypotheses][2]/F");
+  t->Branch("hyp_prop_RdPhi_GE11", hyp_prop_RdPhi_GE11, "hyp_prop_RdPhi_GE11[nHypotheses][2]/F");
+  t->Branch("hyp_propinner_RdPhi_GE11", hyp_propinner_RdPhi_GE11, "hyp_propinner_RdPhi_GE11[nHypotheses][2]/F");
+  t->Branch("hyp_prop_dphi_GE11", hyp_prop_dphi_GE11, "hyp_prop_dphi_GE11[nHypotheses][2]/F");
+  t->Branch("hyp_dphi_CSCSeg_GE11Rechit", hyp_dphi_CSCSeg_GE11Rechit, "hyp_dphi_CSCSeg_GE11Rechit[nHypotheses][2]/F");
+  t->Branch("hyp_dphi_keyCSCRechit_GE11Rechit", hyp_dphi_keyCSCRechit_GE11Rechit, "hyp_dphi_keyCSCRechit_GE11Rechit[nHypotheses][2]/F");
+  t->Branch("roll_rechitGE11", roll_rechitGE11, "roll_rechitGE11[2]/I");
+  t->Branch("chamber_GE11", chamber_GE11, "chamber_GE11[2]/I");
+  t->Branch("middle_perp_propGE11", middle_perp_propGE11, "middle_perp_propGE11[2]/F");  // Is this right?
+  t->Branch("middle_perp_rechitGE11", middle_perp_rechitGE11, "middle_perp_rechitGE11[2]/F");  // Is this right?
+  t->Branch("rechit_phi_GE11", rechit_phi_GE11, "phi_GE11[2]/F");  // Is this right?
+  t->Branch("rechit_alignedphi_GE11", rechit_alignedphi_GE11, "phi_GE11[2]/F");  // Is this right?
+  t->Branch("rechit_eta_GE11", rechit_eta_GE11, "rechit_eta_GE11[2]/F");
+  t->Branch("rechit_x_GE11", rechit_x_GE11, "rechit_x_GE11[2]/F");
+  t->Branch("rechit_y_GE11", rechit_y_GE11, "rechit_y_GE11[2]/F");
+  t->Branch("rechit_r_GE11", rechit_r_GE11, "rechit_r_GE11[2]/F");
+  t->Branch("rechit_perp_GE11", rechit_perp_GE11, "rechit_perp_GE11[2]/F");
+  t->Branch("rechit_stripangle_GE11", rechit_stripangle_GE11, "rechit_stripangle_GE11[2]/F");
+  t->Branch("rechit_localx_GE11",rechit_localx_GE11,"rechit_localx_GE11[2]/F");
+  t->Branch("rechit_alignedlocalx_GE11",rechit_alignedlocalx_GE11,"rechit_alignedlocalx_GE11[2]/F");
+  t->Branch("rechit_localy_GE11",rechit_localy_GE11,"rechit_localy_GE11[2]/F");
+  t->Branch("rechit_localphi_GE11", rechit_localphi_GE11, "rechit_localphi_GE11[2]/F");
+  t->Branch("rechit_used_GE11", rechit_used_GE11, "rechit_used_GE11[2]/B");
+  t->Branch("rechit_BX_GE11", rechit_BX_GE11, "rechit_BX_GE11[2]/I");
+  t->Branch("rechit_firstClusterStrip_GE11", rechit_firstClusterStrip_GE11, "rechit_firstClusterStrip_GE11[2]/I");
+  t->Branch("rechit_strip_GE11", rechit_strip_GE11, "rechit_strip_GE11[2]/F");
+  t->Branch("rechit_clusterSize_GE11", rechit_clusterSize_GE11, "rechit_clusterSize_GE11[2]/I");
+  t->Branch("has_propGE11", has_propGE11, "has_propGE11[2]/B");
+  t->Branch("roll_propGE11", roll_propGE11, "roll_propGE11[2]/I");
+  t->Branch("chamber_propGE11", chamber_propGE11, "chamber_propGE11[2]/I");
+  t->Branch("prop_phi_GE11", prop_phi_GE11, "prop_phi_GE11[2]/F");
+  t->Branch("prop_eta_GE11", prop_eta_GE11, "prop_eta_GE11[2]/F");
+  t->Branch("prop_x_GE11", prop_x_GE11, "prop_x_GE11[2]/F");
+  t->Branch("prop_y_GE11", prop_y_GE11, "prop_y_GE11[2]/F");
+  t->Branch("prop_r_GE11", prop_r_GE11, "prop_r_GE11[2]/F");
+  t->Branch("prop_perp_GE11", prop_perp_GE11, "prop_perp_GE11[2]/F");
+  t->Branch("prop_localx_GE11",prop_localx_GE11,"prop_localx_GE11[2]/F");
+  t->Branch("prop_localy_GE11",prop_localy_GE11,"prop_localy_GE11[2]/F");
+  t->Branch("prop_localphi_rad_GE11", prop_localphi_rad_GE11, "prop_localphi_rad_GE11[2]/F");
+  t->Branch("prop_localphi_deg_GE11", prop_localphi_deg_GE11, "prop_localphi_deg_GE11[2]/F");
+  t->Branch("propgt_phi_GE11", propgt_phi_GE11, "propgt_phi_GE11[2]/F");
+  t->Branch("propgt_eta_GE11", propgt_eta_GE11, "propgt_eta_GE11[2]/F");
+  t->Branch("propgt_x_GE11",   propgt_x_GE11,   "propgt_x_GE11[2]/F");
+  t->Branch("propgt_y_GE11",   propgt_y_GE11,   "propgt_y_GE11[2]/F");
+  t->Branch("propgt_r_GE11",   propgt_r_GE11,   "propgt_r_GE11[2]/F");
+  t->Branch("propgt_perp_GE11",   propgt_perp_GE11,   "propgt_perp_GE11[2]/F");
+  t->Branch("propgt_localx_GE11",propgt_localx_GE11,"propgt_localx_GE11[2]/F");
+  t->Branch("propgt_localy_GE11",propgt_localy_GE11,"propgt_localy_GE11[2]/F");
+  t->Branch("propgt_localphi_rad_GE11", propgt_localphi_rad_GE11, "propgt_localphi_rad_GE11[2]/F"); 
+  t->Branch("propgt_localphi_deg_GE11", propgt_localphi_deg_GE11, "propgt_localphi_deg_GE11[2]/F");
+  t->Branch("propinner_phi_GE11", propinner_phi_GE11, "propinner_phi_GE11[2]/F");
+  t->Branch("propinner_eta_GE11", propinner_eta_GE11, "propinner_eta_GE11[2]/F");
+  t->Branch("propinner_x_GE11",   propinner_x_GE11,   "propinner_x_GE11[2]/F");
+  t->Branch("propinner_y_GE11",   propinner_y_GE11,   "propinner_y_GE11[2]/F");
+  t->Branch("propinner_r_GE11",   propinner_r_GE11,   "propinner_r_GE11[2]/F");
+  t->Branch("propinner_perp_GE11",   propinner_perp_GE11,   "propinner_perp_GE11[2]/F");
+  t->Branch("propinner_localx_GE11",propinner_localx_GE11,"propinner_localx_GE11[2]/F");
+  t->Branch("propinner_localy_GE11",propinner_localy_GE11,"propinner_localy_GE11[2]/F");
+  t->Branch("propinner_localphi_rad_GE11", propinner_localphi_rad_GE11, "propinner_localphi_rad_GE11[2]/F");
+  t->Branch("propinner_localphi_deg_GE11", propinner_localphi_deg_GE11, "propinner_localphi_deg_GE11[2]/F");
+  t->Branch("rechit_prop_dR_GE11", rechit_prop_dR_GE11, "rechit_prop_dR_GE11[2]/F");
+  t->Branch("rechit_prop_dX_GE11", rechit_prop_dX_GE11, "rechit_prop_dX_GE11[2]/F");
+  t->Branch("rechit_prop_RdPhi_GE11", rechit_prop_RdPhi_GE11, "rechit_prop_RdPhi_GE11[2]/F");
+  t->Branch("rechit_propgt_RdPhi_GE11", rechit_propgt_RdPhi_GE11, "rechit_propgt_RdPhi_GE11[2]/F");
+  t->Branch("rechit_propinner_RdPhi_GE11", rechit_propinner_RdPhi_GE11, "rechit_propinner_RdPhi_GE11[2]/F");
+  t->Branch("rechit_prop_aligneddX_GE11", rechit_prop_aligneddX_GE11, "rechit_prop_aligneddX_GE11[2]/F");
+  t->Branch("rechit_prop_dphi_GE11", rechit_prop_dphi_GE11, "rechit_prop_dphi_GE11[2]/F");
+  t->Branch("rechit_prop_aligneddphi_GE11", rechit_prop_aligneddphi_GE11, "rechit_prop_aligneddphi_GE11[2]/F");
+
+  t->Branch("has_prop_st", has_cscseg_st, "has_prop_st[4]/B");
+  t->Branch("prop_phi_st",    prop_phi_st,     "prop_phi_st[4]/F");
+  t->Branch("prop_eta_st",    prop_eta_st,     "prop_eta_st[4]/F");
+  t->Branch("prop_x_st",      prop_x_st,       "prop_x_st[4]/F");
+  t->Branch("prop_y_st",      prop_y_st,       "prop_y_st[4]/F");
+  t->Branch("prop_r_st",      prop_r_st,       "prop_r_st[4]/F");
+  t->Branch("prop_localx_st", prop_localx_st,  "prop_localx_st[4]/F");
+  t->Branch("prop_localy_st", prop_localy_st,  "prop_localy_st[4]/F");
+  t->Branch("prop_perp_st",   prop_perp_st,    "prop_perp_st[4]/F");
+  t->Branch("propgt_phi_st",    propgt_phi_st,     "propgt_phi_st[4]/F");
+  t->Branch("propgt_eta_st",    propgt_eta_st,     "propgt_eta_st[4]/F");
+  t->Branch("propgt_x_st",      propgt_x_st,       "propgt_x_st[4]/F");
+  t->Branch("propgt_y_st",      propgt_y_st,       "propgt_y_st[4]/F");
+  t->Branch("propgt_r_st",      propgt_r_st,       "propgt_r_st[4]/F");
+  t->Branch("propgt_localx_st", propgt_localx_st,  "propgt_localx_st[4]/F");
+  t->Branch("propgt_localy_st", propgt_localy_st,  "propgt_localy_st[4]/F");
+  t->Branch("propgt_perp_st",   propgt_perp_st,    "propgt_perp_st[4]/F");
+  t->Branch("propinner_phi_st",    propinner_phi_st,     "propinner_phi_st[4]/F");
+  t->Branch("propinner_eta_st",    propinner_eta_st,     "propinner_eta_st[4]/F");
+  t->Branch("propinner_x_st",      propinner_x_st,       "propinner_x_st[4]/F");
+  t->Branch("propinner_y_st",      propinner_y_st,       "propinner_y_st[4]/F");
+  t->Branch("propinner_r_st",      propinner_r_st,       "propinner_r_st[4]/F");
+  t->Branch("propinner_localx_st", propinner_localx_st,  "propinner_localx_st[4]/F");
+  t->Branch("propinner_localy_st", propinner_localy_st,  "propinner_localy_st[4]/F");
+  t->Branch("propinner_perp_st",   propinner_perp_st,    "propinner_perp_st[4]/F");
+  t->Branch("prop_ring_st", prop_ring_st, "prop_ring_st[4]/I");
+  t->Branch("prop_chamber_st", prop_chamber_st, "prop_chamber_st[4]/I");
+
+  t->Branch("has_cscseg_st", has_cscseg_st, "has_cscseg_st[4]/B");
+  t->Branch("cscseg_phi_st", cscseg_phi_st, "cscseg_phi_st[4]/F");
+  t->Branch("cscseg_eta_st", cscseg_eta_st, "cscseg_eta_st[4]/F");
+  t->Branch("cscseg_x_st", cscseg_x_st, "cscseg_x_st[4]/F");
+  t->Branch("cscseg_y_st", cscseg_y_st, "cscseg_y_st[4]/F");
+  t->Branch("cscseg_r_st", cscseg_r_st, "cscseg_r_st[4]/F");
+  t->Branch("cscseg_localx_st", cscseg_localx_st, "cscseg_localx_st[4]/F");
+  t->Branch("cscseg_localy_st", cscseg_localy_st, "cscseg_localy_st[4]/F");
+  t->Branch("cscseg_perp_st", cscseg_perp_st, "cscseg_perp_st[4]/F");
+  t->Branch("cscseg_strip_st", cscseg_strip_st, "cscseg_strip_st[4]/F");
+  t->Branch("cscseg_stripangle_st", cscseg_stripangle_st, "cscseg_stripangle_st[4]/F");
+  t->Branch("cscseg_prop_dR_st", cscseg_prop_dR_st, "cscseg_prop_dR_st[4]/F");
+  t->Branch("cscseg_prop_dphi_st", cscseg_prop_dphi_st, "cscseg_prop_dphi_st[4]/F");
+  t->Branch("cscseg_prop_RdPhi_st",      cscseg_prop_RdPhi_st,      "cscseg_prop_RdPhi_st[4]/F");
+  t->Branch("cscseg_propgt_RdPhi_st",    cscseg_propgt_RdPhi_st,    "cscseg_propgt_RdPhi_st[4]/F");
+  t->Branch("cscseg_propinner_RdPhi_st", cscseg_propinner_RdPhi_st, "cscseg_propinner_RdPhi_st[4]/F");
+  t->Branch("cscseg_chamber_st", cscseg_chamber_st, "cscseg_chamber_st[4]/I");
+  t->Branch("cscseg_ring_st", cscseg_ring_st, "cscseg_ring_st[4]/I");
+  t->Branch("has_csclct_st", has_csclct_st, "has_csclct_st[4]/B");
+  t->Branch("csclct_phi_st", csclct_phi_st, "csclct_phi_st[4]/F");
+  t->Branch("csclct_eta_st", csclct_eta_st, "csclct_eta_st[4]/F");
+  t->Branch("csclct_x_st", csclct_x_st, "csclct_x_st[4]/F");
+  t->Branch("csclct_y_st", csclct_y_st, "csclct_y_st[4]/F");
+  t->Branch("csclct_r_st", csclct_r_st, "csclct_r_st[4]/F");
+  t->Branch("csclct_perp_st", csclct_perp_st, "csclct_perp_st[4]/F");
+  t->Branch("csclct_chamber_st", csclct_chamber_st, "csclct_chamber_st[4]/I");
+  t->Branch("csclct_ring_st", csclct_ring_st, "csclct_ring_st[4]/I");
+  t->Branch("csclct_prop_dR_st", csclct_prop_dR_st, "csclct_prop_dR_st[4]/F");
+  t->Branch("csclct_prop_dphi_st", csclct_prop_dphi_st, "csclct_prop_dphi_st[4]/F");
+  t->Branch("csclct_keyStrip_st", csclct_keyStrip_st, "csclct_keyStrip_st[4]/I");
+  t->Branch("csclct_keyWG_st", csclct_keyWG_st, "csclct_keyWG_st[4]/I");
+  t->Branch("csclct_matchWin_st", csclct_matchWin_st, "csclct_matchWin_st[4]/I");
+  t->Branch("csclct_pattern_st", csclct_pattern_st, "csclct_pattern_st[4]/I");
+
+
+
+  t->Branch("dphi_CSCL1_GE11L1", dphi_CSCL1_GE11L1, "dphi_CSCL1_GE11L1[2]/F");
+  t->Branch("dphi_fitCSCL1_GE11L1", dphi_fitCSCL1_GE11L1, "dphi_fitCSCL1_GE11L1[2]/F");
+  t->Branch("dphi_CSCSeg_GE11Rechit", dphi_CSCSeg_GE11Rechit, "dphi_CSCSeg_GE11Rechit[2]/F");
+  t->Branch("dphi_keyCSCRechit_GE11Rechit", dphi_keyCSCRechit_GE11Rechit, "dphi_keyCSCRechit_GE11Rechit[2]/F");
+  t->Branch("dphi_CSCRechits_GE11Rechit", dphi_CSCRechits_GE11Rechit, "dphi_CSCRechits_GE11Rechit[2]/F");
+  t->Branch("dphi_propCSC_propGE11", dphi_propCSC_propGE11, "dphi_propCSC_propGE11[2]/F");
+  t->Branch("dphi_keyCSCRechitL1_GE11Rechit", dphi_keyCSCRechitL1_GE11Rechit, "dphi_keyCSCRechitL1_GE11Rechit[2]/F");
+
+  t->Branch("dphi_CSCSeg_alignedGE11Rechit", dphi_CSCSeg_alignedGE11Rechit, "dphi_CSCSeg_alignedGE11Rechit[2]/F");
+  t->Branch("dphi_keyCSCRechit_alignedGE11Rechit", dphi_keyCSCRechit_alignedGE11Rechit, "dphi_keyCSCRechit_alignedGE11Rechit[2]/F");
+  t->Branch("dphi_keyCSCRechitL1_alignedGE11Rechit", dphi_keyCSCRechitL1_alignedGE11Rechit, "dphi_keyCSCRechitL1_alignedGE11Rechit[2]/F");
+ 
+  t->Branch("prop_strip_GE11",prop_strip_GE11,"prop_strip_GE11[2]/F");
+  t->Branch("prop_localx_center_GE11",prop_localx_center_GE11,"prop_localx_center_GE11[2]/F");
+  t->Branch("propgt_localx_center_GE11",propgt_localx_center_GE11,"propgt_localx_center_GE11[2]/F");
+  t->Branch("propinner_localx_center_GE11",propinner_localx_center_GE11,"propinner_localx_center_GE11[2]/F");
+  t->Branch("nrechit_ME11", &nrechit_ME11, "nrechit_ME11/I");
+  t->Branch("ncscseg", &ncscseg, "ncscseg/I");
+  t->Branch("ncscLct", &ncscLct, "ncscLct/I");
+  t->Branch("nrechit_GE11", &nrechit_GE11, "nrechit_GE11/I");
+
+
+
+  //  the above is the new edited lines
+
+  return t;
+}
+
+void MuonData::fillBending(GEMCSCBending& bending) const
+{
+  bending.valid = true;
+  bending.has_cscseg = has_cscseg_st[0];
+  bending.cscseg_chamber = cscseg_chamber_st[0];
+  bending.cscseg_ring = cscseg_ring_st[0];
+  bending.cscseg_phi = cscseg_phi_st[0];
+  bending.has_ME11 = has_ME11[2];
+  bending.rechit_phi_ME11 = rechit_phi_ME11[2];
+  bending.rechit_L1phi_ME11 = rechit_L1phi_ME11[2];
+  bending.has_propME11 = has_propME11[2];
+  bending.prop_phi_ME11 = prop_phi_ME11[2];
+  for (int i=0; i<2; ++i){
+    bending.has_GE11[i] = has_GE11[i];
+    bending.chamber_GE11[i] = chamber_GE11[i];
+    bending.rechit_phi_GE11[i] = rechit_phi_GE11[i];
+    bending.rechit_alignedphi_GE11[i] = rechit_alignedphi_GE11[i];
+    bending.rechit_localx_GE11[i] = rechit_localx_GE11[i];
+    bending.has_propGE11[i] = has_propGE11[i];
+    bending.prop_phi_GE11[i] = prop_phi_GE11[i];
+    bending.prop_localx_GE11[i] = prop_localx_GE11[i];
+    bending.dphi_CSCSeg_GE11Rechit[i] = dphi_CSCSeg_GE11Rechit[i];
+    bending.dphi_CSCSeg_alignedGE11Rechit[i] = dphi_CSCSeg_alignedGE11Rechit[i];
+    bending.dphi_keyCSCRechit_GE11Rechit[i] = dphi_keyCSCRechit_GE11Rechit[i];
+    bending.dphi_keyCSCRechit_alignedGE11Rechit[i] = dphi_keyCSCRechit_alignedGE11Rechit[i];
+    bending.dphi_keyCSCRechitL1_GE11Rechit[i] = dphi_keyCSCRechitL1_GE11Rechit[i];
+    bending.dphi_keyCSCRechitL1_alignedGE11Rechit[i] = dphi_keyCSCRechitL1_alignedGE11Rechit[i];
+    bending.dphi_propCSC_propGE11[i] = dphi_propCSC_propGE11[i];
+    bending.roll_GE11[i] = roll_rechitGE11[i];
+  }
+}
+
+void MuonData::setBending(const GEMCSCBending& bending)
+{
+  has_cscseg_st[0] = bending.has_cscseg;
+  cscseg_chamber_st[0] = bending.cscseg_chamber;
+  cscseg_ring_st[0] = bending.cscseg_ring;
+  cscseg_phi_st[0] = bending.cscseg_phi;
+  has_ME11[2] = bending.has_ME11;
+  rechit_phi_ME11[2] = bending.rechit_phi_ME11;
+  rechit_L1phi_ME11[2] = bending.rechit_L1phi_ME11;
+  has_propME11[2] = bending.has_propME11;
+  prop_phi_ME11[2] = bending.prop_phi_ME11;
+  for (int i=0; i<2; ++i){
+    has_GE11[i] = bending.has_GE11[i];
+    chamber_GE11[i] = bending.chamber_GE11[i];
+    rechit_phi_GE11[i] = bending.rechit_phi_GE11[i];
+    rechit_alignedphi_GE11[i] = bending.rechit_alignedphi_GE11[i];
+    rechit_localx_GE11[i] = bending.rechit_localx_GE11[i];
+    has_propGE11[i] = bending.has_propGE11[i];
+    prop_phi_GE11[i] = bending.prop_phi_GE11[i];
+    prop_localx_GE11[i] = bending.prop_localx_GE11[i];
+    dphi_CSCSeg_GE11Rechit[i] = bending.dphi_CSCSeg_GE11Rechit[i];
+    dphi_CSCSeg_alignedGE11Rechit[i] = bending.dphi_CSCSeg_alignedGE11Rechit[i];
+    dphi_keyCSCRechit_GE11Rechit[i] = bending.dphi_keyCSCRechit_GE11Rechit[i];
+    dphi_keyCSCRechit_alignedGE11Rechit[i] = bending.dphi_keyCSCRechit_alignedGE11Rechit[i];
+    dphi_keyCSCRechitL1_GE11Rechit[i] = bending.dphi_keyCSCRechitL1_GE11Rechit[i];
+    dphi_keyCSCRechitL1_alignedGE11Rechit[i] = bending.dphi_keyCSCRechitL1_alignedGE11Rechit[i];
+    dphi_propCSC_propGE11[i] = bending.dphi_propCSC_propGE11[i];
+    roll_rechitGE11[i] = bending.roll_GE11[i];
+  }
+}
+
+void MuonData::setSummary(const MuonSummary& summary)
+{
+  muonPx = summary.px;
+  muonPy = summary.py;
+  muonPz = summary.pz;
+  muondxy = summary.dxy;
+  muondz = summary.dz;
+  muon_ntrackhit = summary.nTrackerLayers;
+  muon_chi2 = summary.globalChi2;
+  muon_nChamber = summary.nChamber;
+  muonpt = summary.pt;
+  muoneta = summary.eta;
+  muonphi = summary.phi;
+  muoncharge = summary.charge;
+  muonendcap = summary.endcap;
+  muonPFIso = summary.pfIso;
+  muonTkIso = summary.tkIso;
+  has_TightID = summary.hasTightID;
+  has_MediumID = summary.hasMediumID;
+  has_LooseID = summary.hasLooseID;
+}
@@ -0,0 +1,293 @@
+#ifndef GEMCSCBendingAnalyzer_MuonAnalyser_MuonData_h
+#define GEMCSCBendingAnalyzer_MuonAnalyser_MuonData_h
+
+// per muon ntuple content of SliceTestAnalysis, filled by GEMCSCBendingAlgo
+
+#include "GEMCSCBendingAnalyzer/MuonAnalyser/interface/GEMCSCBending.h"
+#include "GEMCSCBendingAnalyzer/MuonAnalyser/interface/MuonSummary.h"
+
+#include "TTree.h"
+
+// struct with relevant data
+struct MuonData
+{
+  void init(); // initialize to default values
+  TTree* book(TTree *t);
+  //GE11-ME11 bending part, from/to the EDM product of GEMCSCBendingProducer
+  void fillBending(GEMCSCBending& bending) const;
+  void setBending(const GEMCSCBending& bending);
+  //muon kinematics, IDs, isolation and impact parameters, from the MuonAnalyser producer
+  void setSummary(const MuonSummary& summary);
+
+  Int_t lumi;
+  Int_t run;
+  Int_t event;
+
+  float muonPx, muonPy, muonPz;
+  float muondxy, muondz;
+  int muon_ntrackhit, muon_chi2, muon_nChamber;
+  float muonpt, muoneta, muonphi;
+  int muoncharge;
+  int muonendcap;
+  float muonPFIso, muonTkIso;
+  float prop_time;//time spent in propagation for this muon, us
+  
+  
+
+  bool has_TightID;
+  bool has_MediumID;
+  bool has_LooseID;
+  
+  bool hasGEMdata;
+  bool has_ME11[6];
+  bool has_GE11[2];
+
+  //Muon position at ME11
+  float rechit_phi_ME11[6];//phi at each layer, from CSC rechit
+  float rechit_eta_ME11[6];
+  float rechit_x_ME11[6];
+  float rechit_y_ME11[6];
+  float rechit_localx_ME11[6];
+  float rechit_localy_ME11[6];
+  float rechit_r_ME11[6];
+  float rechit_perp_ME11[6];
+  bool rechit_used_ME11[6];
+  int rechit_hitWire_ME11[6];
+  int rechit_centralStrip_ME11[6];
+  unsigned int rechit_nStrips_ME11[6]; 
+  int rechit_halfstrip_ME11[6]; //-1
+  int rechit_WG_ME11[6]; // -1
+  float rechit_L1eta_ME11[6];// -9
+  float rechit_L1phi_ME11[6]; //-9
+  
+      
+  int nrechit_ME11;
+
+  bool has_propME11[6];
+  float prop_phi_ME11[6];//projected position in ME11
+  float prop_eta_ME11[6];//projected position in ME11
+  float prop_x_ME11[6];//projected position in ME11
+  float prop_y_ME11[6];
+  float prop_localx_ME11[6];//projected position in ME11
+  float prop_localy_ME11[6];
+  float prop_r_ME11[6];
+  float prop_perp_ME11[6];
+  float propgt_x_ME11[6];//projected position in ME11
+  float propgt_y_ME11[6];
+  float propgt_eta_ME11[6];//projected position in ME11
+  float propgt_phi_ME11[6];
+  float propgt_r_ME11[6];
+  float propgt_perp_ME11[6];
+  float propgt_localx_ME11[6];//projected position in ME11
+  float propgt_localy_ME11[6];
+  float propinner_x_ME11[6];//projected position in ME11
+  float propinner_y_ME11[6];
+  float propinner_eta_ME11[6];//projected position in ME11
+  float propinner_phi_ME11[6];
+  float propinner_r_ME11[6];
+  float propinner_perp_ME11[6];
+  float propinner_localx_ME11[6];//projected position in ME11
+  float propinner_localy_ME11[6];
+  float rechit_prop_dR_ME11[6];
+  float rechit_prop_dphi_ME11[6];
+  float rechit_prop_RdPhi_ME11[6]; // 99999
+  float rechit_propgt_RdPhi_ME11[6]; // 99999
+  float rechit_propinner_RdPhi_ME11[6]; // 99999
+  int chamber_ME11[6];
+  int ring_ME11[6];
+  int chamber_propME11[6];
+  int ring_propME11[6];
+
+  bool has_prop_st[4];
+  int  prop_chamber_st[4];
+  int  prop_ring_st[4];
+  float prop_phi_st[4];
+  float prop_eta_st[4];
+  float prop_x_st[4];
+  float prop_y_st[4];
+  float prop_r_st[4];
+  float prop_perp_st[4];
+  float prop_localx_st[4];
+  float prop_localy_st[4];
+  float propgt_phi_st[4];
+  float propgt_eta_st[4];
+  float propgt_x_st[4];
+  float propgt_y_st[4];
+  float propgt_r_st[4];
+  float propgt_perp_st[4];
+  float propgt_localx_st[4];
+  float propgt_localy_st[4];
+  float propinner_phi_st[4];
+  float propinner_eta_st[4];
+  float propinner_x_st[4];
+  float propinner_y_st[4];
+  float propinner_r_st[4];
+  float propinner_perp_st[4];
+  float propinner_localx_st[4];
+  float propinner_localy_st[4];
+
+  //CSC segment matched to recoMuon
+  bool has_cscseg_st[4];
+  float cscseg_phi_st[4];
+  float cscseg_eta_st[4];
+  float cscseg_x_st[4];
+  float cscseg_y_st[4];
+  float cscseg_r_st[4];
+  float cscseg_localx_st[4];
+  float cscseg_localy_st[4];
+  float cscseg_perp_st[4];
+  float cscseg_prop_dR_st[4];
+  float cscseg_prop_dphi_st[4];
+  float cscseg_prop_RdPhi_st[4]; // 99999
+  float cscseg_propgt_RdPhi_st[4]; // 99999
+  float cscseg_propinner_RdPhi_st[4]; // 99999
+  float cscseg_strip_st[4];
+  float cscseg_stripangle_st[4];
+  int cscseg_chamber_st[4];
+  int cscseg_ring_st[4];
+  int ncscseg;
+  //match LCT to recoMuon by projection
+  bool has_csclct_st[4];
+  float csclct_phi_st[4];
+  float csclct_eta_st[4];
+  float csclct_x_st[4];
+  float csclct_y_st[4];
+  float csclct_r_st[4];
+  float csclct_perp_st[4];
+  float csclct_prop_dR_st[4];
+  float csclct_prop_dphi_st[4];
+  int    csclct_chamber_st[4];
+  int    csclct_ring_st[4];
+  int    csclct_keyStrip_st[4];
+  int    csclct_keyWG_st[4];
+  int    csclct_matchWin_st[4];
+  int    csclct_pattern_st[4];
+  int ncscLct;
+
+  //Muon position at GE11
+
+  //Muon position at GE11
+	
+  float stripangle_topology[2];
+  float stripangle_test[2];	
+  float cos_stripangle_test[2];
+  float sin_stripangle_test[2];
+  float stand_RdPhi_minus_GE11[2];
+  float gt_RdPhi_minus_GE11[2];
+  float inner_RdPhi_minus_GE11[2];
+
+  bool isGood_GE11[2];
+  int roll_rechitGE11[2];
+  int chamber_GE11[2];
+  float rechit_phi_GE11[2];//phi,eta from GE11 rechits
+  float rechit_alignedphi_GE11[2];//phi,eta from GE11 rechits
+  float rechit_eta_GE11[2];
+  float rechit_x_GE11[2];//rechit position in GE11
+  float rechit_y_GE11[2];
+  float rechit_r_GE11[2];
+  float rechit_perp_GE11[2];
+  float rechit_stripangle_GE11[2];
+  float rechit_localx_GE11[2];//rechit position in GE11
+  float rechit_alignedlocalx_GE11[2];//rechit position in GE11
+  float rechit_localy_GE11[2];
+  float rechit_localphi_GE11[2];
+  bool rechit_used_GE11[2];
+  int rechit_BX_GE11[2];//-1
+  int rechit_firstClusterStrip_GE11[2];//-1
+  int rechit_clusterSize_GE11[2];//-1
+  int nrechit_GE11;
+
+  bool has_propGE11[2];
+  int roll_propGE11[2];
+  int chamber_propGE11[2];
+  float middle_perp_propGE11[2];
+  float middle_perp_rechitGE11[2];
+  float prop_phi_GE11[2];//phi,eta from GE11 rechits
+  float prop_eta_GE11[2];
+  float prop_x_GE11[2];//projected position in GE11
+  float prop_y_GE11[2];
+  float prop_r_GE11[2];
+  float prop_perp_GE11[2];
+  float prop_localx_GE11[2];//projected position in GE11
+  float prop_localy_GE11[2];
+  float prop_localphi_rad_GE11[2];
+  float prop_localphi_deg_GE11[2];
+  float prop_localx_center_GE11[2];//projected position in GE11
+
+  float propgt_phi_GE11[2];//phi,eta from GE11 rechits
+  float propgt_eta_GE11[2];
+  float propgt_x_GE11[2];//projected position in GE11
+  float propgt_y_GE11[2];
+  float propgt_r_GE11[2];
+  float propgt_perp_GE11[2];
+  float propgt_localx_GE11[2];//projected position in GE11
+  float propgt_localy_GE11[2];
+  float propgt_localphi_deg_GE11[2];
+  float propgt_localphi_rad_GE11[2];
+  float propgt_localx_center_GE11[2];//projected position in GE11
+  float propinner_phi_GE11[2];//phi,eta from GE11 rechits
+  float propinner_eta_GE11[2];
+  float propinner_x_GE11[2];//projected position in GE11
+  float propinner_y_GE11[2];
+  float propinner_r_GE11[2];
+  float propinner_perp_GE11[2];
+  float propinner_localx_GE11[2];//projected position in GE11
+  float propinner_localy_GE11[2];
+  float propinner_localphi_rad_GE11[2];
+  float propinner_localphi_deg_GE11[2];
+  float propinner_localx_center_GE11[2];//projected position in GE11
+
+  float prop_strip_GE11[2];//projected position in GE11
+  float rechit_prop_dR_GE11[2];
+  float rechit_prop_dX_GE11[2]; // 99999
+  float rechit_prop_RdPhi_GE11[2]; // 99999
+  float rechit_propgt_RdPhi_GE11[2]; // 99999
+  float rechit_propinner_RdPhi_GE11[2]; // 99999
+  float rechit_prop_aligneddX_GE11[2]; // 99999
+  float rechit_prop_dphi_GE11[2];
+  float rechit_prop_aligneddphi_GE11[2];
+  float rechit_strip_GE11[2];
+  
+  //online
+  float dphi_CSCL1_GE11L1[2];//average CSC phi - GEM phi for each GEM layer
+  float dphi_fitCSCL1_GE11L1[2];// CSC phi from fit - GEM phi for each GEM layer
+  //offline
+  float dphi_CSCSeg_GE11Rechit[2];//average CSC phi - GEM phi for each GEM layer
+  float dphi_keyCSCRechit_GE11Rechit[2];// CSC phi in key layer - GEM phi for each GEM layer
+  float dphi_keyCSCRechitL1_GE11Rechit[2];// CSC phi in key layer - GEM phi for each GEM layer
+  float dphi_CSCRechits_GE11Rechit[2];// CSC phi from fit - GEM phi for each GEM layer
+
+  float dphi_CSCSeg_alignedGE11Rechit[2];//average CSC phi - GEM phi for each GEM layer
+  float dphi_keyCSCRechit_alignedGE11Rechit[2];// CSC phi in key layer - GEM phi for each GEM layer
+  float dphi_keyCSCRechitL1_alignedGE11Rechit[2];// CSC phi in key layer - GEM phi for each GEM layer
+  
+  //propagation
+  float dphi_propCSC_propGE11[2];//average CSC phi - GEM phi for each GEM layer
+
+  bool prop_has_fidcut_GE11[2];
+  bool gt_has_fidcut_GE11[2];
+  bool inner_has_fidcut_GE11[2];
+
+  //distance of the nearest candidate to the propagation, before any matching window, for the window scan
+  float cand_dX_GE11[2];//cm, local x, GEM rechits in the propagated and neighbouring rolls
+  float cand_dR_ME11[6];//cm, local dR, CSC rechits
+  float cand_dR_cscseg_st[4];//cm, local dR, CSC segments
+  float cand_dR_csclct_st[4];//cm, local dR, CSC LCTs
+
+  //alignment/strip ordering hypotheses evaluated on the same propagations, [hypothesis][layer]
+  //the hypothesis names are the bin labels of the alignmentHypotheses histogram
+  static const int kMaxHypotheses = 8;
+  int nHypotheses;
+  bool hyp_has_GE11[kMaxHypotheses][2];
+  float hyp_rechit_localx_GE11[kMaxHypotheses][2];//aligned local x of the nearest rechit
+  float hyp_rechit_phi_GE11[kMaxHypotheses][2];
+  float hyp_prop_dX_GE11[kMaxHypotheses][2]; // 99999
+  float hyp_prop_RdPhi_GE11[kMaxHypotheses][2]; // 99999
+  float hyp_propinner_RdPhi_GE11[kMaxHypotheses][2]; // 99999
+  float hyp_prop_dphi_GE11[kMaxHypotheses][2];
+  float hyp_dphi_CSCSeg_GE11Rechit[kMaxHypotheses][2];
+  float hyp_dphi_keyCSCRechit_GE11Rechit[kMaxHypotheses][2];
+  
+};
+
+#endif
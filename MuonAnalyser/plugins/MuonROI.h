@@ -0,0 +1,54 @@
+#ifndef GEMCSCBendingAnalyzer_MuonAnalyser_MuonROI_h
+#define GEMCSCBendingAnalyzer_MuonAnalyser_MuonROI_h
+
+// Region of interest of a reconstructed muon in the GE1/1 - ME1/1 station: the muon as a straight line
+// from its vertex through the innermost standalone muon hit (along its momentum without the track extra),
+// crossed with detector planes. Bending between that hit and GE1/1 is left to the margins of the users.
+// Used by GEMSkim and GEMCSCDigiROISelector.
+
+#include <cmath>
+
+#include "DataFormats/MuonReco/interface/Muon.h"
+#include "DataFormats/TrackReco/interface/Track.h"
+#include "DataFormats/GeometryVector/interface/GlobalPoint.h"
+#include "DataFormats/GeometryVector/interface/GlobalVector.h"
+#include "DataFormats/GeometryVector/interface/LocalPoint.h"
+#include "Geometry/CommonDetUnit/interface/GeomDet.h"
+
+namespace muonroi {
+
+  struct Line {
+    GlobalPoint origin;
+    GlobalVector direction;
+  };
+
+  inline Line muonLine(const reco::Muon& mu) {
+    Line line;
+    line.origin = GlobalPoint(mu.vertex().x(), mu.vertex().y(), mu.vertex().z());
+    line.direction = GlobalVector(mu.momentum().x(), mu.momentum().y(), mu.momentum().z());
+    const reco::TrackRef standalone = mu.standAloneMuon();
+    if (standalone.isNonnull() and standalone->extra().isAvailable())
+      line.direction = GlobalPoint(standalone->innerPosition().x(), standalone->innerPosition().y(), standalone->innerPosition().z()) - line.origin;
+    return line;
+  }
+
+  //local crossing point of the line with the plane of det, false if parallel or behind the origin
+  inline bool crossing(const Line& line, const GeomDet& det, LocalPoint& lp) {
+    const LocalPoint lp0 = det.toLocal(line.origin);
+    const LocalVector ld = det.toLocal(line.direction);
+    if (ld.z() == 0) return false;
+    const float t = -lp0.z()/ld.z();
+    if (t <= 0) return false;
+    lp = LocalPoint(lp0.x() + t*ld.x(), lp0.y() + t*ld.y(), 0.0);
+    return true;
+  }
+
+  //within the bounding rectangle of det enlarged by margin, cm
+  inline bool nearDet(const LocalPoint& lp, const GeomDet& det, float margin) {
+    const Bounds& bounds = det.surface().bounds();
+    return std::fabs(lp.y()) <= bounds.length()/2 + margin and std::fabs(lp.x()) <= bounds.width()/2 + margin;
+  }
+
+}
+
+#endif
@@ -0,0 +1,78 @@
+#include "SliceTestLumiSummary.h"
+
+#include "FWCore/ServiceRegistry/interface/Service.h"
+#include "CommonTools/UtilAlgos/interface/TFileService.h"
+
+SliceTestLumiSummary::SliceTestLumiSummary(const edm::ParameterSet& iConfig) :
+  selection_(iConfig)
+{
+  edm::Service<TFileService> fs;
+  tree_ = fs->make<TTree>("LumiData", "LumiData");
+  tree_->Branch("run", &run_);
+  tree_->Branch("lumi", &lumi_);
+  tree_->Branch("nMuons", &nMuons_);
+  tree_->Branch("GE11_den", GE11_den_, Form("GE11_den[%d]/I", kNGE11));
+  tree_->Branch("GE11_num", GE11_num_, Form("GE11_num[%d]/I", kNGE11));
+  tree_->Branch("GE11_RdPhi_n", GE11_RdPhi_n_, Form("GE11_RdPhi_n[%d]/I", kNGE11));
+  tree_->Branch("GE11_RdPhi_sum", GE11_RdPhi_sum_, Form("GE11_RdPhi_sum[%d]/D", kNGE11));
+  tree_->Branch("GE11_RdPhi_sum2", GE11_RdPhi_sum2_, Form("GE11_RdPhi_sum2[%d]/D", kNGE11));
+  tree_->Branch("ME11_den", ME11_den_, Form("ME11_den[%d]/I", kNME11));
+  tree_->Branch("ME11_num", ME11_num_, Form("ME11_num[%d]/I", kNME11));
+  reset();
+}
+
+void SliceTestLumiSummary::reset()
+{
+  nMuons_ = 0;
+  for (int i=0; i<kNGE11; ++i){
+    GE11_den_[i] = 0;
+    GE11_num_[i] = 0;
+    GE11_RdPhi_n_[i] = 0;
+    GE11_RdPhi_sum_[i] = 0.0;
+    GE11_RdPhi_sum2_[i] = 0.0;
+  }
+  for (int i=0; i<kNME11; ++i){
+    ME11_den_[i] = 0;
+    ME11_num_[i] = 0;
+  }
+}
+
+void SliceTestLumiSummary::fill(const MuonData& data)
+{
+  if (not selection_.muon(data)) return;
+  nMuons_++;
+  //propagations stay in the endcap of the muon
+  const int e = data.muonendcap > 0 ? 1 : 0;
+
+  for (int l=0; l<2; ++l){
+    const int ch = data.chamber_propGE11[l];
+    if (selection_.GE11Denominator(data, l) and ch >= 1 and ch <= kNChambers){
+      const int i = 2*(e*kNChambers + ch-1) + l;
+      GE11_den_[i]++;
+      if (selection_.GE11Matched(data, l)){
+	GE11_num_[i]++;
+	const double res = data.rechit_prop_RdPhi_GE11[l];
+	GE11_RdPhi_n_[i]++;
+	GE11_RdPhi_sum_[i] += res;
+	GE11_RdPhi_sum2_[i] += res*res;
+      }
+    }
+  }
+
+  const int ch = data.chamber_propME11[0];
+  if (ch < 1 or ch > kNChambers) return;
+  const int i = e*kNChambers + ch-1;
+  for (int l=0; l<kNCSCLayers; ++l){
+    if (not data.has_propME11[l]) continue;
+    ME11_den_[i]++;
+    if (selection_.ME11Matched(data, l)) ME11_num_[i]++;
+  }
+}
+
+void SliceTestLumiSummary::endLumi(int run, int lumi)
+{
+  run_ = run;
+  lumi_ = lumi;
+  tree_->Fill();
+  reset();
+}
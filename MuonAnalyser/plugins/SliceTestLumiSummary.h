@@ -0,0 +1,49 @@
+#ifndef GEMCSCBendingAnalyzer_MuonAnalyser_SliceTestLumiSummary_h
+#define GEMCSCBendingAnalyzer_MuonAnalyser_SliceTestLumiSummary_h
+
+// Per luminosity block counters: GE11/ME11 efficiency num/den per chamber and layer
+// and the GE11 residual sums, one LumiData entry per block instead of one entry per muon.
+// Sums (not means) are stored so that lumis can be merged into runs or eras afterwards.
+
+#include "FWCore/ParameterSet/interface/ParameterSet.h"
+
+#include "MuonData.h"
+#include "SliceTestSummary.h"
+
+#include "TTree.h"
+
+class SliceTestLumiSummary {
+public:
+  explicit SliceTestLumiSummary(const edm::ParameterSet& iConfig);
+
+  void fill(const MuonData& data);
+  //write the counters of the block and reset them
+  void endLumi(int run, int lumi);
+
+  static const int kNEndcaps = SliceTestSummary::kNEndcaps;
+  static const int kNChambers = SliceTestSummary::kNChambers;
+  static const int kNME11 = kNEndcaps*kNChambers;//index endcap*36 + chamber-1, endcap 0 minus, 1 plus
+  static const int kNGE11 = 2*kNME11;//index 2*(endcap*36 + chamber-1) + layer-1
+  static const int kNCSCLayers = SliceTestSummary::kNCSCLayers;
+
+private:
+  void reset();
+
+  SummarySelection selection_;
+
+  TTree* tree_;
+  Int_t run_;
+  Int_t lumi_;
+  Int_t nMuons_;//selected muons in the block
+  Int_t GE11_den_[kNGE11];
+  Int_t GE11_num_[kNGE11];
+  //GE11 RdPhi residual of the standalone propagation, matched hits, cm
+  Int_t GE11_RdPhi_n_[kNGE11];
+  Double_t GE11_RdPhi_sum_[kNGE11];
+  Double_t GE11_RdPhi_sum2_[kNGE11];
+  //ME11, summed over the six layers
+  Int_t ME11_den_[kNME11];
+  Int_t ME11_num_[kNME11];
+};
+
+#endif
@@ -0,0 +1,118 @@
+#include "SliceTestSummary.h"
+
+#include "FWCore/ServiceRegistry/interface/Service.h"
+#include "CommonTools/UtilAlgos/interface/TFileService.h"
+
+#include <cmath>
+
+SummarySelection::SummarySelection(const edm::ParameterSet& iConfig)
+{
+  requireTightID_ = iConfig.getUntrackedParameter<bool>("summaryRequireTightID", true);
+  minMuonPt_ = iConfig.getUntrackedParameter<double>("summaryMinMuonPt", 25.0);
+  maxGE11Dphi_ = iConfig.getUntrackedParameter<double>("summaryMaxGE11Dphi", 0.02);
+  maxME11DR_ = iConfig.getUntrackedParameter<double>("summaryMaxME11DR", 5.0);
+}
+
+bool SummarySelection::muon(const MuonData& data) const
+{
+  if (requireTightID_ and not data.has_TightID) return false;
+  return data.muonpt >= minMuonPt_;
+}
+
+bool SummarySelection::GE11Denominator(const MuonData& data, int layer) const
+{
+  return data.has_propGE11[layer] and data.has_cscseg_st[0] and data.cscseg_chamber_st[0] == data.chamber_propGE11[layer];
+}
+
+bool SummarySelection::GE11Matched(const MuonData& data, int layer) const
+{
+  return data.has_GE11[layer] and data.chamber_GE11[layer] == data.chamber_propGE11[layer] and std::abs(data.rechit_prop_dphi_GE11[layer]) < maxGE11Dphi_;
+}
+
+bool SummarySelection::ME11Matched(const MuonData& data, int layer) const
+{
+  return data.rechit_prop_dR_ME11[layer] < maxME11DR_;
+}
+
+SliceTestSummary::SliceTestSummary(const edm::ParameterSet& iConfig) :
+  selection_(iConfig)
+{
+  edm::Service<TFileService> fs;
+  TFileDirectory dir = fs->mkdir("summary");
+  const int nvfats = kNRolls*kNVFATsPerRoll;
+  const char* endcaps[kNEndcaps] = {"Em", "Ep"};
+  for (int e=0; e<kNEndcaps; ++e){
+    for (int i=0; i<2; ++i){
+      const int l = i+1;
+      h_GE11_den_[e][i] = dir.make<TH2D>(Form("GE11_den_%s_L%d", endcaps[e], l), Form("GE11 %s layer %d, propagated;chamber;roll", endcaps[e], l), kNChambers, 0.5, kNChambers+0.5, kNRolls, 0.5, kNRolls+0.5);
+      h_GE11_num_[e][i] = dir.make<TH2D>(Form("GE11_num_%s_L%d", endcaps[e], l), Form("GE11 %s layer %d, matched;chamber;roll", endcaps[e], l), kNChambers, 0.5, kNChambers+0.5, kNRolls, 0.5, kNRolls+0.5);
+      h_GE11_vfat_den_[e][i] = dir.make<TH2D>(Form("GE11_vfat_den_%s_L%d", endcaps[e], l), Form("GE11 %s layer %d, propagated;chamber;3*(roll-1)+VFAT", endcaps[e], l), kNChambers, 0.5, kNChambers+0.5, nvfats, -0.5, nvfats-0.5);
+      h_GE11_vfat_num_[e][i] = dir.make<TH2D>(Form("GE11_vfat_num_%s_L%d", endcaps[e], l), Form("GE11 %s layer %d, matched;chamber;3*(roll-1)+VFAT", endcaps[e], l), kNChambers, 0.5, kNChambers+0.5, nvfats, -0.5, nvfats-0.5);
+      h_GE11_dX_[e][i] = dir.make<TH3F>(Form("GE11_dX_%s_L%d", endcaps[e], l), Form("GE11 %s layer %d;chamber;roll;rechit - prop local x [cm]", endcaps[e], l), kNChambers, 0.5, kNChambers+0.5, kNRolls, 0.5, kNRolls+0.5, 100, -5.0, 5.0);
+      h_GE11_RdPhi_[e][i] = dir.make<TH3F>(Form("GE11_RdPhi_%s_L%d", endcaps[e], l), Form("GE11 %s layer %d;chamber;roll;R#Delta#phi [cm]", endcaps[e], l), kNChambers, 0.5, kNChambers+0.5, kNRolls, 0.5, kNRolls+0.5, 100, -5.0, 5.0);
+      h_GE11_vfat_RdPhi_[e][i] = dir.make<TH3F>(Form("GE11_vfat_RdPhi_%s_L%d", endcaps[e], l), Form("GE11 %s layer %d;chamber;3*(roll-1)+VFAT;R#Delta#phi [cm]", endcaps[e], l), kNChambers, 0.5, kNChambers+0.5, nvfats, -0.5, nvfats-0.5, 100, -5.0, 5.0);
+    }
+    h_ME11_den_[e] = dir.make<TH2D>(Form("ME11_den_%s", endcaps[e]), Form("ME11 %s, propagated;chamber;layer", endcaps[e]), kNChambers, 0.5, kNChambers+0.5, kNCSCLayers, 0.5, kNCSCLayers+0.5);
+    h_ME11_num_[e] = dir.make<TH2D>(Form("ME11_num_%s", endcaps[e]), Form("ME11 %s, matched;chamber;layer", endcaps[e]), kNChambers, 0.5, kNChambers+0.5, kNCSCLayers, 0.5, kNCSCLayers+0.5);
+  }
+  for (int i=0; i<2; ++i){
+    const int l = i+1;
+    h_dphi_CSCSeg_[i] = dir.make<TH2D>(Form("dphi_CSCSeg_GE11Rechit_L%d", l), Form("GEM layer %d;#phi_{CSC seg} - #phi_{GEM};muon p_{T} [GeV]", l), 90, -0.045, 0.045, 40, 0.0, 200.0);
+    h_dphi_keyCSCRechit_[i] = dir.make<TH2D>(Form("dphi_keyCSCRechit_GE11Rechit_L%d", l), Form("GEM layer %d;#phi_{CSC key} - #phi_{GEM};muon p_{T} [GeV]", l), 90, -0.045, 0.045, 40, 0.0, 200.0);
+    h_dphi_keyCSCRechit_aligned_[i] = dir.make<TH2D>(Form("dphi_keyCSCRechit_alignedGE11Rechit_L%d", l), Form("GEM layer %d, aligned;#phi_{CSC key} - #phi_{GEM};muon p_{T} [GeV]", l), 90, -0.045, 0.045, 40, 0.0, 200.0);
+    h_dphi_propCSC_propGE11_[i] = dir.make<TH2D>(Form("dphi_propCSC_propGE11_L%d", l), Form("GEM layer %d;#phi_{prop ME11} - #phi_{prop GE11};muon p_{T} [GeV]", l), 90, -0.045, 0.045, 40, 0.0, 200.0);
+  }
+}
+
+int SliceTestSummary::vfat(float strip)
+{
+  if (strip < 0) return -1;
+  const int v = int(strip)/128;
+  return v < kNVFATsPerRoll ? v : -1;
+}
+
+void SliceTestSummary::fill(const MuonData& data)
+{
+  if (not selection_.muon(data)) return;
+  const int e = endcap(data);
+
+  for (int i=0; i<2; ++i){
+    //GE11 efficiency, propagation in a chamber with a matching ME11 segment
+    const int ch = data.chamber_propGE11[i];
+    const int roll = data.roll_propGE11[i];
+    if (selection_.GE11Denominator(data, i)){
+      const bool matched = selection_.GE11Matched(data, i);
+      const int v = vfat(data.prop_strip_GE11[i]);
+      h_GE11_den_[e][i]->Fill(ch, roll);
+      if (matched) h_GE11_num_[e][i]->Fill(ch, roll);
+      if (v >= 0){
+	h_GE11_vfat_den_[e][i]->Fill(ch, (roll-1)*kNVFATsPerRoll + v);
+	if (matched) h_GE11_vfat_num_[e][i]->Fill(ch, (roll-1)*kNVFATsPerRoll + v);
+      }
+    }
+
+    if (data.has_GE11[i]){
+      h_GE11_dX_[e][i]->Fill(data.chamber_GE11[i], data.roll_rechitGE11[i], data.rechit_prop_dX_GE11[i]);
+      h_GE11_RdPhi_[e][i]->Fill(data.chamber_GE11[i], data.roll_rechitGE11[i], data.rechit_prop_RdPhi_GE11[i]);
+      const int v = vfat(data.rechit_strip_GE11[i]);
+      if (v >= 0)
+	h_GE11_vfat_RdPhi_[e][i]->Fill(data.chamber_GE11[i], (data.roll_rechitGE11[i]-1)*kNVFATsPerRoll + v, data.rechit_prop_RdPhi_GE11[i]);
+
+      //bending, as plotdeltaPhi of the plotting script
+      if (data.has_propGE11[i] and data.has_ME11[2]){
+	h_dphi_CSCSeg_[i]->Fill(data.dphi_CSCSeg_GE11Rechit[i], data.muonpt);
+	h_dphi_keyCSCRechit_[i]->Fill(data.dphi_keyCSCRechit_GE11Rechit[i], data.muonpt);
+	h_dphi_keyCSCRechit_aligned_[i]->Fill(data.dphi_keyCSCRechit_alignedGE11Rechit[i], data.muonpt);
+	h_dphi_propCSC_propGE11_[i]->Fill(data.dphi_propCSC_propGE11[i], data.muonpt);
+      }
+    }
+  }
+
+  //ME11 rechit efficiency per layer
+  for (int l=0; l<kNCSCLayers; ++l){
+    if (not data.has_propME11[l]) continue;
+    h_ME11_den_[e]->Fill(data.chamber_propME11[0], l+1);
+    if (selection_.ME11Matched(data, l))
+      h_ME11_num_[e]->Fill(data.chamber_propME11[0], l+1);
+  }
+}
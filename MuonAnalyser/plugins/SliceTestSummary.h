@@ -0,0 +1,78 @@
+#ifndef GEMCSCBendingAnalyzer_MuonAnalyser_SliceTestSummary_h
+#define GEMCSCBendingAnalyzer_MuonAnalyser_SliceTestSummary_h
+
+// Fixed size per endcap/chamber/roll/VFAT histograms filled directly from MuonData,
+// the routine efficiency, residual and bending plots without the ntuple.
+// Selections follow script/slicetest_makeplots.py; efficiencies are num/den pairs.
+
+#include "FWCore/ParameterSet/interface/ParameterSet.h"
+
+#include "MuonData.h"
+
+#include "TH1D.h"
+#include "TH2D.h"
+#include "TH3F.h"
+
+//muon selection and matching criteria, shared by the histograms and the per lumi counters
+class SummarySelection {
+public:
+  explicit SummarySelection(const edm::ParameterSet& iConfig);
+
+  //muon selection, as dencut of the plotting script
+  bool muon(const MuonData& data) const;
+  //GE11 propagation in a chamber with a matching ME11 segment, layer 0 or 1
+  bool GE11Denominator(const MuonData& data, int layer) const;
+  bool GE11Matched(const MuonData& data, int layer) const;
+  //ME11 layer 0..5
+  bool ME11Matched(const MuonData& data, int layer) const;
+
+private:
+  bool requireTightID_;
+  double minMuonPt_;//GeV
+  //GE11 rechit counted as efficient within this |dphi| to the propagation
+  double maxGE11Dphi_;
+  //ME11 rechit counted as efficient within this local dR to the propagation, cm
+  double maxME11DR_;
+};
+
+class SliceTestSummary {
+public:
+  explicit SliceTestSummary(const edm::ParameterSet& iConfig);
+
+  void fill(const MuonData& data);
+
+  static const int kNEndcaps = 2;//0 minus, 1 plus
+  static const int kNChambers = 36;
+  static const int kNRolls = 8;
+  static const int kNVFATsPerRoll = 3;//along the strips, 128 strips each
+  static const int kNCSCLayers = 6;
+
+private:
+  //0, 1, 2 along the strips, -1 outside
+  static int vfat(float strip);
+  //0 minus, 1 plus endcap of the muon, propagations are to the endcap of the muon
+  static int endcap(const MuonData& data) { return data.muonendcap > 0 ? 1 : 0; }
+
+  SummarySelection selection_;
+
+  //GE11 efficiency, per endcap and layer: chamber x roll and chamber x (roll, VFAT)
+  TH2D* h_GE11_den_[kNEndcaps][2];
+  TH2D* h_GE11_num_[kNEndcaps][2];
+  TH2D* h_GE11_vfat_den_[kNEndcaps][2];
+  TH2D* h_GE11_vfat_num_[kNEndcaps][2];
+  //GE11 residuals of the standalone propagation, per endcap and layer: chamber x roll x residual
+  TH3F* h_GE11_dX_[kNEndcaps][2];
+  TH3F* h_GE11_RdPhi_[kNEndcaps][2];
+  //chamber x (roll, VFAT) x residual
+  TH3F* h_GE11_vfat_RdPhi_[kNEndcaps][2];
+  //ME11 efficiency, per endcap: chamber x layer
+  TH2D* h_ME11_den_[kNEndcaps];
+  TH2D* h_ME11_num_[kNEndcaps];
+  //bending angles per GEM layer, dphi x muon pt
+  TH2D* h_dphi_CSCSeg_[2];
+  TH2D* h_dphi_keyCSCRechit_[2];
+  TH2D* h_dphi_keyCSCRechit_aligned_[2];
+  TH2D* h_dphi_propCSC_propGE11_[2];
+};
+
+#endif
@@ -0,0 +1,91 @@
+#include "SlowEventRecorder.h"
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+
+#include "FWCore/ServiceRegistry/interface/Service.h"
+#include "CommonTools/UtilAlgos/interface/TFileService.h"
+
+SlowEventRecorder::SlowEventRecorder(const edm::ParameterSet& iConfig) :
+  timeHist_(kNBins, 0)
+{
+  threshold_ = iConfig.getUntrackedParameter<double>("slowEventThreshold", 0.0);
+  percentile_ = iConfig.getUntrackedParameter<double>("slowEventPercentile", 0.99);
+  warmup_ = iConfig.getUntrackedParameter<unsigned int>("slowEventWarmup", 100);
+
+  edm::Service<TFileService> fs;
+  tree_ = fs->make<TTree>("SlowEvents", "SlowEvents");
+  tree_->Branch("run", &run_, "run/I");
+  tree_->Branch("lumi", &lumi_, "lumi/I");
+  tree_->Branch("event", &event_, "event/L");
+  tree_->Branch("time", &time_, "time/F");
+  tree_->Branch("fillTime", &fillTime_, "fillTime/F");
+  tree_->Branch("threshold", &threshold_used_, "threshold/F");
+  tree_->Branch("t_setup", &t_setup_, "t_setup/F");
+  tree_->Branch("t_inputs", &t_inputs_, "t_inputs/F");
+  tree_->Branch("t_muons", &t_muons_, "t_muons/F");
+  tree_->Branch("t_propagation", &t_propagation_, "t_propagation/F");
+  tree_->Branch("nMuons", &nMuons_, "nMuons/I");
+  tree_->Branch("nSelectedMuons", &nSelectedMuons_, "nSelectedMuons/I");
+  tree_->Branch("nGEMRecHits", &nGEMRecHits_, "nGEMRecHits/I");
+  tree_->Branch("nCSCRecHits", &nCSCRecHits_, "nCSCRecHits/I");
+  tree_->Branch("nCSCSegments", &nCSCSegments_, "nCSCSegments/I");
+  tree_->Branch("nLCTs", &nLCTs_, "nLCTs/I");
+  tree_->Branch("nAllocations", &nAllocations_, "nAllocations/L");
+  tree_->Branch("allocatedBytes", &allocatedBytes_, "allocatedBytes/L");
+}
+
+float SlowEventRecorder::percentileTime() const
+{
+  if (percentile_ <= 0 or nEvents_ < warmup_) return 0.0;
+  const double target = percentile_*nEvents_;
+  unsigned long sum = 0;
+  for (int i = 0; i < kNBins; ++i){
+    sum += timeHist_[i];
+    //upper edge of the bin
+    if (sum >= target) return kMinTime*std::pow(10.0, double(i+1)/kBinsPerDecade);
+  }
+  return kMinTime*std::pow(10.0, double(kNBins)/kBinsPerDecade);
+}
+
+void SlowEventRecorder::fill(int run, int lumi, long long event, float time, float fillTime, const GEMCSCBendingAlgo::EventStats& stats)
+{
+  //compared to the events before this one
+  const float current = percentileTime();
+
+  const int bin = time > kMinTime ? int(kBinsPerDecade*std::log10(time/kMinTime)) : 0;
+  timeHist_[std::min(bin, kNBins-1)]++;
+  nEvents_++;
+
+  const bool aboveThreshold = threshold_ > 0 and time > threshold_;
+  const bool abovePercentile = current > 0 and time > current;
+  if (not aboveThreshold and not abovePercentile) return;
+
+  nRecorded_++;
+  run_ = run;
+  lumi_ = lumi;
+  event_ = event;
+  time_ = time;
+  fillTime_ = fillTime;
+  threshold_used_ = aboveThreshold ? threshold_ : current;
+  t_setup_ = stats.t_setup/1000.0;
+  t_inputs_ = stats.t_inputs/1000.0;
+  t_muons_ = stats.t_muons/1000.0;
+  t_propagation_ = stats.t_propagation/1000.0;
+  nMuons_ = stats.nMuons;
+  nSelectedMuons_ = stats.nSelectedMuons;
+  nGEMRecHits_ = stats.nGEMRecHits;
+  nCSCRecHits_ = stats.nCSCRecHits;
+  nCSCSegments_ = stats.nCSCSegments;
+  nLCTs_ = stats.nLCTs;
+  nAllocations_ = stats.nAllocations;
+  allocatedBytes_ = stats.allocatedBytes;
+  tree_->Fill();
+}
+
+void SlowEventRecorder::printSummary(const std::string& module) const
+{
+  std::cout << module <<": slow events "<< nRecorded_ <<" of "<< nEvents_
+	    <<", threshold "<< threshold_ <<" ms, "<< percentile_ <<" percentile "<< percentileTime() <<" ms" << std::endl;
+}
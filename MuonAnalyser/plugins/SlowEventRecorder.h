@@ -0,0 +1,54 @@
+#ifndef GEMCSCBendingAnalyzer_MuonAnalyser_SlowEventRecorder_h
+#define GEMCSCBendingAnalyzer_MuonAnalyser_SlowEventRecorder_h
+
+// Events whose processing time is above slowEventThreshold (ms) or above the slowEventPercentile
+// of the events seen so far go to the SlowEvents tree with their collection sizes and stage timings,
+// so that they can be picked (run/lumi/event) and profiled alone.
+// The percentile is estimated from a log binned histogram of all event times and only applied
+// after slowEventWarmup events.
+
+#include <string>
+#include <vector>
+
+#include "FWCore/ParameterSet/interface/ParameterSet.h"
+
+#include "GEMCSCBendingAlgo.h"
+
+#include "TTree.h"
+
+class SlowEventRecorder {
+public:
+  explicit SlowEventRecorder(const edm::ParameterSet& iConfig);
+
+  //time: whole event, fillTime: ntuple and summaries, ms
+  void fill(int run, int lumi, long long event, float time, float fillTime, const GEMCSCBendingAlgo::EventStats& stats);
+  void printSummary(const std::string& module) const;
+
+private:
+  //time (ms) at the percentile of the events seen so far, 0 before the warmup
+  float percentileTime() const;
+
+  double threshold_;//ms, 0: off
+  double percentile_;//0: off
+  unsigned long warmup_;
+
+  //log binned event times, kBinsPerDecade from kMinTime
+  static constexpr double kMinTime = 1e-3;//ms
+  static constexpr int kBinsPerDecade = 20;
+  static constexpr int kNBins = 8*kBinsPerDecade;
+  std::vector<unsigned long> timeHist_;
+  unsigned long nEvents_ = 0;
+  unsigned long nRecorded_ = 0;
+
+  TTree* tree_;
+  Int_t run_, lumi_;
+  Long64_t event_;
+  float time_, fillTime_;
+  float threshold_used_;//ms, the threshold the event was compared to
+  float t_setup_, t_inputs_, t_muons_, t_propagation_;//ms
+  int nMuons_, nSelectedMuons_;
+  int nGEMRecHits_, nCSCRecHits_, nCSCSegments_, nLCTs_;
+  Long64_t nAllocations_, allocatedBytes_;
+};
+
+#endif
@@ -1,5 +0,0 @@
-import FWCore.ParameterSet.Config as cms
-
-demo = cms.EDAnalyzer('MuonAnalyser'
-     ,tracks = cms.untracked.InputTag('ctfWithMaterialTracks')
-)
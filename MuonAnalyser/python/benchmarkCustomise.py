@@ -0,0 +1,41 @@
+## customisations for throughput measurements, used by script/throughputBenchmark.py
+## on a local input, with threads, FastTimerService (per module CPU/real time in the job summary),
+## Timing (event throughput) and the framework summary (event counts), optionally on a local conditions snapshot
+import FWCore.ParameterSet.Config as cms
+
+def customiseLocalInput(process, fileNames, nEvents = -1):
+    ## replace the (remote) input of a configuration by local files, EmptySource is kept
+    if fileNames and process.source.type_() != "EmptySource":
+        process.source.fileNames = cms.untracked.vstring(['file:'+f if ':' not in f else f for f in fileNames])
+        if hasattr(process.source, "skipEvents"):
+            process.source.skipEvents = cms.untracked.uint32(0)
+    process.maxEvents = cms.untracked.PSet(input = cms.untracked.int32(nEvents))
+    return process
+
+def customiseTiming(process, threads = 1):
+    if not hasattr(process, "options"):
+        process.options = cms.untracked.PSet()
+    process.options.numberOfThreads = cms.untracked.uint32(threads)
+    process.options.numberOfStreams = cms.untracked.uint32(0)
+    process.options.wantSummary = cms.untracked.bool(True)
+
+    process.FastTimerService = cms.Service("FastTimerService",
+        enableDQM = cms.untracked.bool(False),
+        printEventSummary = cms.untracked.bool(False),
+        printRunSummary = cms.untracked.bool(False),
+        printJobSummary = cms.untracked.bool(True),
+    )
+    process.Timing = cms.Service("Timing",
+        summaryOnly = cms.untracked.bool(True),
+    )
+    ## no per event printout in the timed loop
+    if hasattr(process, "MessageLogger"):
+        process.MessageLogger.cerr.FwkReport.reportEvery = 100000
+    return process
+
+def customiseForBenchmark(process, threads = 1, fileNames = [], nEvents = -1, conditionsSnapshot = ""):
+    process = customiseLocalInput(process, fileNames, nEvents)
+    if conditionsSnapshot:
+        from GEMCSCBendingAnalyzer.MuonAnalyser.localConditionsCustomise import customiseLocalConditions
+        process = customiseLocalConditions(process, conditionsSnapshot)
+    return customiseTiming(process, threads)
@@ -0,0 +1,43 @@
+## GE1/1 muon skim and the event content SliceTestAnalysis reads, for skims of RECO data:
+##   process.load('GEMCSCBendingAnalyzer.MuonAnalyser.gemSkim_cff')
+##   process.GEMRecHitSkim = cms.Path(process.gemSkim)
+##   PoolOutputModule with outputCommands = SliceTestSkimEventContent.outputCommands and
+##   SelectEvents = cms.untracked.PSet(SelectEvents = cms.vstring('GEMRecHitSkim'))
+import FWCore.ParameterSet.Config as cms
+
+## endcap muon pointing at a slice test chamber (GE-1/1/27-30) with a GEM rechit within maxDistance
+gemSkim = cms.EDFilter("GEMSkim",
+    gemRecHits = cms.InputTag("gemRecHits"),
+    muons = cms.InputTag("muons"),
+    minMuonPt = cms.untracked.double(2.0),
+    minMuonEta = cms.untracked.double(1.4),
+    maxMuonEta = cms.untracked.double(2.5),
+    maxDistance = cms.untracked.double(10.0),#cm
+    instrumentedChambers = cms.untracked.vint32(-27, -28, -29, -30),#region*chamber, empty: all GE1/1
+)
+
+## inputs of SliceTestAnalysis, with the tracks, extras and rechits behind the muon references
+## (propagation starts from the standalone/global/inner track extras, the muon rechits are read
+## through the standalone/global tracks, the TeV refits are referenced by the muons)
+SliceTestSkimEventContent = cms.PSet(
+    outputCommands = cms.untracked.vstring(
+        'drop *',
+        'keep *_gemRecHits_*_*',
+        'keep *_csc2DRecHits_*_*',
+        'keep *_cscSegments_*_*',
+        'keep *_muonCSCDigis_MuonCSCCorrelatedLCTDigi_*',
+        'keep recoMuons_muons__*',
+        'keep recoTracks_standAloneMuons_*_*',
+        'keep recoTrackExtras_standAloneMuons_*_*',
+        'keep TrackingRecHitsOwned_standAloneMuons_*_*',
+        'keep recoTracks_globalMuons_*_*',
+        'keep recoTrackExtras_globalMuons_*_*',
+        'keep TrackingRecHitsOwned_globalMuons_*_*',
+        'keep *_tevMuons_*_*',
+        'keep recoTracks_generalTracks_*_*',
+        'keep recoTrackExtras_generalTracks_*_*',
+        'keep recoVertexs_offlinePrimaryVertices_*_*',
+        'keep recoBeamSpot_offlineBeamSpot_*_*',
+        'keep edmTriggerResults_*_*_*',
+    )
+)
@@ -0,0 +1,25 @@
+## conditions from a local snapshot written by script/conditionsSnapshot.py instead of the Frontier GlobalTag:
+## the GlobalTag ESSource is replaced by a PoolDBESSource reading only the sqlite file, so the job needs
+## no network and starts without the Frontier round trips
+##   snapshot.db    tags of the selected records, cut to the runs of the snapshot
+##   snapshot.json  globalTag, runs and the record/label/tag list of the snapshot
+## records missing from the snapshot fail in the job ("No data of type ..."), add them with --record
+import json
+import os
+import FWCore.ParameterSet.Config as cms
+
+def snapshotManifest(snapshot):
+    return os.path.splitext(snapshot)[0] + ".json"
+
+def customiseLocalConditions(process, snapshot):
+    manifest = json.load(open(snapshotManifest(snapshot)))
+    from CondCore.CondDB.CondDB_cfi import CondDB
+    process.GlobalTag = cms.ESSource("PoolDBESSource",
+        CondDB.clone(connect = cms.string('sqlite_file:' + os.path.abspath(snapshot))),
+        globaltag = cms.string(''),
+        toGet = cms.VPSet([cms.PSet(record = cms.string(r["record"]),
+                                    tag = cms.string(r["tag"]),
+                                    label = cms.untracked.string(r["label"])) for r in manifest["records"]]),
+    )
+    print("conditions from %s: %d records of %s, runs %s"%(snapshot, len(manifest["records"]), manifest["globalTag"], manifest["runs"]))
+    return process
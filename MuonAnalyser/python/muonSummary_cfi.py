@@ -0,0 +1,10 @@
+## per muon summary (MuonAnalyser producer) read by SliceTestAnalysis and GEMCSCBendingProducer
+## through their muonSummary parameter (cms.InputTag("muonSummary"), this module's label).
+## They depend on it: schedule it in a Path before them, they stop with an exception if it is missing.
+## SliceTestAnalysis needs it also with a bendingProduct: keep *_muonSummary_*_* with the product.
+import FWCore.ParameterSet.Config as cms
+
+muonSummary = cms.EDProducer('MuonAnalyser',
+    muons = cms.InputTag("muons"),
+    vertexCollection = cms.InputTag("offlinePrimaryVertices"),
+)
@@ -0,0 +1,82 @@
+## local snapshot of the conditions a configuration reads from its GlobalTag: geometry, alignment and
+## magnetic field records by default, copied from Frontier into a sqlite file with conddb_import
+## then run without network with python/localConditionsCustomise.py, e.g. conditionsSnapshot=snapshot.db
+## of test/runSliceTestAnalysis.py or --conditions snapshot.db of throughputBenchmark.py
+##
+## python conditionsSnapshot.py -c ../test/runSliceTestAnalysis.py --runs 321475 -o snapshot.db
+## python conditionsSnapshot.py -g 102X_dataRun2_Prompt_v1 --runs 320500:321475 --record "CSC*Rcd" -o snapshot.db
+##
+## --runs limits the IOVs copied, jobs on runs outside the range find no conditions; without it the full tags
+## are copied. Run it where Frontier is reachable, the snapshot (.db and .json) can then be moved anywhere.
+import argparse
+import fnmatch
+import json
+import os
+import subprocess
+import sys
+
+## records of the geometry (GeometryRecoDB), alignment and magnetic field (MagneticField_AutoFromDBCurrent)
+defaultRecords = [
+    "GeometryFileRcd", "*GeometryRcd", "*ParametersRcd",
+    "PGeometricDet*Rcd", "PEcal*Rcd", "PHcalRcd", "PZdcRcd", "PCastorRcd", "PCaloTowerRcd",
+    "*AlignmentRcd", "*AlignmentErrorRcd", "*AlignmentErrorExtendedRcd", "*SurfaceDeformationRcd", "GlobalPositionRcd",
+    "MagFieldConfigRcd", "MFGeometryFileRcd", "RunInfoRcd",
+]
+
+parser = argparse.ArgumentParser(description="copy the conditions records of a GlobalTag into a local sqlite snapshot")
+parser.add_argument("-c", "--config", help="cmsRun configuration, its GlobalTag is used")
+parser.add_argument("-g", "--globaltag", help="GlobalTag, instead of --config")
+parser.add_argument("--runs", default="", help="run or first:last, IOVs copied")
+parser.add_argument("--record", action="append", default=[], help="extra record pattern")
+parser.add_argument("--all", action="store_true", help="every record of the GlobalTag")
+parser.add_argument("--source", default="frontier://FrontierProd/CMS_CONDITIONS", help="conditions database")
+parser.add_argument("-o", "--output", default="snapshot.db", help="sqlite file, the manifest goes next to it as .json")
+opts = parser.parse_args()
+
+def configGlobalTag(config):
+    ## the configuration as cmsRun builds it, without its own command line options
+    sys.argv = sys.argv[:1]
+    scope = {}
+    exec(open(config).read(), scope)
+    return scope["process"].GlobalTag.globaltag.value()
+
+globalTag = opts.globaltag or (configGlobalTag(opts.config) if opts.config else None)
+if not globalTag:
+    parser.error("give --config or --globaltag")
+
+## record, label, tag of the GlobalTag, from the conddb table: Record Label Tag, '-' for no label
+tags = []
+listing = subprocess.check_output(["conddb", "--nocolors", "list", globalTag]).decode()
+for line in listing.splitlines():
+    fields = line.split()
+    if len(fields) not in (2, 3) or not fields[0].endswith("Rcd"):
+        continue
+    label = fields[1] if len(fields) == 3 else ""
+    tags.append({"record": fields[0], "label": "" if label == "-" else label, "tag": fields[-1]})
+if not tags:
+    print("no tags found for %s:\n%s"%(globalTag, listing))
+    sys.exit(1)
+
+patterns = ["*"] if opts.all else defaultRecords + opts.record
+selected = [t for t in tags if any(fnmatch.fnmatch(t["record"], p) for p in patterns)]
+print("%s: %d of %d records selected"%(globalTag, len(selected), len(tags)))
+
+runs = opts.runs.split(":") if opts.runs else []
+if len(runs) == 1:
+    runs = runs*2
+if os.path.exists(opts.output):
+    os.remove(opts.output)
+## a tag used by several records or labels is copied once
+for tag in sorted(set(t["tag"] for t in selected)):
+    command = ["conddb_import", "-f", opts.source, "-c", "sqlite_file:" + opts.output, "-i", tag, "-t", tag]
+    if runs:
+        command += ["-b", runs[0], "-e", runs[1]]
+    print("   " + tag)
+    if subprocess.call(command, stdout=open(os.devnull, "w")) != 0:
+        print("conddb_import failed for %s: %s"%(tag, " ".join(command)))
+        sys.exit(1)
+
+manifest = os.path.splitext(opts.output)[0] + ".json"
+json.dump({"globalTag": globalTag, "runs": opts.runs or "all", "source": opts.source, "records": selected},
+          open(manifest, "w"), indent=2, sort_keys=True)
+print("snapshot written to %s and %s (%.1f MB)"%(opts.output, manifest, os.path.getsize(opts.output)/1024.0/1024.0))
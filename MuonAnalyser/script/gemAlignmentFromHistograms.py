@@ -0,0 +1,95 @@
+## GE11 alignment from the alignment histograms of SliceTestAnalysis (fillAlignment = True),
+## after merging the outputs of several jobs with hadd; same estimator as GEMAlignmentEstimator::write
+## usage: python gemAlignmentFromHistograms.py merged.root [GEMAlignment_cff.py] [minEntries] [window] [GEMAlignmentTable.txt]
+import ROOT
+import math
+import sys
+
+fname = sys.argv[1]
+output = sys.argv[2] if len(sys.argv) > 2 else "GEMAlignment_cff.py"
+minEntries = int(sys.argv[3]) if len(sys.argv) > 3 else 60
+window = float(sys.argv[4]) if len(sys.argv) > 4 else 1.0
+tableOutput = sys.argv[5] if len(sys.argv) > 5 else "GEMAlignmentTable.txt"
+
+tfile = ROOT.TFile(fname)
+adir = tfile.Get("SliceTestAnalysis/alignment")
+if not adir:
+    print("SliceTestAnalysis/alignment not found in %s"%fname)
+    sys.exit(1)
+
+def rollMean(h, chbin, rollbin):
+    axis = h.GetZaxis()
+    center = 0.0
+    halfWidth = axis.GetXmax() - axis.GetXmin()
+    mean = 0.0; error = 0.0
+    for it in range(3):
+        n = 0.0; s = 0.0; s2 = 0.0
+        for b in range(1, axis.GetNbins()+1):
+            x = axis.GetBinCenter(b)
+            if abs(x - center) > halfWidth:
+                continue
+            w = h.GetBinContent(chbin, rollbin, b)
+            n += w; s += w*x; s2 += w*x*x
+        if n < minEntries:
+            return None
+        mean = s/n
+        error = math.sqrt(max(s2/n - mean*mean, 0.0)/n)
+        center = mean
+        halfWidth = window
+    return (mean, error)
+
+def fit(endcap, layer, ch):
+    h = adir.Get("GE11_residual_%s_L%d"%(endcap, layer))
+    hr = adir.Get("GE11_radius_%s_L%d"%(endcap, layer))
+    sw = swr = swm = swrr = swrm = 0.0
+    entries = 0; nrolls = 0
+    for roll in range(1, 9):
+        entries += int(hr.GetBinEntries(hr.GetBin(ch, roll)))
+        m = rollMean(h, ch, roll)
+        if m is None:
+            continue
+        r = hr.GetBinContent(ch, roll)
+        w = 1.0/(m[1]*m[1]) if m[1] > 0 else 1.0
+        sw += w; swr += w*r; swm += w*m[0]; swrr += w*r*r; swrm += w*r*m[0]
+        nrolls += 1
+    if nrolls == 0:
+        return (0.0, 0.0, entries, 0, 0.0)
+    det = sw*swrr - swr*swr
+    rotation = (sw*swrm - swr*swm)/det if nrolls >= 2 and det > 0 else 0.0
+    return (swm/sw, rotation, entries, nrolls, swr/sw)
+
+out = open(output, "w")
+out.write("## GE11 alignment from in-job residuals, prop - rechit local x\n")
+out.write("## rechit local x is shifted by deltaX, rotation is the residual slope vs radius [rad]\n")
+out.write("## endcap chamber layer deltaX[cm] rotation[rad] entries rolls\n")
+for endcap, region in [("Em", -1), ("Ep", 1)]:
+    for ch in range(1, 37):
+        for layer in [1, 2]:
+            corr = fit(endcap, layer, ch)
+            if corr[3] == 0:
+                continue
+            out.write("# %d %d %d %g %g %d %d\n"%(region, ch, layer, corr[0], corr[1], corr[2], corr[3]))
+## GEM_alginment_deltaX has no rotation, the rotation is applied through the table below
+slice = [fit("Em", layer, ch) for ch in range(27, 31) for layer in [1, 2]]
+out.write("import FWCore.ParameterSet.Config as cms\n")
+out.write("GEM_alginment_deltaX = cms.vdouble(%s)\n"%(", ".join("%f"%c[0] for c in slice)))
+out.close()
+print("alignment written to %s"%output)
+
+## GEMAlignmentTable format, rotation folded into one shift per roll
+table = open(tableOutput, "w")
+table.write("# region chamber layer roll deltaX[cm] rotation[rad], see GEMAlignmentTable.h\n")
+table.write("# rotation vs radius folded into the shift at the centre of each roll\n")
+for endcap, region in [("Em", -1), ("Ep", 1)]:
+    for ch in range(1, 37):
+        for layer in [1, 2]:
+            corr = fit(endcap, layer, ch)
+            if corr[3] == 0:
+                continue
+            hr = adir.Get("GE11_radius_%s_L%d"%(endcap, layer))
+            for roll in range(1, 9):
+                r = hr.GetBinContent(ch, roll)
+                shift = corr[0] + corr[1]*(r - corr[4]) if r > 0 else corr[0]
+                table.write("%d %d %d %d %g 0\n"%(region, ch, layer, roll, shift))
+table.close()
+print("alignment table written to %s"%tableOutput)
@@ -0,0 +1,58 @@
+## summarize the output of test/runPropagatorBenchmark.py
+## mean propagation time per muon for each propagator and the position differences
+## at GE11 and ME11 (key layer) with respect to the reference propagator
+import ROOT
+import math
+import sys
+
+fname = sys.argv[1] if len(sys.argv) > 1 else "propagatorBenchmark.root"
+labels = ["Stepping", "SteppingNoErr", "Smart", "SmartRK", "FastHelix"]
+tracks = ["prop", "propgt", "propinner"]
+
+tfile = ROOT.TFile(fname)
+
+def readTree(label):
+    tree = tfile.Get("SliceTestAnalysis"+label+"/MuonData")
+    if not tree:
+        return None
+    entries = {}
+    for ev in tree:
+        key = (ev.run, ev.lumi, ev.event, round(ev.muonpt, 3))
+        pos = {}
+        for t in tracks:
+            pos[t+"_GE11"] = [(getattr(ev, t+"_localx_GE11")[i], getattr(ev, t+"_localy_GE11")[i]) if ev.has_propGE11[i] else None for i in range(2)]
+            pos[t+"_ME11"] = (getattr(ev, t+"_localx_ME11")[2], getattr(ev, t+"_localy_ME11")[2]) if ev.has_propME11[2] else None
+        entries[key] = (ev.prop_time, pos)
+    return entries
+
+def rms(values):
+    return math.sqrt(sum(v*v for v in values)/len(values)) if len(values) else -1.0
+
+ref = readTree(labels[0])
+if ref is None:
+    print("reference tree SliceTestAnalysis%s/MuonData not found in %s"%(labels[0], fname))
+    sys.exit(1)
+
+print("%-14s %8s %14s   %s"%("propagator", "muons", "time/muon[us]", "RMS local dx,dy [cm] wrt "+labels[0]+" (GE11 | ME11)"))
+for label in labels:
+    entries = readTree(label)
+    if entries is None:
+        continue
+    times = [v[0] for v in entries.values()]
+    line = "%-14s %8d %14.1f  "%(label, len(times), sum(times)/len(times) if len(times) else 0.0)
+    for t in tracks:
+        dGE11 = [[], []]
+        dME11 = [[], []]
+        for key, (time, pos) in entries.items():
+            if key not in ref:
+                continue
+            refpos = ref[key][1]
+            for i in range(2):
+                if pos[t+"_GE11"][i] and refpos[t+"_GE11"][i]:
+                    dGE11[0].append(pos[t+"_GE11"][i][0] - refpos[t+"_GE11"][i][0])
+                    dGE11[1].append(pos[t+"_GE11"][i][1] - refpos[t+"_GE11"][i][1])
+            if pos[t+"_ME11"] and refpos[t+"_ME11"]:
+                dME11[0].append(pos[t+"_ME11"][0] - refpos[t+"_ME11"][0])
+                dME11[1].append(pos[t+"_ME11"][1] - refpos[t+"_ME11"][1])
+        line += " %s: %.4f,%.4f | %.4f,%.4f "%(t, rms(dGE11[0]), rms(dGE11[1]), rms(dME11[0]), rms(dME11[1]))
+    print(line)
@@ -0,0 +1,202 @@
+## physics equivalence check of an optimized configuration against a reference
+## runs both cmsRun configurations on the same input, each in its own directory, then compares the
+## MuonData trees branch by branch, muon by muon, and prints throughput and memory side by side
+##
+## python regressionCompare.py -r ../test/runSliceTestAnalysis.py -c myOptimized_cfg.py \
+##        --args "inputFiles=file:/data/step3.root" -n 2000
+## python regressionCompare.py --compare-only ref/out_ana.root cand/out_ana.root
+##
+## tolerances are absolute, on |candidate - reference| per element, first matching pattern wins:
+##        -t "prop_*=1e-3" -t "*_dphi*=1e-5" -i "*_time"
+## exit status 1 if any branch is out of tolerance or muons are missing on either side
+## each configuration is run through a wrapper that limits the events (-n) and sets wantSummary for
+## the event count; wall time includes the job start-up, use enough events
+import ROOT
+import argparse
+import fnmatch
+import math
+import os
+import subprocess
+import sys
+import time
+
+parser = argparse.ArgumentParser(description="compare MuonData trees of a reference and a candidate configuration")
+parser.add_argument("-r", "--reference", help="reference cmsRun configuration")
+parser.add_argument("-c", "--candidate", help="candidate cmsRun configuration")
+parser.add_argument("--args", default="", help="cmsRun arguments of both jobs, e.g. inputFiles=...")
+parser.add_argument("-n", "--events", type=int, default=1000, help="events per job, -1: all")
+parser.add_argument("--reference-args", default="", help="extra cmsRun arguments of the reference job")
+parser.add_argument("--candidate-args", default="", help="extra cmsRun arguments of the candidate job")
+parser.add_argument("-o", "--output", default="out_ana.root", help="TFileService file name of the configurations")
+parser.add_argument("-d", "--tree", default="SliceTestAnalysis/MuonData", help="tree path in the output file")
+parser.add_argument("-w", "--workdir", default="regression", help="directory for the two jobs")
+parser.add_argument("-t", "--tolerance", action="append", default=[], help="pattern=absolute tolerance")
+parser.add_argument("-i", "--ignore", action="append", default=[], help="branch pattern not compared")
+parser.add_argument("--default-tolerance", type=float, default=1e-5, help="for float branches without a pattern, integers are exact")
+parser.add_argument("--compare-only", nargs=2, metavar=("REFERENCE", "CANDIDATE"), help="compare two existing output files")
+parser.add_argument("-v", "--verbose", type=int, default=3, help="differing muons printed per branch")
+opts = parser.parse_args()
+
+## timing and per muon bookkeeping, expected to differ
+ignored = ["prop_time", "*_time"] + opts.ignore
+tolerances = []
+for t in opts.tolerance:
+    pattern, value = t.split("=")
+    tolerances.append((pattern, float(value)))
+
+## wrapper configuration: the configuration as is (it parses the same arguments), then the event
+## limit and the framework summary, which gives the event count
+wrapper = """exec(open(%(config)r).read())
+import FWCore.ParameterSet.Config as cms
+process.maxEvents = cms.untracked.PSet(input = cms.untracked.int32(%(events)d))
+if not hasattr(process, "options"):
+    process.options = cms.untracked.PSet()
+process.options.wantSummary = cms.untracked.bool(True)
+"""
+
+def runJob(label, config, args):
+    ## run cmsRun in workdir/label, return wall time [s], peak RSS [MB] and number of events
+    jobdir = os.path.join(opts.workdir, label)
+    if not os.path.isdir(jobdir):
+        os.makedirs(jobdir)
+    open(os.path.join(jobdir, "regression_cfg.py"), "w").write(wrapper%{"config": os.path.abspath(config), "events": opts.events})
+    cmd = ["cmsRun", "regression_cfg.py"] + args.split()
+    print("%s: %s"%(label, " ".join(cmd)))
+    log = open(os.path.join(jobdir, "cmsRun.log"), "w")
+    start = time.time()
+    proc = subprocess.Popen(cmd, cwd=jobdir, stdout=log, stderr=subprocess.STDOUT)
+    pid, status, usage = os.wait4(proc.pid, 0)
+    wall = time.time() - start
+    log.close()
+    if status != 0:
+        print("%s: cmsRun failed with status %d, see %s"%(label, status, log.name))
+        sys.exit(2)
+    ## ru_maxrss is in kB on linux
+    return wall, usage.ru_maxrss/1024.0, countEvents(log.name), os.path.join(jobdir, opts.output)
+
+def countEvents(logname):
+    ## from the framework summary (wantSummary), -1 if not there
+    for line in open(logname):
+        if line.startswith("TrigReport Events total ="):
+            return int(line.split()[4])
+    return -1
+
+def readTree(fname):
+    ## {(run, lumi, event, muon pt): {branch: [values]}} and the branch types
+    tfile = ROOT.TFile.Open(fname)
+    if not tfile or tfile.IsZombie():
+        print("cannot open %s"%fname)
+        sys.exit(2)
+    tree = tfile.Get(opts.tree)
+    if not tree:
+        print("tree %s not found in %s"%(opts.tree, fname))
+        sys.exit(2)
+    leaves = []
+    for leaf in tree.GetListOfLeaves():
+        name = leaf.GetName()
+        if any(fnmatch.fnmatch(name, p) for p in ignored):
+            continue
+        leaves.append((name, leaf, leaf.GetTypeName() in ["Float_t", "Double_t"]))
+    entries = {}
+    for i in range(tree.GetEntries()):
+        tree.GetEntry(i)
+        values = {}
+        for name, leaf, isFloat in leaves:
+            values[name] = [leaf.GetValue(j) for j in range(leaf.GetNdata())]
+        key = (tree.run, tree.lumi, tree.event, round(tree.muonpt, 3))
+        ## several muons with the same pt in one event are numbered in tree order
+        while key in entries:
+            key = key + (0,)
+        entries[key] = values
+    types = dict((name, isFloat) for name, leaf, isFloat in leaves)
+    tfile.Close()
+    return entries, types
+
+def tolerance(name, isFloat):
+    for pattern, value in tolerances:
+        if fnmatch.fnmatch(name, pattern):
+            return value
+    return opts.default_tolerance if isFloat else 0.0
+
+def differs(a, b, tol):
+    if math.isnan(a) or math.isnan(b):
+        return not (math.isnan(a) and math.isnan(b))
+    return abs(a - b) > tol
+
+def compare(refname, candname):
+    ref, refTypes = readTree(refname)
+    cand, candTypes = readTree(candname)
+    failed = False
+
+    onlyRef = sorted(set(refTypes) - set(candTypes))
+    onlyCand = sorted(set(candTypes) - set(refTypes))
+    if onlyRef:
+        print("branches only in the reference: %s"%", ".join(onlyRef))
+    if onlyCand:
+        print("branches only in the candidate: %s"%", ".join(onlyCand))
+
+    missing = [k for k in ref if k not in cand]
+    extra = [k for k in cand if k not in ref]
+    print("muons: reference %d, candidate %d, missing in candidate %d, extra in candidate %d"%(len(ref), len(cand), len(missing), len(extra)))
+    for k in (missing + extra)[:opts.verbose]:
+        print("   %s run %d lumi %d event %d pt %.3f"%("missing" if k in missing else "extra", k[0], k[1], k[2], k[3]))
+    if missing or extra:
+        failed = True
+
+    common = [k for k in ref if k in cand]
+    print("%-32s %8s %8s %12s %10s"%("branch", "values", "differ", "max |diff|", "tolerance"))
+    for name in sorted(set(refTypes) & set(candTypes)):
+        tol = tolerance(name, refTypes[name])
+        nValues = 0
+        nDiffer = 0
+        maxDiff = 0.0
+        examples = []
+        for k in common:
+            a = ref[k][name]
+            b = cand[k][name]
+            if len(a) != len(b):
+                nDiffer += 1
+                if len(examples) < opts.verbose:
+                    examples.append("event %d pt %.3f: %d values vs %d"%(k[2], k[3], len(a), len(b)))
+                continue
+            for i in range(len(a)):
+                nValues += 1
+                if differs(a[i], b[i], tol):
+                    nDiffer += 1
+                    if not (math.isnan(a[i]) or math.isnan(b[i])):
+                        maxDiff = max(maxDiff, abs(a[i] - b[i]))
+                    if len(examples) < opts.verbose:
+                        examples.append("event %d pt %.3f [%d]: %g vs %g"%(k[2], k[3], i, a[i], b[i]))
+        if nDiffer:
+            failed = True
+            print("%-32s %8d %8d %12.4g %10.2g"%(name, nValues, nDiffer, maxDiff, tol))
+            for e in examples:
+                print("      %s"%e)
+    return failed
+
+def delta(ref, cand):
+    return "%+.1f%%"%(100.0*(cand - ref)/ref) if ref > 0 else "-"
+
+if opts.compare_only:
+    failed = compare(opts.compare_only[0], opts.compare_only[1])
+else:
+    if not opts.reference or not opts.candidate:
+        parser.error("give --reference and --candidate, or --compare-only")
+    refJob = runJob("reference", opts.reference, opts.args+" "+opts.reference_args)
+    candJob = runJob("candidate", opts.candidate, opts.args+" "+opts.candidate_args)
+
+    print("")
+    print("%-20s %12s %12s %10s"%("", "reference", "candidate", "delta"))
+    print("%-20s %12.1f %12.1f %10s"%("wall time [s]", refJob[0], candJob[0], delta(refJob[0], candJob[0])))
+    if refJob[2] > 0 and candJob[2] > 0:
+        refRate = refJob[2]/refJob[0]
+        candRate = candJob[2]/candJob[0]
+        print("%-20s %12.2f %12.2f %10s"%("events/s", refRate, candRate, delta(refRate, candRate)))
+    else:
+        print("events/s: no event count in the cmsRun logs")
+    print("%-20s %12.1f %12.1f %10s"%("peak RSS [MB]", refJob[1], candJob[1], delta(refJob[1], candJob[1])))
+    print("")
+    failed = compare(refJob[3], candJob[3])
+
+print("physics output %s"%("DIFFERS" if failed else "unchanged within tolerances"))
+sys.exit(1 if failed else 0)
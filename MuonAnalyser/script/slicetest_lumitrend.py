@@ -0,0 +1,83 @@
+## GE11/ME11 efficiency and GE11 residual trends from the LumiData tree of SliceTestAnalysis
+## (fillLumiSummary = True); lumi blocks are merged per run, or per N lumis with a second argument
+## usage: python slicetest_lumitrend.py out_ana.root [lumisPerPoint] [plotdir]
+import ROOT
+import math
+import os
+import sys
+
+ROOT.gROOT.SetBatch(1)
+
+fname = sys.argv[1] if len(sys.argv) > 1 else "out_ana.root"
+lumisPerPoint = int(sys.argv[2]) if len(sys.argv) > 2 else 0
+plotdir = sys.argv[3] if len(sys.argv) > 3 else "lumitrend"
+if not os.path.isdir(plotdir):
+    os.makedirs(plotdir)
+chambers = [-27, -28, -29, -30]#region*chamber, as instrumentedChambers of gemSkim_cff
+
+chain = ROOT.TChain("SliceTestAnalysis/LumiData")
+chain.Add(fname)
+
+## (run, lumi block group) -> summed counters
+points = {}
+for ev in chain:
+    key = (ev.run, ev.lumi/lumisPerPoint if lumisPerPoint > 0 else 0)
+    if key not in points:
+        points[key] = {"GE11_den":[0]*len(ev.GE11_den), "GE11_num":[0]*len(ev.GE11_num),
+                       "n":[0]*len(ev.GE11_den), "sum":[0.0]*len(ev.GE11_den), "sum2":[0.0]*len(ev.GE11_den),
+                       "ME11_den":[0]*len(ev.ME11_den), "ME11_num":[0]*len(ev.ME11_num)}
+    p = points[key]
+    for i in range(len(ev.GE11_den)):
+        p["GE11_den"][i] += ev.GE11_den[i]
+        p["GE11_num"][i] += ev.GE11_num[i]
+        p["n"][i] += ev.GE11_RdPhi_n[i]
+        p["sum"][i] += ev.GE11_RdPhi_sum[i]
+        p["sum2"][i] += ev.GE11_RdPhi_sum2[i]
+    for i in range(len(ev.ME11_den)):
+        p["ME11_den"][i] += ev.ME11_den[i]
+        p["ME11_num"][i] += ev.ME11_num[i]
+
+keys = sorted(points.keys())
+labels = ["%d"%run if lumisPerPoint <= 0 else "%d:%d"%(run, group*lumisPerPoint) for run, group in keys]
+
+def trend(name, title, values):
+    ## values: list of (value, error) per point
+    h = ROOT.TH1F(name, title, len(keys), 0, len(keys))
+    for i, (v, e) in enumerate(values):
+        h.GetXaxis().SetBinLabel(i+1, labels[i])
+        if v is None:
+            continue
+        h.SetBinContent(i+1, v)
+        h.SetBinError(i+1, e)
+    c1 = ROOT.TCanvas("c1","c1",1000,600)
+    h.SetStats(0)
+    h.SetMarkerStyle(20)
+    h.Draw("e1p")
+    c1.SaveAs(os.path.join(plotdir, name+".png"))
+
+def efficiency(num, den):
+    if den == 0:
+        return (None, 0.0)
+    eff = float(num)/den
+    return (eff, math.sqrt(eff*(1.0-eff)/den))
+
+def meanAndError(n, s, s2):
+    if n < 2:
+        return (None, 0.0)
+    mean = s/n
+    rms = math.sqrt(max(s2/n - mean*mean, 0.0))
+    return (mean, rms/math.sqrt(n))
+
+## LumiData index: endcap*36 + chamber-1 for ME11, twice that + layer-1 for GE11, endcap 0 minus, 1 plus
+for signedCh in chambers:
+    ch = abs(signedCh)
+    endcap = 1 if signedCh > 0 else 0
+    j = endcap*36 + ch-1
+    for layer in [1, 2]:
+        i = 2*j + layer-1
+        trend("GE11_eff_ch%d_L%d"%(signedCh, layer), "GE11 chamber %d layer %d;;efficiency"%(signedCh, layer),
+              [efficiency(points[k]["GE11_num"][i], points[k]["GE11_den"][i]) for k in keys])
+        trend("GE11_RdPhi_ch%d_L%d"%(signedCh, layer), "GE11 chamber %d layer %d;;mean R#Delta#phi [cm]"%(signedCh, layer),
+              [meanAndError(points[k]["n"][i], points[k]["sum"][i], points[k]["sum2"][i]) for k in keys])
+    trend("ME11_eff_ch%d"%signedCh, "ME11 chamber %d;;efficiency"%signedCh,
+          [efficiency(points[k]["ME11_num"][j], points[k]["ME11_den"][j]) for k in keys])
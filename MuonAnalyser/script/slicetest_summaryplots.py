@@ -0,0 +1,70 @@
+## plots from the summary histograms of SliceTestAnalysis (fillSummary = True)
+## GE11/ME11 efficiencies from the num/den pairs, residual mean and width per roll and VFAT, per endcap (Em, Ep)
+## usage: python slicetest_summaryplots.py out_ana.root [plotdir]
+import ROOT
+import os
+import sys
+
+ROOT.gROOT.SetBatch(1)
+ROOT.gStyle.SetOptStat(0)
+ROOT.gStyle.SetPaintTextFormat(".3f")
+
+fname = sys.argv[1] if len(sys.argv) > 1 else "out_ana.root"
+plotdir = sys.argv[2] if len(sys.argv) > 2 else "summaryplots"
+if not os.path.isdir(plotdir):
+    os.makedirs(plotdir)
+
+tfile = ROOT.TFile(fname)
+sdir = tfile.Get("SliceTestAnalysis/summary")
+if not sdir:
+    print("SliceTestAnalysis/summary not found in %s"%fname)
+    sys.exit(1)
+
+def save(obj, name, option):
+    c1 = ROOT.TCanvas("c1","c1",800,600)
+    obj.Draw(option)
+    c1.SaveAs(os.path.join(plotdir, name+".png"))
+
+## efficiency maps, num/den with binomial errors
+def plotEfficiency(num, den, name):
+    hnum = sdir.Get(num)
+    hden = sdir.Get(den)
+    if hden.GetEntries() == 0:
+        return
+    eff = hnum.Clone(name)
+    eff.Divide(hnum, hden, 1.0, 1.0, "B")
+    eff.SetMinimum(0.0)
+    eff.SetMaximum(1.0)
+    save(eff, name, "colztext")
+    print("%-16s %8d / %8d = %.4f"%(name, hnum.GetEntries(), hden.GetEntries(), hnum.GetEntries()/hden.GetEntries()))
+
+## mean and RMS of the residual in each (chamber, y) bin of a TH3
+def plotResidual(name, ytitle):
+    h3 = sdir.Get(name)
+    if h3.GetEntries() == 0:
+        return
+    mean = h3.Project3DProfile("yx")
+    mean.SetName(name+"_mean")
+    mean.SetTitle(h3.GetTitle()+", mean;chamber;"+ytitle)
+    save(mean, name+"_mean", "colztext")
+    width = h3.Project3DProfile("yx")
+    width.SetName(name+"_rms")
+    width.SetErrorOption("s")
+    hw = width.ProjectionXY(name+"_rms_xy", "C=E")
+    hw.SetTitle(h3.GetTitle()+", RMS;chamber;"+ytitle)
+    save(hw, name+"_rms", "colztext")
+
+for endcap in ["Em", "Ep"]:
+    for layer in [1, 2]:
+        tag = "%s_L%d"%(endcap, layer)
+        plotEfficiency("GE11_num_"+tag, "GE11_den_"+tag, "GE11_eff_"+tag)
+        plotEfficiency("GE11_vfat_num_"+tag, "GE11_vfat_den_"+tag, "GE11_vfat_eff_"+tag)
+        plotResidual("GE11_dX_"+tag, "roll")
+        plotResidual("GE11_RdPhi_"+tag, "roll")
+        plotResidual("GE11_vfat_RdPhi_"+tag, "3*(roll-1)+VFAT")
+    plotEfficiency("ME11_num_"+endcap, "ME11_den_"+endcap, "ME11_eff_"+endcap)
+for layer in [1, 2]:
+    for dphi in ["dphi_CSCSeg_GE11Rechit", "dphi_keyCSCRechit_GE11Rechit", "dphi_keyCSCRechit_alignedGE11Rechit", "dphi_propCSC_propGE11"]:
+        h = sdir.Get(dphi+"_L%d"%layer)
+        if h.GetEntries() > 0:
+            save(h, dphi+"_L%d"%layer, "colz")
@@ -0,0 +1,30 @@
+## list the events of the SlowEvents tree (recordSlowEvents of SliceTestAnalysis), slowest first,
+## and write them as an event range fragment to rerun or profile them alone:
+##   python slowEventList.py out_ana.root [maxEvents] > slowEvents_cff.py
+##   then in the configuration: process.source.eventsToProcess = cms.untracked.VEventRange(slowEvents)
+import ROOT
+import sys
+
+fname = sys.argv[1] if len(sys.argv) > 1 else "out_ana.root"
+maxEvents = int(sys.argv[2]) if len(sys.argv) > 2 else 100
+
+tfile = ROOT.TFile(fname)
+tree = tfile.Get("SliceTestAnalysis/SlowEvents")
+if not tree:
+    sys.stderr.write("tree SliceTestAnalysis/SlowEvents not found in %s\n"%fname)
+    sys.exit(1)
+
+events = []
+for ev in tree:
+    events.append((ev.time, ev.run, ev.lumi, ev.event, ev.t_setup, ev.t_inputs, ev.t_muons, ev.t_propagation,
+                   ev.nMuons, ev.nGEMRecHits, ev.nCSCRecHits, ev.nCSCSegments, ev.nLCTs, ev.nAllocations))
+events.sort(reverse=True)
+
+sys.stderr.write("%8s %8s %12s %9s %9s %9s %9s %9s %6s %8s %8s %8s %6s %8s\n"%("run", "lumi", "event", "time[ms]", "setup", "inputs", "muons", "prop", "nMuon", "GEMhits", "CSChits", "segments", "LCTs", "allocs"))
+for e in events[:maxEvents]:
+    sys.stderr.write("%8d %8d %12d %9.2f %9.2f %9.2f %9.2f %9.2f %6d %8d %8d %8d %6d %8d\n"%(e[1], e[2], e[3], e[0], e[4], e[5], e[6], e[7], e[8], e[9], e[10], e[11], e[12], e[13]))
+
+print("slowEvents = [")
+for e in events[:maxEvents]:
+    print("    '%d:%d:%d',"%(e[1], e[2], e[3]))
+print("]")
@@ -0,0 +1,120 @@
+## throughput of the test/ workflows on a fixed local input at several thread counts
+## each workflow configuration is run unchanged apart from python/benchmarkCustomise.py
+## (local input, threads, FastTimerService, Timing), results go to a JSON report:
+##   {release, host, nEvents, workflows: {name: {threads: {events_per_s, wall_s, peak_rss_mb, modules: {label: {cpu_ms, real_ms}}}}}}
+## module times are per event, from the FastTimerService job summary
+##
+## python throughputBenchmark.py --input sliceTest=/data/SingleMuon_RECO.root --input reco=/data/SingleMuon_RAW-RECO.root \
+##        --input hitRate=/data/GEN-SIM-DIGI.root -n 1000 -j 1,2,4,8 -o benchmark_$CMSSW_VERSION.json
+## compare two reports (e.g. two releases): python throughputBenchmark.py --compare old.json new.json
+## offline and with a fixed conditions content: --conditions snapshot.db from conditionsSnapshot.py
+import argparse
+import json
+import os
+import re
+import socket
+import subprocess
+import sys
+import time
+
+testdir = os.path.join(os.path.dirname(os.path.abspath(__file__)), "..", "test")
+## name: configuration in test/
+workflows = {
+    "sliceTest": "runSliceTestAnalysis.py",
+    "reco": "runRAW2DIGI_RECO_Ana.py",
+    "hitRate": "runHitRateAnalysis.py",
+    "synthetic": "runSyntheticBenchmark.py",
+}
+
+parser = argparse.ArgumentParser(description="throughput vs threads of the test/ workflows")
+parser.add_argument("--input", action="append", default=[], help="workflow=local file[,file], only these workflows are run; synthetic needs no file")
+parser.add_argument("-n", "--events", type=int, default=1000, help="events per job")
+parser.add_argument("-j", "--threads", default="1,2,4,8", help="comma separated thread counts")
+parser.add_argument("-w", "--workdir", default="throughput", help="directory for the jobs")
+parser.add_argument("-o", "--output", default="throughputBenchmark.json", help="JSON report")
+parser.add_argument("--conditions", default="", help="local conditions snapshot (conditionsSnapshot.py) instead of the GlobalTag")
+parser.add_argument("--compare", nargs=2, metavar=("OLD", "NEW"), help="print the events/s and RSS of two reports side by side")
+opts = parser.parse_args()
+
+## wrapper configuration: the workflow as is, then the benchmark customisation
+wrapper = """import sys
+sys.argv = sys.argv[:1]
+exec(open(%(config)r).read())
+from GEMCSCBendingAnalyzer.MuonAnalyser.benchmarkCustomise import customiseForBenchmark
+process = customiseForBenchmark(process, %(threads)d, %(files)r, %(events)d, %(conditions)r)
+import json
+json.dump(sorted(list(process.producers_()) + list(process.filters_()) + list(process.analyzers_())), open("modules.json", "w"))
+"""
+
+fastReport = re.compile(r"^FastReport\s+([0-9.]+) ms\s+([0-9.]+) ms.*\s(\S+)\s*$")
+throughput = re.compile(r"Event Throughput:\s*([0-9.eE+-]+)")
+
+def runJob(name, config, files, threads):
+    jobdir = os.path.join(opts.workdir, "%s_%dt"%(name, threads))
+    if not os.path.isdir(jobdir):
+        os.makedirs(jobdir)
+    open(os.path.join(jobdir, "benchmark_cfg.py"), "w").write(wrapper%{"config": os.path.abspath(config), "threads": threads, "files": [os.path.abspath(f) for f in files], "events": opts.events, "conditions": os.path.abspath(opts.conditions) if opts.conditions else ""})
+    print("%s, %d threads: %s"%(name, threads, jobdir))
+    log = open(os.path.join(jobdir, "cmsRun.log"), "w")
+    start = time.time()
+    proc = subprocess.Popen(["cmsRun", "benchmark_cfg.py"], cwd=jobdir, stdout=log, stderr=subprocess.STDOUT)
+    pid, status, usage = os.wait4(proc.pid, 0)
+    wall = time.time() - start
+    log.close()
+    if status != 0:
+        print("   cmsRun failed with status %d, see %s"%(status, log.name))
+        return None
+
+    result = {"wall_s": wall, "peak_rss_mb": usage.ru_maxrss/1024.0, "events_per_s": -1.0, "events": -1, "modules": {}}
+    labels = set(json.load(open(os.path.join(jobdir, "modules.json"))))
+    for line in open(log.name):
+        if line.startswith("TrigReport Events total ="):
+            result["events"] = int(line.split()[4])
+        m = throughput.search(line)
+        if m:
+            result["events_per_s"] = float(m.group(1))
+        m = fastReport.match(line)
+        ## the job summary comes last, keep the last value per module
+        if m and m.group(3) in labels:
+            result["modules"][m.group(3)] = {"cpu_ms": float(m.group(1)), "real_ms": float(m.group(2))}
+    ## without the Timing summary: events over wall time, start-up included
+    if result["events_per_s"] < 0 and result["events"] > 0:
+        result["events_per_s"] = result["events"]/wall
+    print("   %.2f events/s, peak RSS %.0f MB"%(result["events_per_s"], result["peak_rss_mb"]))
+    return result
+
+def compare(old, new):
+    print("%-12s %7s %12s %12s %8s %10s %10s %8s"%("workflow", "threads", "old ev/s", "new ev/s", "delta", "old RSS", "new RSS", "delta"))
+    for name in sorted(new["workflows"]):
+        for threads in sorted(new["workflows"][name], key=int):
+            n = new["workflows"][name][threads]
+            o = old["workflows"].get(name, {}).get(threads)
+            if o is None:
+                continue
+            print("%-12s %7s %12.2f %12.2f %+7.1f%% %10.0f %10.0f %+7.1f%%"%(name, threads, o["events_per_s"], n["events_per_s"],
+                  100.0*(n["events_per_s"] - o["events_per_s"])/o["events_per_s"] if o["events_per_s"] > 0 else 0.0,
+                  o["peak_rss_mb"], n["peak_rss_mb"], 100.0*(n["peak_rss_mb"] - o["peak_rss_mb"])/o["peak_rss_mb"] if o["peak_rss_mb"] > 0 else 0.0))
+
+if opts.compare:
+    compare(json.load(open(opts.compare[0])), json.load(open(opts.compare[1])))
+    sys.exit(0)
+
+inputs = {}
+for i in opts.input:
+    name, files = i.split("=") if "=" in i else (i, "")
+    if name not in workflows:
+        parser.error("unknown workflow %s, known: %s"%(name, ", ".join(sorted(workflows))))
+    inputs[name] = [f for f in files.split(",") if f]
+if not inputs:
+    parser.error("give at least one --input workflow=file")
+
+report = {"release": os.environ.get("CMSSW_VERSION", "unknown"), "host": socket.gethostname(), "nEvents": opts.events, "conditions": opts.conditions, "workflows": {}}
+for name in sorted(inputs):
+    report["workflows"][name] = {}
+    for threads in [int(j) for j in opts.threads.split(",")]:
+        result = runJob(name, os.path.join(testdir, workflows[name]), inputs[name], threads)
+        if result:
+            report["workflows"][name][str(threads)] = result
+    ## written after every workflow, partial results survive a failing job
+    json.dump(report, open(opts.output, "w"), indent=2, sort_keys=True)
+print("report written to %s"%opts.output)
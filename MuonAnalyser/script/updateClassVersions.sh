@@ -0,0 +1,27 @@
+#!/bin/bash
+## regenerate the ClassVersion checksums of src/classes_def.xml with edmCheckClassVersion,
+## after scram b of the package (cmsenv in the release area):
+##   ./script/updateClassVersions.sh          write the checksums of the current members
+##   ./script/updateClassVersions.sh --check  only compare them, as scram b does
+## bump ClassVersion (and add a <version> line) first when a stored class changes its members
+
+if [ -z "$CMSSW_BASE" ]; then
+    echo "run cmsenv first"
+    exit 1
+fi
+lib=$CMSSW_BASE/lib/$SCRAM_ARCH/libGEMCSCBendingAnalyzerMuonAnalyser.so
+if [ ! -f $lib ]; then
+    echo "no $lib, run scram b first"
+    exit 1
+fi
+
+cd $(dirname $0)/../src
+if [ "$1" == "--check" ]; then
+    edmCheckClassVersion -l $lib -x classes_def.xml
+    exit $?
+fi
+edmCheckClassVersion -l $lib -x classes_def.xml -g || exit 1
+if [ -f classes_def.xml.generated ]; then
+    mv classes_def.xml.generated classes_def.xml
+    echo "updated src/classes_def.xml"
+fi
@@ -0,0 +1,28 @@
+#include "GEMCSCBendingAnalyzer/MuonAnalyser/interface/GEMCSCBending.h"
+
+GEMCSCBending::GEMCSCBending() :
+  valid(false),
+  has_cscseg(false), cscseg_chamber(-1), cscseg_ring(-1), cscseg_phi(-9),
+  has_ME11(false), rechit_phi_ME11(-9), rechit_L1phi_ME11(-9),
+  has_propME11(false), prop_phi_ME11(-9)
+{
+  for (int i=0; i<2; ++i){
+    has_GE11[i] = false;
+    chamber_GE11[i] = 0;
+    roll_GE11[i] = 0;
+    rechit_phi_GE11[i] = -9;
+    rechit_alignedphi_GE11[i] = -9;
+    rechit_localx_GE11[i] = 99999.0;
+    has_propGE11[i] = false;
+    prop_phi_GE11[i] = -9;
+    prop_localx_GE11[i] = 999999.0;
+
+    dphi_CSCSeg_GE11Rechit[i] = -9;
+    dphi_CSCSeg_alignedGE11Rechit[i] = -9;
+    dphi_keyCSCRechit_GE11Rechit[i] = -9;
+    dphi_keyCSCRechit_alignedGE11Rechit[i] = -9;
+    dphi_keyCSCRechitL1_GE11Rechit[i] = -9;
+    dphi_keyCSCRechitL1_alignedGE11Rechit[i] = -9;
+    dphi_propCSC_propGE11[i] = -9;
+  }
+}
@@ -0,0 +1,15 @@
+#include "GEMCSCBendingAnalyzer/MuonAnalyser/interface/MuonSummary.h"
+
+MuonSummary::MuonSummary() :
+  pt(0.), eta(-9.), phi(-9.),
+  px(-999999), py(-999999), pz(-999999),
+  charge(-9),
+  isGlobal(false), isStandAlone(false), isTracker(false),
+  hasInnerTrack(false),
+  hasTightID(false), hasMediumID(false), hasLooseID(false),
+  nChamber(0), nTrackerLayers(0), globalChi2(0),
+  pfIso(-999999), tkIso(-999999),
+  hasGoodVertex(false), dxy(-1), dz(-99999),
+  endcap(-9), inME11(false), inGE11(false)
+{
+}
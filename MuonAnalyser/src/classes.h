@@ -0,0 +1,17 @@
+#include "GEMCSCBendingAnalyzer/MuonAnalyser/interface/GEMCSCBending.h"
+#include "GEMCSCBendingAnalyzer/MuonAnalyser/interface/MuonSummary.h"
+#include "DataFormats/Common/interface/ValueMap.h"
+#include "DataFormats/Common/interface/Wrapper.h"
+
+namespace GEMCSCBendingAnalyzer_MuonAnalyser {
+  struct dictionary {
+    GEMCSCBending b;
+    GEMCSCBendingCollection bs;
+    edm::ValueMap<GEMCSCBending> vmb;
+    edm::Wrapper<edm::ValueMap<GEMCSCBending> > wvmb;
+    MuonSummary s;
+    MuonSummaryCollection ss;
+    edm::ValueMap<MuonSummary> vms;
+    edm::Wrapper<edm::ValueMap<MuonSummary> > wvms;
+  };
+}
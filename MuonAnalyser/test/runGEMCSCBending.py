@@ -0,0 +1,88 @@
+## produce the GE11-ME11 bending as edm::ValueMap<GEMCSCBending> over the muon collection,
+## fill the bending branches of the MuonData tree from it and optionally keep it in an EDM file
+import FWCore.ParameterSet.Config as cms
+from Configuration.StandardSequences.Eras import eras
+
+process = cms.Process('GEMCSCBending',eras.Run2_2017,eras.run3_GEM)
+
+process.load("FWCore.MessageService.MessageLogger_cfi")
+process.load('Configuration.StandardSequences.GeometryRecoDB_cff')
+process.load('Configuration.StandardSequences.MagneticField_AutoFromDBCurrent_cff')
+process.load('Configuration.StandardSequences.FrontierConditions_GlobalTag_cff')
+process.load('RecoMuon.TrackingTools.MuonServiceProxy_cff')
+process.load('GEMCSCBendingAnalyzer.MuonAnalyser.muonSummary_cfi')
+process.load('TrackingTools.TransientTrack.TransientTrackBuilder_cfi')
+from Configuration.AlCa.GlobalTag import GlobalTag
+process.GlobalTag = GlobalTag(process.GlobalTag, '102X_dataRun2_Prompt_v1', '')
+process.MessageLogger.cerr.FwkReport.reportEvery = 500
+
+from FWCore.ParameterSet.VarParsing import VarParsing
+options = VarParsing('analysis')
+options.register ('nEvents',
+                      1000,
+                  VarParsing.multiplicity.singleton,
+                  VarParsing.varType.int,
+                  "Number of events")
+options.register ('keepProduct',
+                      False,
+                  VarParsing.multiplicity.singleton,
+                  VarParsing.varType.bool,
+                  "Write muons and bending product to an EDM file")
+options.parseArguments()
+
+process.maxEvents = cms.untracked.PSet(
+    input = cms.untracked.int32(options.nEvents)
+)
+process.source = cms.Source("PoolSource",
+                            fileNames = cms.untracked.vstring(options.inputFiles),
+                            inputCommands = cms.untracked.vstring(
+		"keep *",
+                "drop TotemTimingDigiedmDetSetVector_totemTimingRawToDigi_TotemTiming_reRECO",
+                "drop TotemTimingRecHitedmDetSetVector_totemTimingRecHits__reRECO"
+                )
+                            )
+if len(process.source.fileNames) == 0:
+    process.source.fileNames = cms.untracked.vstring('root://cms-xrd-global.cern.ch//store/data/Run2018D/SingleMuon/MINIAOD/PromptReco-v2/000/321/475/00000/AA10A5A1-77A6-E811-B57C-FA163EF0320D.root')
+
+process.options = cms.untracked.PSet()
+process.TFileService = cms.Service("TFileService",fileName =cms.string("out_ana.root"))
+
+process.gemcscBending = cms.EDProducer('GEMCSCBendingProducer',
+    process.MuonServiceProxy,
+    gemRecHits = cms.InputTag("gemRecHits"),
+    cscRecHits = cms.InputTag("csc2DRecHits"),
+    csclcts = cms.InputTag("muonCSCDigis", "MuonCSCCorrelatedLCTDigi"),
+    cscSegments = cms.InputTag("cscSegments"),
+    muons = cms.InputTag("muons"),
+    muonSummary = cms.InputTag("muonSummary"),
+    matchMuonwithLCT = cms.untracked.bool(False),
+    matchMuonwithCSCRechit = cms.untracked.bool(False),
+    useFastPropagator = cms.untracked.bool(False),
+    standalonePropagator = cms.untracked.string("SteppingHelixPropagatorAny"),
+    globalPropagator = cms.untracked.string("SteppingHelixPropagatorAny"),
+    innerPropagator = cms.untracked.string("SteppingHelixPropagatorAny"),
+    concurrentPropagation = cms.untracked.bool(False),
+    GEM_alginment_deltaX = cms.vdouble(-0.16968, -0.1421, 0.1139,  0.1242,  -0.30713,  -0.33472, 0.37761, 0.36531),
+)
+
+## thin consumer, no propagation
+process.SliceTestAnalysis = cms.EDAnalyzer('SliceTestAnalysis',
+    muons = cms.InputTag("muons"),
+    bendingProduct = cms.untracked.InputTag("gemcscBending"),
+    muonSummary = cms.InputTag("muonSummary"),
+)
+
+process.p = cms.Path(process.muonSummary*process.gemcscBending*process.SliceTestAnalysis)
+
+## keep the product for later passes
+if options.keepProduct:
+    process.out = cms.OutputModule("PoolOutputModule",
+        fileName = cms.untracked.string("gemcscBending.root"),
+        outputCommands = cms.untracked.vstring(
+            "drop *",
+            "keep recoMuons_muons_*_*",
+            "keep *_gemcscBending_*_*",
+            "keep *_muonSummary_*_*",
+        )
+    )
+    process.e = cms.EndPath(process.out)
@@ -0,0 +1,47 @@
+## skim of RECO files for SliceTestAnalysis: events with an endcap muon at a slice test GE1/1 chamber
+## with a nearby rechit, written with only the collections SliceTestAnalysis reads
+##   cmsRun runGEMSkim.py inputFiles=file:step3.root outputFile=gemSkim.root
+import FWCore.ParameterSet.Config as cms
+from Configuration.StandardSequences.Eras import eras
+
+process = cms.Process('GEMSkim',eras.Run2_2017,eras.run3_GEM)
+
+process.load("FWCore.MessageService.MessageLogger_cfi")
+process.load('Configuration.StandardSequences.GeometryRecoDB_cff')
+process.load('Configuration.StandardSequences.FrontierConditions_GlobalTag_cff')
+process.load('GEMCSCBendingAnalyzer.MuonAnalyser.gemSkim_cff')
+from Configuration.AlCa.GlobalTag import GlobalTag
+process.GlobalTag = GlobalTag(process.GlobalTag, '102X_dataRun2_Prompt_v1', '')
+process.MessageLogger.cerr.FwkReport.reportEvery = 5000
+
+from FWCore.ParameterSet.VarParsing import VarParsing
+options = VarParsing('analysis')
+options.register ('nEvents',
+                      -1,
+                  VarParsing.multiplicity.singleton,
+                  VarParsing.varType.int,
+                  "Number of events")
+options.register ('conditionsSnapshot',
+                  '',
+                  VarParsing.multiplicity.singleton,
+                  VarParsing.varType.string,
+                  "local conditions snapshot (script/conditionsSnapshot.py) instead of the Frontier GlobalTag")
+options.setDefault('outputFile', 'gemSkim.root')
+options.parseArguments()
+
+process.maxEvents = cms.untracked.PSet(input = cms.untracked.int32(options.nEvents))
+process.source = cms.Source("PoolSource", fileNames = cms.untracked.vstring(options.inputFiles))
+process.options = cms.untracked.PSet(wantSummary = cms.untracked.bool(True))
+
+process.GEMRecHitSkim = cms.Path(process.gemSkim)
+
+process.SKIMoutput = cms.OutputModule("PoolOutputModule",
+    process.SliceTestSkimEventContent,
+    fileName = cms.untracked.string(options.outputFile),
+    SelectEvents = cms.untracked.PSet(SelectEvents = cms.vstring('GEMRecHitSkim')),
+)
+process.SKIMoutput_step = cms.EndPath(process.SKIMoutput)
+
+if options.conditionsSnapshot:
+    from GEMCSCBendingAnalyzer.MuonAnalyser.localConditionsCustomise import customiseLocalConditions
+    process = customiseLocalConditions(process, options.conditionsSnapshot)
@@ -0,0 +1,40 @@
+## write the GE1/1 eta partitions and ME1/1 layers of the geometry of runSliceTestAnalysis.py to a binary cache
+## for SliceTestAnalysis (geometryCache) and the standalone tools (bin/gemcscGeometryCache.cc)
+##   cmsRun runGeometryCacheWriter.py run=321475 outputFile=GE11ME11Geometry.bin [conditionsSnapshot=snapshot.db]
+import FWCore.ParameterSet.Config as cms
+from Configuration.StandardSequences.Eras import eras
+
+process = cms.Process('GeometryCacheWriter',eras.Run2_2017,eras.run3_GEM)
+
+process.load("FWCore.MessageService.MessageLogger_cfi")
+process.load('Configuration.StandardSequences.GeometryRecoDB_cff')
+process.load('Configuration.StandardSequences.FrontierConditions_GlobalTag_cff')
+from Configuration.AlCa.GlobalTag import GlobalTag
+process.GlobalTag = GlobalTag(process.GlobalTag, '102X_dataRun2_Prompt_v1', '')
+
+from FWCore.ParameterSet.VarParsing import VarParsing
+options = VarParsing('analysis')
+options.register ('run',
+                  321475,
+                  VarParsing.multiplicity.singleton,
+                  VarParsing.varType.int,
+                  "run of the geometry and alignment conditions")
+options.register ('conditionsSnapshot',
+                  '',
+                  VarParsing.multiplicity.singleton,
+                  VarParsing.varType.string,
+                  "local conditions snapshot (script/conditionsSnapshot.py) instead of the Frontier GlobalTag")
+options.setDefault('outputFile', 'GE11ME11Geometry.bin')
+options.parseArguments()
+
+process.maxEvents = cms.untracked.PSet(input = cms.untracked.int32(1))
+process.source = cms.Source("EmptySource", firstRun = cms.untracked.uint32(options.run))
+
+process.GEMCSCGeometryCacheWriter = cms.EDAnalyzer('GEMCSCGeometryCacheWriter',
+    fileName = cms.untracked.string(options.outputFile),
+)
+process.p = cms.Path(process.GEMCSCGeometryCacheWriter)
+
+if options.conditionsSnapshot:
+    from GEMCSCBendingAnalyzer.MuonAnalyser.localConditionsCustomise import customiseLocalConditions
+    process = customiseLocalConditions(process, options.conditionsSnapshot)
@@ -0,0 +1,80 @@
+## run SliceTestAnalysis once per propagator on the same input, each instance writes its own
+## MuonData tree (prop_time branch = propagation time per muon)
+## compare afterwards with script/propagatorBenchmark.py
+##   cmsRun runPropagatorBenchmark.py inputFiles=file:SingleMuon_RECO.root nEvents=1000
+## without inputFiles a 2018D SingleMuon ZMu RAW-RECO file is read over xrootd
+import FWCore.ParameterSet.Config as cms
+from Configuration.StandardSequences.Eras import eras
+
+process = cms.Process('PropagatorBenchmark',eras.Run2_2017,eras.run3_GEM)
+
+process.load("FWCore.MessageService.MessageLogger_cfi")
+process.load('Configuration.StandardSequences.GeometryRecoDB_cff')
+process.load('Configuration.StandardSequences.MagneticField_AutoFromDBCurrent_cff')
+process.load('Configuration.StandardSequences.FrontierConditions_GlobalTag_cff')
+process.load('RecoMuon.TrackingTools.MuonServiceProxy_cff')
+process.load('GEMCSCBendingAnalyzer.MuonAnalyser.muonSummary_cfi')
+process.load('TrackingTools.TransientTrack.TransientTrackBuilder_cfi')
+from Configuration.AlCa.GlobalTag import GlobalTag
+process.GlobalTag = GlobalTag(process.GlobalTag, '102X_dataRun2_Prompt_v1', '')
+process.MessageLogger.cerr.FwkReport.reportEvery = 500
+
+from FWCore.ParameterSet.VarParsing import VarParsing
+options = VarParsing('analysis')
+options.register ('nEvents',
+                      1000,
+                  VarParsing.multiplicity.singleton,
+                  VarParsing.varType.int,
+                  "Number of events")
+options.parseArguments()
+
+process.maxEvents = cms.untracked.PSet(
+    input = cms.untracked.int32(options.nEvents)
+)
+process.source = cms.Source("PoolSource",
+                            fileNames = cms.untracked.vstring(options.inputFiles),
+                            inputCommands = cms.untracked.vstring(
+		"keep *",
+                "drop TotemTimingDigiedmDetSetVector_totemTimingRawToDigi_TotemTiming_reRECO",
+                "drop TotemTimingRecHitedmDetSetVector_totemTimingRecHits__reRECO"
+                )
+                            )
+## RECO content is needed (GEM/CSC rechits and segments, muon tracks and extras), MINIAOD has none
+if len(process.source.fileNames) == 0:
+    process.source.fileNames = cms.untracked.vstring('root://cms-xrd-global.cern.ch//store/data/Run2018D/SingleMuon/RAW-RECO/ZMu-PromptReco-v2/000/320/500/00000/9AC95BCF-8C95-E811-A24D-FA163E67426E.root')
+
+process.options = cms.untracked.PSet()
+process.TFileService = cms.Service("TFileService",fileName =cms.string("propagatorBenchmark.root"))
+
+## the first entry is the reference for the position differences
+## names must be served by MuonServiceProxy (ServiceParameters.Propagators)
+propagators = [
+    ("Stepping",      "SteppingHelixPropagatorAny",        False),
+    ("SteppingNoErr", "SteppingHelixPropagatorAnyNoError", False),
+    ("Smart",         "SmartPropagatorAny",                False),
+    ("SmartRK",       "SmartPropagatorAnyRK",              False),
+    ("FastHelix",     "SteppingHelixPropagatorAny",        True),
+]
+
+process.benchmarkSequence = cms.Sequence()
+for label, propagator, fast in propagators:
+    ana = cms.EDAnalyzer('SliceTestAnalysis',
+        process.MuonServiceProxy,
+        gemRecHits = cms.InputTag("gemRecHits"),
+        cscRecHits = cms.InputTag("csc2DRecHits"),
+        csclcts = cms.InputTag("muonCSCDigis", "MuonCSCCorrelatedLCTDigi"),
+        cscSegments = cms.InputTag("cscSegments"),
+        muons = cms.InputTag("muons"),
+        muonSummary = cms.InputTag("muonSummary"),
+        matchMuonwithLCT = cms.untracked.bool(False),
+        matchMuonwithCSCRechit = cms.untracked.bool(False),
+        useFastPropagator = cms.untracked.bool(fast),
+        standalonePropagator = cms.untracked.string(propagator),
+        globalPropagator = cms.untracked.string(propagator),
+        innerPropagator = cms.untracked.string(propagator),
+        GEM_alginment_deltaX = cms.vdouble(0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0),
+    )
+    setattr(process, "SliceTestAnalysis"+label, ana)
+    process.benchmarkSequence += ana
+
+process.p = cms.Path(process.muonSummary+process.benchmarkSequence)
@@ -26,6 +26,7 @@ process.load('Configuration.StandardSequences.L1Reco_cff')
 process.load('Configuration.StandardSequences.Reconstruction_Data_cff')
 process.load('Configuration.StandardSequences.EndOfProcess_cff')
 process.load('Configuration.StandardSequences.FrontierConditions_GlobalTag_cff')
+process.load('GEMCSCBendingAnalyzer.MuonAnalyser.muonSummary_cfi')
 
 process.maxEvents = cms.untracked.PSet(
     input = cms.untracked.int32(10)
@@ -106,16 +107,19 @@ process.SliceTestAnalysis = cms.EDAnalyzer('SliceTestAnalysis',
     csclcts = cms.InputTag("muonCSCDigis", "MuonCSCCorrelatedLCTDigi"),
     cscSegments = cms.InputTag("cscSegments"),
     muons = cms.InputTag("muons"),
-    vertexCollection = cms.InputTag("offlinePrimaryVertices"),
+    muonSummary = cms.InputTag("muonSummary"),
     matchMuonwithLCT = cms.untracked.bool(True),
+    GEM_alginment_deltaX = cms.vdouble(-0.16968, -0.1421, 0.1139,  0.1242,  -0.30713,  -0.33472, 0.37761, 0.36531),
 )
 
 
+## the summary producer runs in a Path after the reconstruction, the analyzer on the EndPath
+process.muonSummary_step = cms.Path(process.muonSummary)
 process.outputstep = cms.EndPath(process.SliceTestAnalysis)
 
 
 # Schedule definition
-process.schedule = cms.Schedule(process.raw2digi_step,process.L1Reco_step,process.reconstruction_step,process.endjob_step,process.outputstep)
+process.schedule = cms.Schedule(process.raw2digi_step,process.L1Reco_step,process.reconstruction_step,process.muonSummary_step,process.endjob_step,process.outputstep)
 #process.schedule = cms.Schedule(process.endjob_step,process.outputstep)
 from PhysicsTools.PatAlgos.tools.helpers import associatePatAlgosToolsTask
 associatePatAlgosToolsTask(process)
@@ -0,0 +1,86 @@
+## regional version of runRAW2DIGI_RECO_Ana.py: GEM and CSC local reconstruction only in the GE1/1 and ME1/1
+## chambers the muons point to, straight into SliceTestAnalysis
+##   cmsRun runRAW2DIGI_ROI_Ana.py inputFiles=file:ZMu_RAW-RECO.root nEvents=1000
+## Muons, tracks and vertices are the ones of the RECO part of the RAW-RECO input, only the GEM/CSC
+## unpacking and local reconstruction run here. The unpackers are run in full (the LCTs are read from
+## muonCSCDigis); GEMCSCDigiROISelector then keeps the digis of the muon chambers for gemRecHits,
+## csc2DRecHits and cscSegments. These keep their standard labels, so the analyzer reads the
+## products of this process, not the ones of the input.
+## Needs RAW-RECO input: muons are not reconstructed here, and GEMCSCDigiROISelector stops with an
+## exception on RAW-only input. This is not a drop-in replacement of runRAW2DIGI_RECO_Ana.py on RAW,
+## use that one for RAW-only files.
+import FWCore.ParameterSet.Config as cms
+from Configuration.StandardSequences.Eras import eras
+
+process = cms.Process('ntupleROI',eras.Run2_2018)
+
+process.load('Configuration.StandardSequences.Services_cff')
+process.load('FWCore.MessageService.MessageLogger_cfi')
+process.load('Configuration.StandardSequences.GeometryRecoDB_cff')
+process.load('Configuration.StandardSequences.MagneticField_AutoFromDBCurrent_cff')
+process.load('Configuration.StandardSequences.RawToDigi_Data_cff')
+process.load('Configuration.StandardSequences.Reconstruction_Data_cff')
+process.load('Configuration.StandardSequences.FrontierConditions_GlobalTag_cff')
+process.load('RecoMuon.TrackingTools.MuonServiceProxy_cff')
+process.load('GEMCSCBendingAnalyzer.MuonAnalyser.muonSummary_cfi')
+from Configuration.AlCa.GlobalTag import GlobalTag
+process.GlobalTag = GlobalTag(process.GlobalTag, '101X_dataRun2_Prompt_v9', '')
+process.MessageLogger.cerr.FwkReport.reportEvery = 5000
+
+from FWCore.ParameterSet.VarParsing import VarParsing
+options = VarParsing('analysis')
+options.register ('nEvents',
+                      -1,
+                  VarParsing.multiplicity.singleton,
+                  VarParsing.varType.int,
+                  "Number of events")
+options.register ('conditionsSnapshot',
+                  '',
+                  VarParsing.multiplicity.singleton,
+                  VarParsing.varType.string,
+                  "local conditions snapshot (script/conditionsSnapshot.py) instead of the Frontier GlobalTag")
+options.setDefault('outputFile', 'CSCeff_SingleMuon_2018A_ROI.root')
+options.parseArguments()
+
+process.maxEvents = cms.untracked.PSet(input = cms.untracked.int32(options.nEvents))
+process.source = cms.Source("PoolSource", fileNames = cms.untracked.vstring(options.inputFiles))
+if len(process.source.fileNames) == 0:
+    process.source.fileNames = cms.untracked.vstring('root://cms-xrd-global.cern.ch//store/data/Run2018A/SingleMuon/RAW-RECO/ZMu-PromptReco-v1/000/315/257/00000/2A55950E-524B-E811-9C89-FA163E679A44.root')
+process.options = cms.untracked.PSet(wantSummary = cms.untracked.bool(True))
+
+process.muonDigisROI = cms.EDProducer('GEMCSCDigiROISelector',
+    muons = cms.InputTag("muons"),
+    gemDigis = cms.InputTag("muonGEMDigis"),
+    cscStripDigis = cms.InputTag("muonCSCDigis", "MuonCSCStripDigi"),
+    cscWireDigis = cms.InputTag("muonCSCDigis", "MuonCSCWireDigi"),
+    minMuonPt = cms.untracked.double(2.0),
+    minMuonEta = cms.untracked.double(1.4),
+    maxMuonEta = cms.untracked.double(2.5),
+    margin = cms.untracked.double(20.0),
+)
+
+process.gemRecHits.gemDigiLabel = cms.InputTag("muonDigisROI")
+process.csc2DRecHits.stripDigiTag = cms.InputTag("muonDigisROI", "MuonCSCStripDigi")
+process.csc2DRecHits.wireDigiTag = cms.InputTag("muonDigisROI", "MuonCSCWireDigi")
+
+process.SliceTestAnalysis = cms.EDAnalyzer('SliceTestAnalysis',
+    process.MuonServiceProxy,
+    gemRecHits = cms.InputTag("gemRecHits"),
+    cscRecHits = cms.InputTag("csc2DRecHits"),
+    csclcts = cms.InputTag("muonCSCDigis", "MuonCSCCorrelatedLCTDigi"),
+    cscSegments = cms.InputTag("cscSegments"),
+    muons = cms.InputTag("muons"),
+    muonSummary = cms.InputTag("muonSummary"),
+    matchMuonwithLCT = cms.untracked.bool(True),
+    GEM_alginment_deltaX = cms.vdouble(-0.16968, -0.1421, 0.1139,  0.1242,  -0.30713,  -0.33472, 0.37761, 0.36531),
+)
+
+process.muonLocalRecoROI = cms.Sequence(process.muonCSCDigis + process.muonGEMDigis + process.muonDigisROI
+                                        + process.gemRecHits + process.csc2DRecHits + process.cscSegments)
+process.p = cms.Path(process.muonLocalRecoROI + process.muonSummary + process.SliceTestAnalysis)
+
+process.TFileService = cms.Service('TFileService', fileName = cms.string(options.outputFile))
+
+if options.conditionsSnapshot:
+    from GEMCSCBendingAnalyzer.MuonAnalyser.localConditionsCustomise import customiseLocalConditions
+    process = customiseLocalConditions(process, options.conditionsSnapshot)
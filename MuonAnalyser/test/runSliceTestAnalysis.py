@@ -8,6 +8,7 @@ process.load('Configuration.StandardSequences.GeometryRecoDB_cff')
 process.load('Configuration.StandardSequences.MagneticField_AutoFromDBCurrent_cff')
 process.load('Configuration.StandardSequences.FrontierConditions_GlobalTag_cff')
 process.load('RecoMuon.TrackingTools.MuonServiceProxy_cff')
+process.load('GEMCSCBendingAnalyzer.MuonAnalyser.muonSummary_cfi')
 process.load('TrackingTools.TransientTrack.TransientTrackBuilder_cfi')
 from Configuration.AlCa.GlobalTag import GlobalTag
 #process.GlobalTag = GlobalTag(process.GlobalTag, '101X_dataRun2_Prompt_v10', '')
@@ -22,13 +23,17 @@ options.register ('nEvents',
                   VarParsing.multiplicity.singleton,
                   VarParsing.varType.int,
                   "Number of events")
+options.register ('conditionsSnapshot',
+                  '',
+                  VarParsing.multiplicity.singleton,
+                  VarParsing.varType.string,
+                  "local conditions snapshot (script/conditionsSnapshot.py) instead of the Frontier GlobalTag")
 options.parseArguments()
 
 
 process.maxEvents = cms.untracked.PSet(
     input = cms.untracked.int32(options.nEvents)
 )
-process.maxEvents.input = cms.untracked.int32(1000)
 # Input source
 process.source = cms.Source("PoolSource", 
                             fileNames = cms.untracked.vstring(options.inputFiles),
@@ -43,7 +48,8 @@ process.source = cms.Source("PoolSource",
 #process.source.fileNames.append('file:/eos/uscms/store/group/lpcgem/SingleMuon_Run2018C_v1_RECO/step3_001.root')
 #process.source.fileNames = cms.untracked.vstring('root://cms-xrd-global.cern.ch//store/data/Run2018D/SingleMuon/RAW-RECO/ZMu-PromptReco-v2/000/320/500/00000/9AC95BCF-8C95-E811-A24D-FA163E67426E.root')
 #process.source.fileNames = cms.untracked.vstring('root://cms-xrd-global.cern.ch//store/data/Run2018D/SingleMuon/AOD/PromptReco-v2/000/320/500/00000/FE2B5583-8C95-E811-B8F8-FA163ED06560.root')
-process.source.fileNames = cms.untracked.vstring('root://cms-xrd-global.cern.ch//store/data/Run2018D/SingleMuon/MINIAOD/PromptReco-v2/000/321/475/00000/AA10A5A1-77A6-E811-B57C-FA163EF0320D.root')
+if len(process.source.fileNames) == 0:
+    process.source.fileNames = cms.untracked.vstring('root://cms-xrd-global.cern.ch//store/data/Run2018D/SingleMuon/MINIAOD/PromptReco-v2/000/321/475/00000/AA10A5A1-77A6-E811-B57C-FA163EF0320D.root')
 #process.source.fileNames.append('file:/eos/uscms/store/user/mkhurana/2018C_data_files/step3_152.root')
 
 #fname = 'singleMuon.txt'
@@ -64,9 +70,45 @@ process.SliceTestAnalysis = cms.EDAnalyzer('SliceTestAnalysis',
     csclcts = cms.InputTag("muonCSCDigis", "MuonCSCCorrelatedLCTDigi"),
     cscSegments = cms.InputTag("cscSegments"),
     muons = cms.InputTag("muons"),
-    vertexCollection = cms.InputTag("offlinePrimaryVertices"),
+    muonSummary = cms.InputTag("muonSummary"),
     matchMuonwithLCT = cms.untracked.bool(False),
     matchMuonwithCSCRechit = cms.untracked.bool(False),
+    useFastPropagator = cms.untracked.bool(False),#analytic helix for GE11 <-> ME11 extrapolations
+    validateFastPropagator = cms.untracked.bool(False),#fill fast - stepping residual histograms
+    fastPropagatorMinPt = cms.untracked.double(20.0),
+    fastPropagatorMaxDistance = cms.untracked.double(100.0),#cm
+    standalonePropagator = cms.untracked.string("SteppingHelixPropagatorAny"),
+    globalPropagator = cms.untracked.string("SteppingHelixPropagatorAny"),
+    innerPropagator = cms.untracked.string("SteppingHelixPropagatorAny"),
+    concurrentPropagation = cms.untracked.bool(False),#GE11/CSC blocks and muons as TBB tasks
+    #geometryCache = cms.untracked.string("GE11ME11Geometry.bin"),#GE11 strip lookups from runGeometryCacheWriter.py, checked against the geometry
+    #bendingProduct = cms.untracked.InputTag("gemcscBending"),#fill bending branches from GEMCSCBendingProducer, see runGEMCSCBending.py; not with fillSummary, fillLumiSummary, fillAlignment, scanMatchingWindows
+    fillTree = cms.untracked.bool(True),#per muon MuonData ntuple
+    fillSummary = cms.untracked.bool(False),#per chamber/roll/VFAT histograms, see script/slicetest_summaryplots.py
+    fillLumiSummary = cms.untracked.bool(False),#per lumi efficiency counters and residual sums, see script/slicetest_lumitrend.py
+    fillAlignment = cms.untracked.bool(False),#GE11 residual histograms, alignment fragment written at the end of the job
+    alignmentOutput = cms.untracked.string("GEMAlignment_cff.py"),#merged jobs: script/gemAlignmentFromHistograms.py
+    alignmentTableOutput = cms.untracked.string("GEMAlignmentTable.txt"),#per roll table for GEMAlignmentTable
+    #GEMAlignmentTable = cms.untracked.string("GEMAlignmentTable.txt"),#full detector corrections, replaces GEM_alginment_deltaX
+    storeCandidates = cms.untracked.bool(False),#propagations and all hits within candidateWindow, for bin/gemcscRematch
+    candidateWindow = cms.untracked.double(20.0),#cm
+    recordSlowEvents = cms.untracked.bool(False),#SlowEvents tree: collection sizes and stage timings of slow events
+    slowEventThreshold = cms.untracked.double(0.0),#ms, 0: off
+    slowEventPercentile = cms.untracked.double(0.99),#of the events so far, 0: off
+    scanMatchingWindows = cms.untracked.bool(False),#efficiency vs matching window, one pass; ME11 rechits/LCTs need matchMuonwithCSCRechit/LCT
+    scanGEMRechit_muon_deltaX = cms.untracked.vdouble(0.5, 1.0, 2.0, 3.0, 5.0, 10.0),#cm
+    scanCSCRechit_muon_deltaR = cms.untracked.vdouble(1.0, 2.0, 3.0, 5.0, 8.0),
+    scanCSCSegment_muon_deltaR = cms.untracked.vdouble(1.0, 2.0, 3.0, 5.0, 8.0),
+    scanCSCLCT_muon_deltaR = cms.untracked.vdouble(1.0, 2.0, 3.0, 5.0, 8.0),
+    summaryRequireTightID = cms.untracked.bool(True),
+    summaryMinMuonPt = cms.untracked.double(25.0),
+    #alignment/strip ordering hypotheses evaluated on the same propagations, hyp_ columns of the tree
+    #alignmentHypotheses = cms.untracked.VPSet(
+    #    cms.PSet(name = cms.string("flipped_noAlignment"), flippedGEMStrip = cms.bool(True)),
+    #    cms.PSet(name = cms.string("flipped_sliceTest"), flippedGEMStrip = cms.bool(True),
+    #             GEM_alginment_deltaX = cms.vdouble(-0.16968, -0.1421, 0.1139,  0.1242,  -0.30713,  -0.33472, 0.37761, 0.36531)),
+    #    cms.PSet(name = cms.string("flipped_table"), flippedGEMStrip = cms.bool(True), GEMAlignmentTable = cms.string("GEMAlignmentTable.txt")),
+    #),
     #GEM_alginment_deltaX = cms.vdouble(0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0),
     GEM_alginment_deltaX = cms.vdouble(-0.16968, -0.1421, 0.1139,  0.1242,  -0.30713,  -0.33472, 0.37761, 0.36531),
 
@@ -74,4 +116,8 @@ process.SliceTestAnalysis = cms.EDAnalyzer('SliceTestAnalysis',
     
 )
 
-process.p = cms.Path(process.SliceTestAnalysis)
+process.p = cms.Path(process.muonSummary+process.SliceTestAnalysis)
+
+if options.conditionsSnapshot:
+    from GEMCSCBendingAnalyzer.MuonAnalyser.localConditionsCustomise import customiseLocalConditions
+    process = customiseLocalConditions(process, options.conditionsSnapshot)
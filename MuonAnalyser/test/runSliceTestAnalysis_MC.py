@@ -11,6 +11,7 @@ process.load('Configuration.StandardSequences.FrontierConditions_GlobalTag_cff')
 process.load('Configuration.Geometry.GeometryExtended2023D17Reco_cff')
 process.load('Configuration.Geometry.GeometryExtended2023D17_cff')
 process.load('RecoMuon.TrackingTools.MuonServiceProxy_cff')
+process.load('GEMCSCBendingAnalyzer.MuonAnalyser.muonSummary_cfi')
 process.load('Configuration.StandardSequences.SimIdeal_cff')
 process.load('TrackingTools.TransientTrack.TransientTrackBuilder_cfi')
 from Configuration.AlCa.GlobalTag import GlobalTag
@@ -27,6 +28,11 @@ options.register ('nEvents',
                   VarParsing.multiplicity.singleton,
                   VarParsing.varType.int,
                   "Number of events")
+options.register ('conditionsSnapshot',
+                  '',
+                  VarParsing.multiplicity.singleton,
+                  VarParsing.varType.string,
+                  "local conditions snapshot (script/conditionsSnapshot.py) instead of the Frontier GlobalTag")
 options.parseArguments()
 
 
@@ -35,7 +41,8 @@ process.maxEvents = cms.untracked.PSet(
 )
 process.maxEvents.input = cms.untracked.int32(5000)
 
-#process.gemSkim = cms.EDFilter("GEMSkim",gemRecHits = cms.InputTag("gemRecHits"))
+#process.load('GEMCSCBendingAnalyzer.MuonAnalyser.gemSkim_cff')
+#process.gemSkim.instrumentedChambers = cms.untracked.vint32()#all GE1/1 chambers in the Phase2 geometry
 #process.GEMRecHitSkim = cms.Path(process.gemSkim)
 # Input source
 process.source = cms.Source("PoolSource", 
@@ -74,11 +81,46 @@ process.SliceTestAnalysis = cms.EDAnalyzer('SliceTestAnalysis',
     csclcts = cms.InputTag("muonCSCDigis", "MuonCSCCorrelatedLCTDigi"),
     cscSegments = cms.InputTag("cscSegments"),
     muons = cms.InputTag("muons"),
-    vertexCollection = cms.InputTag("offlinePrimaryVertices"),
+    muonSummary = cms.InputTag("muonSummary"),
     matchMuonwithLCT = cms.untracked.bool(False),
     matchMuonwithCSCRechit = cms.untracked.bool(False),
+    useFastPropagator = cms.untracked.bool(False),#analytic helix for GE11 <-> ME11 extrapolations
+    validateFastPropagator = cms.untracked.bool(False),#fill fast - stepping residual histograms
+    fastPropagatorMinPt = cms.untracked.double(20.0),
+    fastPropagatorMaxDistance = cms.untracked.double(100.0),#cm
+    standalonePropagator = cms.untracked.string("SteppingHelixPropagatorAny"),
+    globalPropagator = cms.untracked.string("SteppingHelixPropagatorAny"),
+    innerPropagator = cms.untracked.string("SteppingHelixPropagatorAny"),
+    concurrentPropagation = cms.untracked.bool(False),#GE11/CSC blocks and muons as TBB tasks
+    #bendingProduct = cms.untracked.InputTag("gemcscBending"),#fill bending branches from GEMCSCBendingProducer, see runGEMCSCBending.py; not with fillSummary, fillLumiSummary, fillAlignment, scanMatchingWindows
+    fillTree = cms.untracked.bool(True),#per muon MuonData ntuple
+    fillSummary = cms.untracked.bool(False),#per chamber/roll/VFAT histograms, see script/slicetest_summaryplots.py
+    fillLumiSummary = cms.untracked.bool(False),#per lumi efficiency counters and residual sums, see script/slicetest_lumitrend.py
+    fillAlignment = cms.untracked.bool(False),#GE11 residual histograms, alignment fragment written at the end of the job
+    alignmentOutput = cms.untracked.string("GEMAlignment_cff.py"),#merged jobs: script/gemAlignmentFromHistograms.py
+    alignmentTableOutput = cms.untracked.string("GEMAlignmentTable.txt"),#per roll table for GEMAlignmentTable
+    #GEMAlignmentTable = cms.untracked.string("GEMAlignmentTable.txt"),#full detector corrections, replaces GEM_alginment_deltaX
+    storeCandidates = cms.untracked.bool(False),#propagations and all hits within candidateWindow, for bin/gemcscRematch
+    candidateWindow = cms.untracked.double(20.0),#cm
+    recordSlowEvents = cms.untracked.bool(False),#SlowEvents tree: collection sizes and stage timings of slow events
+    slowEventThreshold = cms.untracked.double(0.0),#ms, 0: off
+    slowEventPercentile = cms.untracked.double(0.99),#of the events so far, 0: off
+    scanMatchingWindows = cms.untracked.bool(False),#efficiency vs matching window, one pass; ME11 rechits/LCTs need matchMuonwithCSCRechit/LCT
+    scanGEMRechit_muon_deltaX = cms.untracked.vdouble(0.5, 1.0, 2.0, 3.0, 5.0, 10.0),#cm
+    scanCSCRechit_muon_deltaR = cms.untracked.vdouble(1.0, 2.0, 3.0, 5.0, 8.0),
+    scanCSCSegment_muon_deltaR = cms.untracked.vdouble(1.0, 2.0, 3.0, 5.0, 8.0),
+    scanCSCLCT_muon_deltaR = cms.untracked.vdouble(1.0, 2.0, 3.0, 5.0, 8.0),
+    summaryRequireTightID = cms.untracked.bool(True),
+    summaryMinMuonPt = cms.untracked.double(25.0),
     applyGEMalignment = cms.untracked.bool(False),
     flippedGEMStrip = cms.untracked.bool(False),
+    #alignment/strip ordering hypotheses evaluated on the same propagations, hyp_ columns of the tree
+    #alignmentHypotheses = cms.untracked.VPSet(
+    #    cms.PSet(name = cms.string("flipped_noAlignment"), flippedGEMStrip = cms.bool(True)),
+    #    cms.PSet(name = cms.string("flipped_sliceTest"), flippedGEMStrip = cms.bool(True),
+    #             GEM_alginment_deltaX = cms.vdouble(-0.16968, -0.1421, 0.1139,  0.1242,  -0.30713,  -0.33472, 0.37761, 0.36531)),
+    #    cms.PSet(name = cms.string("flipped_table"), flippedGEMStrip = cms.bool(True), GEMAlignmentTable = cms.string("GEMAlignmentTable.txt")),
+    #),
     GEM_alginment_deltaX = cms.vdouble(0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0),
     #GEM_alginment_deltaX = cms.vdouble(-0.16968, -0.1421, 0.1139,  0.1242,  -0.30713,  -0.33472, 0.37761, 0.36531),
     #GEM_alginment_deltaX = cms.vdouble(-0.152, -0.145, 0.1382, 0.1345, -0.2737, -0.2939, 0.387, 0.377),
@@ -87,5 +129,9 @@ process.SliceTestAnalysis = cms.EDAnalyzer('SliceTestAnalysis',
     
 )
 
-process.p = cms.EndPath(process.SliceTestAnalysis)
+process.p = cms.Path(process.muonSummary+process.SliceTestAnalysis)
+
+if options.conditionsSnapshot:
+    from GEMCSCBendingAnalyzer.MuonAnalyser.localConditionsCustomise import customiseLocalConditions
+    process = customiseLocalConditions(process, options.conditionsSnapshot)
 
@@ -0,0 +1,97 @@
+## throughput vs occupancy without input files: GEMCSCSyntheticEventProducer fills GEM/CSC rechits,
+## segments, digis and muons on the Phase-2 geometry, SliceTestAnalysis and HitAnalysis run on them
+## cmsRun runSyntheticBenchmark.py occupancyScale=10 nMuons=2 nEvents=1000
+## the module timing is in the summary at the end of the job (wantSummary)
+import FWCore.ParameterSet.Config as cms
+from Configuration.StandardSequences.Eras import eras
+
+process = cms.Process('SyntheticBenchmark',eras.Phase2)
+
+process.load("FWCore.MessageService.MessageLogger_cfi")
+process.load('Configuration.StandardSequences.MagneticField_AutoFromDBCurrent_cff')
+process.load('Configuration.StandardSequences.FrontierConditions_GlobalTag_cff')
+process.load('Configuration.Geometry.GeometryExtended2023D17Reco_cff')
+process.load('Configuration.Geometry.GeometryExtended2023D17_cff')
+process.load('RecoMuon.TrackingTools.MuonServiceProxy_cff')
+process.load('GEMCSCBendingAnalyzer.MuonAnalyser.muonSummary_cfi')
+from Configuration.AlCa.GlobalTag import GlobalTag
+process.GlobalTag = GlobalTag(process.GlobalTag, 'auto:phase2_realistic','')
+process.MessageLogger.cerr.FwkReport.reportEvery = 1000
+
+from FWCore.ParameterSet.VarParsing import VarParsing
+options = VarParsing('analysis')
+options.register ('nEvents',
+                      1000,
+                  VarParsing.multiplicity.singleton,
+                  VarParsing.varType.int,
+                  "Number of events")
+options.register ('occupancyScale',
+                      1.0,
+                  VarParsing.multiplicity.singleton,
+                  VarParsing.varType.float,
+                  "Scale of the noise hit and segment rates")
+options.register ('nMuons',
+                      1,
+                  VarParsing.multiplicity.singleton,
+                  VarParsing.varType.int,
+                  "Muons per event")
+options.register ('seed',
+                      12345,
+                  VarParsing.multiplicity.singleton,
+                  VarParsing.varType.int,
+                  "Random seed, combined with run and event numbers")
+options.parseArguments()
+
+process.maxEvents = cms.untracked.PSet(
+    input = cms.untracked.int32(options.nEvents)
+)
+process.source = cms.Source("EmptySource")
+
+process.options = cms.untracked.PSet(wantSummary = cms.untracked.bool(True))
+process.TFileService = cms.Service("TFileService",fileName =cms.string("syntheticBenchmark_occupancy%g.root" % options.occupancyScale))
+
+process.syntheticEvents = cms.EDProducer('GEMCSCSyntheticEventProducer',
+    seed = cms.untracked.uint32(options.seed),
+    nMuons = cms.untracked.int32(options.nMuons),
+    minMuonPt = cms.untracked.double(20.0),
+    maxMuonPt = cms.untracked.double(100.0),
+    minMuonEta = cms.untracked.double(1.6),
+    maxMuonEta = cms.untracked.double(2.2),
+    muonEndcap = cms.untracked.int32(0),#1, -1 or 0 for both
+    muonHitEfficiency = cms.untracked.double(0.97),
+    occupancyScale = cms.untracked.double(options.occupancyScale),
+    gemClustersPerRoll = cms.untracked.double(0.05),#at occupancyScale 1
+    maxGEMClusterSize = cms.untracked.int32(3),
+    cscHitsPerLayer = cms.untracked.double(0.05),
+    cscSegmentsPerChamber = cms.untracked.double(0.01),
+    minSegmentHits = cms.untracked.int32(4),
+)
+
+process.muonSummary.muons = cms.InputTag("syntheticEvents")
+process.muonSummary.vertexCollection = cms.InputTag("syntheticEvents")
+
+process.SliceTestAnalysis = cms.EDAnalyzer('SliceTestAnalysis',
+    process.MuonServiceProxy,
+    gemRecHits = cms.InputTag("syntheticEvents"),
+    cscRecHits = cms.InputTag("syntheticEvents"),
+    csclcts = cms.InputTag("muonCSCDigis", "MuonCSCCorrelatedLCTDigi"),#not produced, needs matchMuonwithLCT = False
+    cscSegments = cms.InputTag("syntheticEvents"),
+    muons = cms.InputTag("syntheticEvents"),
+    muonSummary = cms.InputTag("muonSummary"),
+    matchMuonwithLCT = cms.untracked.bool(False),
+    matchMuonwithCSCRechit = cms.untracked.bool(True),
+    useFastPropagator = cms.untracked.bool(False),
+    standalonePropagator = cms.untracked.string("SteppingHelixPropagatorAny"),
+    globalPropagator = cms.untracked.string("SteppingHelixPropagatorAny"),
+    innerPropagator = cms.untracked.string("SteppingHelixPropagatorAny"),
+    fillTree = cms.untracked.bool(True),
+    GEM_alginment_deltaX = cms.vdouble(0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0),
+)
+
+process.HitRateAnalysis = cms.EDAnalyzer('HitAnalysis',
+    gemDigiInput      = cms.InputTag("syntheticEvents"),
+    gemPadDigiInput   = cms.InputTag("syntheticEvents"),
+    gemCoPadDigiInput = cms.InputTag("syntheticEvents"),
+)
+
+process.p = cms.Path(process.syntheticEvents+process.muonSummary+process.SliceTestAnalysis+process.HitRateAnalysis)
@@ -41,7 +41,7 @@ process.configurationMetadata = cms.untracked.PSet(
     version = cms.untracked.string('$Revision: 1.19 $')
 )
 
-process.gemSkim = cms.EDFilter("GEMSkim",gemRecHits = cms.InputTag("gemRecHits"))
+process.load('GEMCSCBendingAnalyzer.MuonAnalyser.gemSkim_cff')
 process.GEMRecHitSkim = cms.Path(process.gemSkim)
 
 # Output definition
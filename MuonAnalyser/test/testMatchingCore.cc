@@ -0,0 +1,154 @@
+// interface/MatchingCore.h: strip centre lookup and validity, flipped strip numbering, aligned x,
+// flat roll index, and nearestInRolls against a scan over all hits of the roll and its neighbours.
+// Returns 1 if any check fails.
+
+#include <cmath>
+#include <iostream>
+#include <random>
+#include <set>
+#include <vector>
+
+#include "GEMCSCBendingAnalyzer/MuonAnalyser/interface/MatchingCore.h"
+
+namespace {
+
+  int nFailed = 0;
+
+  void check(bool ok, const char* what)
+  {
+    if (ok) return;
+    if (nFailed++ < 10)
+      std::cout <<"testMatchingCore: "<< what <<" failed"<< std::endl;
+  }
+
+  bool equal(float a, float b, float tolerance = 1e-5) { return std::fabs(a - b) <= tolerance; }
+
+  struct Hit { int id; };
+
+  void testStrips()
+  {
+    using namespace matching;
+    //centre of the strip, integer strip within 0.25 of the edge
+    check(equal(centerStripNumber(10.1), 10.0), "centerStripNumber lower edge");
+    check(equal(centerStripNumber(10.25), 10.0), "centerStripNumber at 0.25");
+    check(equal(centerStripNumber(10.3), 10.5), "centerStripNumber centre");
+    check(equal(centerStripNumber(10.75), 10.5), "centerStripNumber at 0.75");
+    check(equal(centerStripNumber(10.8), 11.0), "centerStripNumber upper edge");
+    check(equal(centerStripNumber(0.0), 0.0), "centerStripNumber first strip");
+
+    check(validGEMStrip(0.0) and validGEMStrip(383.9), "validGEMStrip inside");
+    check(not validGEMStrip(-0.1) and not validGEMStrip(384.0) and not validGEMStrip(NAN), "validGEMStrip outside");
+
+    //reversed ordering within each VFAT sector of 128 strips
+    check(equal(flippedStripNumber(0.5), 127.5), "flippedStripNumber first strip");
+    check(equal(flippedStripNumber(127.5), 0.5), "flippedStripNumber last strip of sector 0");
+    check(equal(flippedStripNumber(128.5), 255.5), "flippedStripNumber first strip of sector 1");
+    check(equal(flippedStripNumber(300.25), 339.75), "flippedStripNumber sector 2");
+    check(equal(flippedStripNumber(-1.0), 0.0) and equal(flippedStripNumber(384.0), 0.0), "flippedStripNumber outside");
+    for (float strip = 0.5; strip < kNGEMStrips; strip += 1.0){
+      const float flipped = flippedStripNumber(strip);
+      check(int(flipped)/kNGEMStripsPerSector == int(strip)/kNGEMStripsPerSector, "flippedStripNumber stays in the sector");
+      check(equal(flippedStripNumber(flipped), strip), "flippedStripNumber twice");
+    }
+  }
+
+  void testAlignment()
+  {
+    using namespace matching;
+    check(equal(alignedX(1.0, 0.0, 0.0, 0.0), 1.0), "alignedX no correction");
+    check(equal(alignedX(1.0, 5.0, 0.3, 0.0), 1.3), "alignedX shift");
+    check(equal(alignedX(1.0, 5.0, 0.3, 0.01), 1.35), "alignedX shift and rotation");
+    check(equal(alignedX(-2.0, -10.0, -0.1, 0.002), -2.12), "alignedX negative y");
+  }
+
+  void testRollIndex()
+  {
+    using namespace matching;
+    std::set<int> seen;
+    for (int region = -1; region <= 1; region += 2)
+      for (int chamber = 1; chamber <= kNChambers; ++chamber)
+        for (int layer = 1; layer <= kNLayers; ++layer)
+          for (int roll = 1; roll <= kNRolls; ++roll){
+            const int i = rollIndex(region, chamber, layer, roll);
+            check(i >= 0 and i < kNGE11Rolls, "rollIndex in range");
+            seen.insert(i);
+          }
+    check(int(seen.size()) == kNGE11Rolls, "rollIndex one index per eta partition");
+    check(rollIndex(-1, 1, 1, 1) == 0, "rollIndex first");
+    check(rollIndex(1, kNChambers, kNLayers, kNRolls) == kNGE11Rolls - 1, "rollIndex last");
+    check(rollIndex(0, 27, 1, 1) == -1 and rollIndex(2, 27, 1, 1) == -1, "rollIndex bad region");
+    check(rollIndex(-1, 0, 1, 1) == -1 and rollIndex(-1, 37, 1, 1) == -1, "rollIndex bad chamber");
+    check(rollIndex(-1, 27, 0, 1) == -1 and rollIndex(-1, 27, 3, 1) == -1, "rollIndex bad layer");
+    check(rollIndex(-1, 27, 1, 0) == -1 and rollIndex(-1, 27, 1, 9) == -1, "rollIndex bad roll");
+  }
+
+  void testNearestInRolls()
+  {
+    using namespace matching;
+    //rolls of one chamber layer, keys as rollIndex
+    auto rollKey = [](int roll){ return uint32_t(rollIndex(-1, 27, 1, roll)); };
+
+    //empty index
+    hitindex::Index<Hit> index;
+    float mindX = 9999.0;
+    check(nearestInRolls(index, 4, rollKey, 0.0, mindX) == nullptr and mindX == 9999.0, "nearestInRolls empty index");
+
+    std::mt19937 rng(2018);
+    std::uniform_int_distribution<int> rollDist(1, kNRolls);
+    std::uniform_int_distribution<int> nHitsDist(0, 6);
+    std::uniform_real_distribution<float> xDist(-20.0, 20.0);
+    for (int event = 0; event < 10000; ++event){
+      hitindex::clearAll(index);
+      std::vector<Hit> hits(8*6);
+      std::vector<std::pair<int, float> > all;//roll, x
+      int n = 0;
+      for (int roll = 1; roll <= kNRolls; ++roll){
+        const int nHits = nHitsDist(rng);
+        for (int h = 0; h < nHits; ++h, ++n){
+          hits[n].id = n;
+          const float x = xDist(rng);
+          index[rollKey(roll)].add(x, 0.0, &hits[n]);
+          all.push_back({roll, x});
+        }
+      }
+      hitindex::sortAll(index);
+
+      const int roll = rollDist(rng);
+      const float x0 = xDist(rng);
+      //scan over the roll and its neighbours
+      float expected = 9999.0;
+      for (const auto& hit : all)
+        if (std::abs(hit.first - roll) <= 1)
+          expected = std::min(expected, std::fabs(hit.second - x0));
+
+      mindX = 9999.0;
+      const auto* best = nearestInRolls(index, roll, rollKey, x0, mindX);
+      if (expected == 9999.0){
+        check(best == nullptr and mindX == 9999.0, "nearestInRolls no hit in the rolls");
+        continue;
+      }
+      check(best != nullptr and equal(mindX, expected) and equal(std::fabs(best->x - x0), expected), "nearestInRolls nearest hit");
+      check(best != nullptr and std::abs(all[best->hit->id].first - roll) <= 1, "nearestInRolls hit in a neighbouring roll");
+
+      //mindX is a running minimum, a closer previous candidate is kept
+      float closer = expected/2;
+      check(nearestInRolls(index, roll, rollKey, x0, closer) == nullptr and closer == expected/2, "nearestInRolls keeps a closer mindX");
+    }
+  }
+
+}
+
+int main()
+{
+  testStrips();
+  testAlignment();
+  testRollIndex();
+  testNearestInRolls();
+
+  if (nFailed > 0){
+    std::cout <<"testMatchingCore: "<< nFailed <<" checks failed"<< std::endl;
+    return 1;
+  }
+  std::cout <<"testMatchingCore: all checks passed"<< std::endl;
+  return 0;
+}
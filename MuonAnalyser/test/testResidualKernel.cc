@@ -0,0 +1,108 @@
+// residuals::compute (interface/ResidualKernel.h) against the inline expressions it replaced in
+// SliceTestAnalysis::propagateToGE11/propagateToCSC: GE1/1 hits as reconstructed, with flipped
+// strips and flipped and aligned in x, and CSC segments/rechits (RdPhi relative to the hit y).
+// Random configurations in the GE1/1 and ME1/1 ranges, returns 1 if any residual differs.
+
+#include <cmath>
+#include <iostream>
+#include <random>
+
+#include "GEMCSCBendingAnalyzer/MuonAnalyser/interface/ResidualKernel.h"
+
+namespace {
+
+  const float kTolerance = 1e-4;//cm
+
+  int nFailed = 0;
+
+  void check(const char* what, int config, float value, double expected)
+  {
+    if (std::fabs(value - expected) <= kTolerance) return;
+    if (nFailed++ < 10)
+      std::cout <<"testResidualKernel: "<< what <<" config "<< config <<" kernel "<< value <<" expected "<< expected << std::endl;
+  }
+
+  //previous expressions, one track at a time
+  struct Point { float x, y; };
+
+  double oldDeltaR(Point hit, Point pos) { return std::sqrt(std::pow(hit.x - pos.x, 2) + std::pow(hit.y - pos.y, 2)); }
+  double oldDeltaX(Point hit, Point pos) { return hit.x - pos.x; }
+  //GE1/1: relative to the middle of the propagated roll
+  double oldGEMRdPhi(Point hit, Point pos, float angle, float deltay_roll) { return std::cos(angle) * (pos.x - hit.x) + std::sin(angle) * (pos.y + deltay_roll); }
+  double oldGEMRdPhiMinus(Point hit, Point pos, float angle, float deltay_roll) { return std::cos(angle) * (pos.x - hit.x) - std::sin(angle) * (pos.y + deltay_roll); }
+  //CSC: relative to the hit
+  double oldCSCRdPhi(Point hit, Point pos, float angle) { return std::cos(angle) * (pos.x - hit.x) + std::sin(angle) * (pos.y - hit.y); }
+
+}
+
+int main()
+{
+  using namespace residuals;
+
+  std::mt19937 rng(20181);
+  std::uniform_real_distribution<float> localX(-25.0, 25.0);
+  std::uniform_real_distribution<float> localY(-12.0, 12.0);
+  std::uniform_real_distribution<float> deltaProp(-3.0, 3.0);
+  std::uniform_real_distribution<float> stripAngle(-0.1, 0.1);
+  std::uniform_real_distribution<float> rollOffset(-40.0, 40.0);
+  std::uniform_real_distribution<float> alignment(-0.5, 0.5);
+
+  const int nConfigs = 100000;
+  for (int c = 0; c < nConfigs; ++c){
+    //standalone, global and inner extrapolations close to each other
+    Point pos[kNTracks];
+    pos[kSta] = {localX(rng), localY(rng)};
+    for (int t = kGlobal; t < kNTracks; ++t)
+      pos[t] = {pos[kSta].x + deltaProp(rng), pos[kSta].y + deltaProp(rng)};
+    Extrapolations prop;
+    for (int t = 0; t < kNTracks; ++t){
+      prop.x[t] = pos[t].x;
+      prop.y[t] = pos[t].y;
+    }
+
+    //GE1/1: the flipped strip mirrors the hit in x and the strip angle, the aligned hit is the flipped one shifted in x
+    const Point hit = {pos[kSta].x + deltaProp(rng), pos[kSta].y + deltaProp(rng)};
+    const Point hitFlipped = {-hit.x, hit.y};
+    const Point hitAligned = {hitFlipped.x + alignment(rng), hitFlipped.y};
+    const float angle = stripAngle(rng);
+    const float angleFlipped = -angle;
+    const float deltay_roll = rollOffset(rng);
+
+    Hits<kNGEMVariants> hitVariants;
+    setHit(hitVariants, kRaw, hit.x, hit.y, -deltay_roll, angle);
+    setHit(hitVariants, kFlipped, hitFlipped.x, hitFlipped.y, -deltay_roll, angleFlipped);
+    setHit(hitVariants, kAligned, hitAligned.x, hitAligned.y, -deltay_roll, angleFlipped);
+    Residuals<kNGEMVariants> res;
+    compute(prop, hitVariants, res);
+
+    const Point variants[kNGEMVariants] = {hit, hitFlipped, hitAligned};
+    const float angles[kNGEMVariants] = {angle, angleFlipped, angleFlipped};
+    for (int v = 0; v < kNGEMVariants; ++v){
+      for (int t = 0; t < kNTracks; ++t){
+        check("GE11 dX", c, res.dX[v][t], oldDeltaX(variants[v], pos[t]));
+        check("GE11 dR", c, res.dR[v][t], oldDeltaR(variants[v], pos[t]));
+        check("GE11 RdPhi", c, res.RdPhi[v][t], oldGEMRdPhi(variants[v], pos[t], angles[v], deltay_roll));
+        check("GE11 RdPhi minus", c, res.RdPhiMinus[v][t], oldGEMRdPhiMinus(variants[v], pos[t], angles[v], deltay_roll));
+      }
+    }
+
+    //CSC segment or rechit, strip angle - pi/2 as for the ME1/1 rechits
+    const Point cscHit = {pos[kSta].x + deltaProp(rng), pos[kSta].y + deltaProp(rng)};
+    const float cscAngle = stripAngle(rng) - M_PI/2.;
+    Hits<1> segHit;
+    setHit(segHit, 0, cscHit.x, cscHit.y, cscHit.y, cscAngle);
+    Residuals<1> cscRes;
+    compute(prop, segHit, cscRes);
+    for (int t = 0; t < kNTracks; ++t){
+      check("CSC dR", c, cscRes.dR[0][t], oldDeltaR(cscHit, pos[t]));
+      check("CSC RdPhi", c, cscRes.RdPhi[0][t], oldCSCRdPhi(cscHit, pos[t], cscAngle));
+    }
+  }
+
+  if (nFailed > 0){
+    std::cout <<"testResidualKernel: "<< nFailed <<" mismatches in "<< nConfigs <<" configurations"<< std::endl;
+    return 1;
+  }
+  std::cout <<"testResidualKernel: "<< nConfigs <<" configurations agree within "<< kTolerance <<" cm"<< std::endl;
+  return 0;
+}